@@ -66,4 +66,6 @@ int *__get_errno(void);
 
 #define EPROTO      JINUE_EPROTO
 
+#define ETIMEDOUT   JINUE_ETIMEDOUT
+
 #endif
@@ -50,6 +50,8 @@ void __free_descriptor(int fd);
 
 void *__mmap_anonymous(void *addr, size_t len);
 
+void *__mmap_reserve(size_t len);
+
 int __get_thread_descriptor(pthread_t thread);
 
 int64_t __physmem_alloc(size_t size);
@@ -67,6 +69,8 @@ int64_t __physmem_alloc(size_t size);
 
 #define mmap_anonymous __mmap_anonymous
 
+#define mmap_reserve __mmap_reserve
+
 #define get_thread_descriptor __get_thread_descriptor
 
 #define libc_physmem_alloc __physmem_alloc
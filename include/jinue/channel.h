@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _JINUE_CHANNEL_H
+#define _JINUE_CHANNEL_H
+
+/* Lock-free single-producer/single-consumer ring over the shared memory of a
+ * channel (see JINUE_SYS_CREATE_CHANNEL).
+ *
+ * Entries are exchanged through the shared memory without entering the kernel.
+ * The kernel is only entered when one side has to block, i.e. when the consumer
+ * finds the ring empty or the producer finds it full, and when the peer then
+ * makes progress and sees the waiting flag set by the kernel. */
+
+#include <jinue/jinue.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+typedef struct {
+    jinue_channel_header_t  *header;
+    char                    *data;
+    uint32_t                 entry_size;
+    uint32_t                 entries;
+    int                      fd;
+} jinue_channel_t;
+
+/**
+ * Get the size of the shared memory of a channel
+ *
+ * This is the size of the mapping set up by jinue_map_channel().
+ *
+ * @param entry_size size of a ring entry in bytes
+ * @param entries number of entries in the ring
+ * @return size in bytes
+ */
+static inline size_t jinue_channel_size(size_t entry_size, size_t entries) {
+    size_t size = JINUE_CHANNEL_HEADER_SIZE + entry_size * entries;
+    return (size + JINUE_PAGE_SIZE - 1) & ~(size_t)(JINUE_PAGE_SIZE - 1);
+}
+
+/**
+ * Initialize a channel handle for a mapped channel
+ *
+ * @param channel channel handle (output)
+ * @param fd descriptor that references the channel
+ * @param addr address at which the channel was mapped with jinue_map_channel()
+ */
+static inline void jinue_channel_attach(jinue_channel_t *channel, int fd, void *addr) {
+    jinue_channel_header_t *header = addr;
+
+    channel->header     = header;
+    channel->data       = (char *)addr + header->data_offset;
+    channel->entry_size = header->entry_size;
+    channel->entries    = header->entries;
+    channel->fd         = fd;
+}
+
+/**
+ * Wake up the peer if the kernel flagged it as waiting
+ *
+ * The caller has just published progress by updating its index. The full
+ * barrier orders that store before the load of the waiting flag, which the
+ * kernel sets before checking the index.
+ *
+ * @param channel channel handle
+ * @param flag waiting flag of the peer
+ * @param side side of the peer, JINUE_CHANNEL_CONSUMER or JINUE_CHANNEL_PRODUCER
+ * @param perrno pointer to where to store the error number
+ * @return zero on success, -1 on error
+ */
+static inline int jinue_channel_ring_doorbell(
+        jinue_channel_t *channel,
+        uint32_t        *flag,
+        int              side,
+        int             *perrno) {
+
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    if(__atomic_load_n(flag, __ATOMIC_RELAXED) == 0) {
+        return 0;
+    }
+
+    return jinue_signal_channel(channel->fd, side, perrno);
+}
+
+/**
+ * Add an entry to the ring without blocking
+ *
+ * Only the producer may call this function.
+ *
+ * @param channel channel handle
+ * @param entry entry to copy, entry_size bytes
+ * @param perrno pointer to where to store the error number
+ * @return 1 if the entry was added, zero if the ring is full, -1 on error
+ */
+static inline int jinue_channel_try_enqueue(jinue_channel_t *channel, const void *entry, int *perrno) {
+    jinue_channel_header_t *header = channel->header;
+
+    uint32_t tail = header->tail;
+    uint32_t head = __atomic_load_n(&header->head, __ATOMIC_ACQUIRE);
+
+    if(tail - head >= channel->entries) {
+        return 0;
+    }
+
+    uint32_t slot = tail & (channel->entries - 1);
+    memcpy(&channel->data[slot * channel->entry_size], entry, channel->entry_size);
+
+    __atomic_store_n(&header->tail, tail + 1, __ATOMIC_RELEASE);
+
+    if(jinue_channel_ring_doorbell(channel, &header->consumer_waiting, JINUE_CHANNEL_CONSUMER, perrno) < 0) {
+        return -1;
+    }
+
+    return 1;
+}
+
+/**
+ * Remove an entry from the ring without blocking
+ *
+ * Only the consumer may call this function.
+ *
+ * @param channel channel handle
+ * @param entry where to copy the entry, entry_size bytes
+ * @param perrno pointer to where to store the error number
+ * @return 1 if an entry was removed, zero if the ring is empty, -1 on error
+ */
+static inline int jinue_channel_try_dequeue(jinue_channel_t *channel, void *entry, int *perrno) {
+    jinue_channel_header_t *header = channel->header;
+
+    uint32_t head = header->head;
+    uint32_t tail = __atomic_load_n(&header->tail, __ATOMIC_ACQUIRE);
+
+    if(tail == head) {
+        return 0;
+    }
+
+    uint32_t slot = head & (channel->entries - 1);
+    memcpy(entry, &channel->data[slot * channel->entry_size], channel->entry_size);
+
+    __atomic_store_n(&header->head, head + 1, __ATOMIC_RELEASE);
+
+    if(jinue_channel_ring_doorbell(channel, &header->producer_waiting, JINUE_CHANNEL_PRODUCER, perrno) < 0) {
+        return -1;
+    }
+
+    return 1;
+}
+
+/**
+ * Add an entry to the ring, blocking while the ring is full
+ *
+ * Only the producer may call this function.
+ *
+ * @param channel channel handle
+ * @param entry entry to copy, entry_size bytes
+ * @param perrno pointer to where to store the error number
+ * @return zero on success, -1 on error
+ */
+static inline int jinue_channel_enqueue(jinue_channel_t *channel, const void *entry, int *perrno) {
+    while(true) {
+        int ret = jinue_channel_try_enqueue(channel, entry, perrno);
+
+        if(ret != 0) {
+            return (ret < 0) ? -1 : 0;
+        }
+
+        if(jinue_wait_channel(channel->fd, JINUE_CHANNEL_PRODUCER, perrno) < 0) {
+            return -1;
+        }
+    }
+}
+
+/**
+ * Remove an entry from the ring, blocking while the ring is empty
+ *
+ * Only the consumer may call this function.
+ *
+ * @param channel channel handle
+ * @param entry where to copy the entry, entry_size bytes
+ * @param perrno pointer to where to store the error number
+ * @return zero on success, -1 on error
+ */
+static inline int jinue_channel_dequeue(jinue_channel_t *channel, void *entry, int *perrno) {
+    while(true) {
+        int ret = jinue_channel_try_dequeue(channel, entry, perrno);
+
+        if(ret != 0) {
+            return (ret < 0) ? -1 : 0;
+        }
+
+        if(jinue_wait_channel(channel->fd, JINUE_CHANNEL_CONSUMER, perrno) < 0) {
+            return -1;
+        }
+    }
+}
+
+#endif
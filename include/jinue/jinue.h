@@ -34,6 +34,7 @@
 
 #include <jinue/shared/asm/descriptors.h>
 #include <jinue/shared/asm/errno.h>
+#include <jinue/shared/asm/ipc.h>
 #include <jinue/shared/asm/logging.h>
 #include <jinue/shared/asm/machine.h>
 #include <jinue/shared/asm/mman.h>
@@ -42,6 +43,7 @@
 #include <jinue/shared/asm/stack.h>
 #include <jinue/shared/asm/syscalls.h>
 #include <jinue/shared/asm/signal.h>
+#include <jinue/shared/asm/thread.h>
 #include <jinue/shared/types.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -104,12 +106,88 @@ intptr_t jinue_send(
         int                     *perrno,
         uintptr_t               *perrcode);
 
+intptr_t jinue_send_timeout(
+        int                      fd,
+        intptr_t                 function,
+        const jinue_message_t   *message,
+        uint32_t                 timeout_ms,
+        int                     *perrno,
+        uintptr_t               *perrcode);
+
+int jinue_send_async(
+        int                      fd,
+        intptr_t                 function,
+        const jinue_message_t   *message,
+        int                      cq_fd,
+        int                     *perrno);
+
+int jinue_send_batch(jinue_send_entry_t *entries, size_t length, int *perrno);
+
 intptr_t jinue_receive(int fd, const jinue_message_t *message, int *perrno);
 
+intptr_t jinue_receive_timeout(
+        int                      fd,
+        const jinue_message_t   *message,
+        uint32_t                 timeout_ms,
+        int                     *perrno);
+
+int jinue_receive_batch(int fd, jinue_recv_entry_t *entries, size_t length, int *perrno);
+
 intptr_t jinue_reply(const jinue_message_t *message, int *perrno);
 
+intptr_t jinue_reply_descs(const jinue_message_t *message, int *perrno);
+
+intptr_t jinue_reply_receive(int fd, jinue_message_t *message, int *perrno);
+
+intptr_t jinue_reply_receive_timeout(
+        int                  fd,
+        jinue_message_t     *message,
+        uint32_t             timeout_ms,
+        int                 *perrno);
+
+intptr_t jinue_send_short(
+        int                      fd,
+        intptr_t                 function,
+        jinue_short_message_t   *message,
+        int                     *perrno,
+        uintptr_t               *perrcode);
+
+int jinue_receive_short(int fd, jinue_short_message_t *message, int *perrno);
+
+int jinue_reply_short(const jinue_short_message_t *message, int *perrno);
+
 int jinue_create_endpoint(int fd, int *perrno);
 
+int jinue_create_endpoint_flags(int fd, int flags, int *perrno);
+
+int jinue_create_endpoint_set(int fd, int *perrno);
+
+int jinue_add_to_endpoint_set(int set_fd, int endpoint_fd, int *perrno);
+
+int jinue_create_notification(int fd, int *perrno);
+
+int jinue_notify(int fd, uintptr_t bits, int *perrno);
+
+int jinue_wait_notification(int fd, uintptr_t *bits, int *perrno);
+
+int jinue_bind_notification(int fd, int target_fd, int *perrno);
+
+int jinue_create_channel(int fd, size_t entry_size, size_t entries, int *perrno);
+
+int jinue_map_channel(int process, int fd, void *addr, int *perrno);
+
+int jinue_wait_channel(int fd, int side, int *perrno);
+
+int jinue_signal_channel(int fd, int side, int *perrno);
+
+int jinue_create_completion_queue(int fd, int *perrno);
+
+int jinue_wait_completions(
+        int                  fd,
+        jinue_completion_t  *completions,
+        size_t               length,
+        int                 *perrno);
+
 int jinue_create_process(int fd, int *perrno);
 
 int jinue_dup(int process, int src, int dest, int *perrno);
@@ -151,4 +229,11 @@ int jinue_get_set_signal_mask(
 
 int jinue_set_signal_handler(jinue_sighandler_t handler, int *perrno);
 
+int jinue_set_thread_priority(int fd, int priority, int *perrno);
+
+int jinue_get_set_thread_affinity(int fd, uint32_t affinity, int *perrno);
+
+int jinue_get_cpu(void);
+int jinue_get_kmalloc_stats(const jinue_buffer_t *buffer, int *perrno);
+
 #endif
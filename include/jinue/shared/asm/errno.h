@@ -74,4 +74,7 @@
 /** protocol error */
 #define JINUE_EPROTO    14
 
+/** connection timed out */
+#define JINUE_ETIMEDOUT 15
+
 #endif
@@ -41,4 +41,60 @@
 /** maximum number of buffers in a buffer array */
 #define JINUE_MAX_BUFFERS_IN_ARRAY  256
 
+/** number of data words in a short message */
+#define JINUE_SHORT_MESSAGE_WORDS   2
+
+/** size of the data of a short message, in bytes */
+#define JINUE_SHORT_MESSAGE_SIZE    (JINUE_SHORT_MESSAGE_WORDS * 4)
+
+/** descriptor flag that selects short message (register-only) IPC */
+#define JINUE_IPC_SHORT             0x80000000
+
+/** descriptor flag that selects bulk mode, in which whole pages are lent */
+#define JINUE_IPC_BULK              0x40000000
+
+/** maximum size of the pages lent with a message in bulk mode */
+#define JINUE_MAX_BULK_SIZE         (64 * 1024 * 1024)
+
+/** descriptor flag that selects the transfer of descriptors with a message */
+#define JINUE_IPC_DESCS             0x20000000
+
+/** maximum number of descriptors transferred with a message */
+#define JINUE_MAX_DESCS_IN_MESSAGE  4
+
+/** descriptor flag that makes send or receive fail instead of waiting for a peer */
+#define JINUE_IPC_NONBLOCK          0x10000000
+
+/** descriptor flag that makes send return immediately, the reply being posted
+ * to a completion queue */
+#define JINUE_IPC_ASYNC             0x08000000
+
+/** maximum number of asynchronous requests outstanding on a completion queue */
+#define JINUE_MAX_ASYNC_REQUESTS    32
+
+/** maximum number of receive buffers for the reply to an asynchronous request */
+#define JINUE_MAX_ASYNC_RECV_BUFFERS 4
+
+/** maximum number of messages sent or received in a single batch */
+#define JINUE_MAX_BATCH_SIZE        32
+
+/** endpoint creation flag that gives the next message to the receiver that
+ * started waiting last instead of first */
+#define JINUE_ENDPOINT_LIFO         (1<<0)
+
+/** function number of a notification received through an IPC endpoint */
+#define JINUE_MSG_NOTIFICATION      0
+
+/** maximum size of the shared memory of a channel, header included */
+#define JINUE_CHANNEL_MAX_SIZE      (128 * 1024)
+
+/** size of the header at the start of the shared memory of a channel */
+#define JINUE_CHANNEL_HEADER_SIZE   192
+
+/** consumer side of a channel, which waits for entries */
+#define JINUE_CHANNEL_CONSUMER      0
+
+/** producer side of a channel, which waits for free space */
+#define JINUE_CHANNEL_PRODUCER      1
+
 #endif
@@ -56,4 +56,7 @@
 /** send a signal to the process or thread */
 #define JINUE_PERM_SIGNAL           (1<<7)
 
+/** change the scheduling parameters of a thread */
+#define JINUE_PERM_SCHEDULE         (1<<8)
+
 #endif
@@ -104,6 +104,63 @@
 /** set the current process' signal handling function */
 #define JINUE_SYS_SET_SIGNAL_HANDLER    27
 
+/** reply to current message and receive the next one */
+#define JINUE_SYS_REPLY_RECEIVE         28
+
+/** create an IPC endpoint set */
+#define JINUE_SYS_CREATE_ENDPOINT_SET   29
+
+/** add an IPC endpoint to an endpoint set */
+#define JINUE_SYS_ADD_TO_ENDPOINT_SET   30
+
+/** create a notification */
+#define JINUE_SYS_CREATE_NOTIFICATION   31
+
+/** signal a notification */
+#define JINUE_SYS_NOTIFY                32
+
+/** wait for a notification */
+#define JINUE_SYS_WAIT_NOTIFICATION     33
+
+/** bind a notification to an IPC endpoint or endpoint set */
+#define JINUE_SYS_BIND_NOTIFICATION     34
+
+/** create a shared memory ring channel */
+#define JINUE_SYS_CREATE_CHANNEL        35
+
+/** map a channel into a process' address space */
+#define JINUE_SYS_MAP_CHANNEL           36
+
+/** wait for the peer of a channel */
+#define JINUE_SYS_WAIT_CHANNEL          37
+
+/** wake up the peer of a channel */
+#define JINUE_SYS_SIGNAL_CHANNEL        38
+
+/** set the priority of a thread */
+#define JINUE_SYS_SET_THREAD_PRIORITY   39
+
+/** create a completion queue for asynchronous IPC requests */
+#define JINUE_SYS_CREATE_COMPLETION_QUEUE 40
+
+/** wait for and collect completed asynchronous IPC requests */
+#define JINUE_SYS_WAIT_COMPLETIONS      41
+
+/** send a batch of messages */
+#define JINUE_SYS_SEND_BATCH            42
+
+/** receive a batch of messages */
+#define JINUE_SYS_RECEIVE_BATCH         43
+
+/** get and/or set the CPUs on which a thread may run */
+#define JINUE_SYS_GET_SET_THREAD_AFFINITY 44
+
+/** get the CPU on which the current thread runs */
+#define JINUE_SYS_GET_CPU               45
+
+/** get kernel memory allocator statistics */
+#define JINUE_SYS_GET_KMALLOC_STATS     46
+
 /** start of function numbers for user space messages */
 #define JINUE_SYS_USER_BASE             4096
 
@@ -36,6 +36,7 @@
 #include <jinue/shared/i686/types.h>
 #endif
 
+#include <jinue/shared/asm/ipc.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -75,6 +76,12 @@ typedef struct {
     size_t       size;
 } jinue_const_buffer_t;
 
+/** Descriptor sent with a message (see JINUE_IPC_DESCS) */
+typedef struct {
+    int          fd;
+    int          perms;
+} jinue_send_desc_t;
+
 typedef struct {
     const jinue_const_buffer_t  *send_buffers;
     size_t                       send_buffers_length;
@@ -83,8 +90,79 @@ typedef struct {
     uintptr_t                    recv_function;
     uintptr_t                    recv_cookie;
     uintptr_t                    reply_max_size;
+    int                          recv_endpoint;
+    jinue_const_buffer_t         send_bulk;
+    jinue_buffer_t               bulk_window;
+    size_t                       recv_bulk_size;
+    const jinue_send_desc_t     *send_descs;
+    size_t                       send_descs_length;
+    const int                   *recv_descs;
+    size_t                       recv_descs_length;
+    size_t                       recv_descs_count;
 } jinue_message_t;
 
+/** Short message passed in registers only (see JINUE_IPC_SHORT) */
+typedef struct {
+    uintptr_t   function;
+    uintptr_t   cookie;
+    uintptr_t   data[JINUE_SHORT_MESSAGE_WORDS];
+} jinue_short_message_t;
+
+/** Completion of an asynchronous request (see JINUE_IPC_ASYNC) */
+typedef struct {
+    uintptr_t   request_id;
+    int         result;
+    int         error;
+    uintptr_t   errcode;
+} jinue_completion_t;
+
+/** Message of a batch sent with JINUE_SYS_SEND_BATCH
+ *
+ * The fd, function, message and arg3 members are the arguments of the
+ * equivalent call to JINUE_SYS_SEND. The result, error and errcode members
+ * are set to its outcome. */
+typedef struct {
+    int                  fd;
+    intptr_t             function;
+    jinue_message_t     *message;
+    uintptr_t            arg3;
+    intptr_t             result;
+    int                  error;
+    uintptr_t            errcode;
+} jinue_send_entry_t;
+
+/** Message of a batch received with JINUE_SYS_RECEIVE_BATCH */
+typedef struct {
+    jinue_buffer_t   buffer;
+    uintptr_t        function;
+    uintptr_t        cookie;
+    size_t           size;
+    int              recv_endpoint;
+} jinue_recv_entry_t;
+
+/** Header at the start of the shared memory of a channel
+ *
+ * The ring entries start at data_offset. The head and tail indexes are
+ * free-running: the ring holds tail - head entries and the slot of an index is
+ * the index modulo the number of entries. The members written by the producer
+ * and by the consumer are kept on separate cache lines.
+ *
+ * The waiting flags are set by the kernel when a side blocks waiting for its
+ * peer and cleared when the peer signals it.
+ */
+typedef struct {
+    uint32_t    entry_size;
+    uint32_t    entries;
+    uint32_t    data_offset;
+    uint32_t    reserved0[13];
+    uint32_t    tail;
+    uint32_t    producer_waiting;
+    uint32_t    reserved1[14];
+    uint32_t    head;
+    uint32_t    consumer_waiting;
+    uint32_t    reserved2[14];
+} jinue_channel_header_t;
+
 typedef struct {
     uint64_t    addr;
     uint64_t    size;
@@ -96,6 +174,14 @@ typedef struct {
     jinue_addr_map_entry_t  entry[];
 } jinue_addr_map_t;
 
+typedef struct {
+    uint32_t    size;
+    uint32_t    allocated;
+    uint32_t    allocs;
+    uint32_t    failures;
+    uint32_t    bytes;
+} jinue_kmalloc_stats_t;
+
 typedef struct {
     void        *addr;
     size_t       length;
@@ -35,11 +35,23 @@
 #include <jinue/shared/types.h>
 #include <kernel/types.h>
 
+int add_to_endpoint_set(int set_fd, int endpoint_fd);
+
 int await_thread(int fd);
 
+int bind_notification(int fd, int target_fd);
+
 int close(int fd);
 
-int create_endpoint(int fd);
+int create_channel(int fd, uint32_t entry_size, uint32_t entries);
+
+int create_completion_queue(int fd);
+
+int create_endpoint(int fd, int flags);
+
+int create_endpoint_set(int fd);
+
+int create_notification(int fd);
 
 int create_process(int fd);
 
@@ -55,24 +67,53 @@ void *get_thread_local(void);
 
 int get_address_map(const jinue_buffer_t *buffer);
 
+int get_cpu(void);
+int get_kmalloc_stats(const jinue_buffer_t *buffer);
+
+int map_channel(int process_fd, int channel_fd, void *addr);
+
 int mint(int owner, const jinue_mint_args_t *args);
 
 int mmap(int process_fd, const jinue_mmap_args_t *args);
 
+int notify(int fd, uintptr_t bits);
+
 int puts(uint8_t loglevel, uint8_t facility, const char *str, size_t length);
 
 void reboot(void);
 
-int receive(int fd, jinue_message_t *message);
+int receive(int fd, int flags, uint32_t timeout_ms, jinue_message_t *message);
+
+int receive_batch(int fd, int flags, jinue_recv_entry_t *entries, int length);
+
+int receive_short(int fd, int flags, jinue_short_message_t *message);
 
 int reply(const jinue_message_t *message);
 
 int reply_error(uintptr_t errcode);
 
-int send(uintptr_t *errcode, int fd, int function, const jinue_message_t *message);
+int reply_receive(int fd, int flags, uint32_t timeout_ms, jinue_message_t *message);
+
+int reply_short(const uintptr_t *data);
+
+int send(
+        uintptr_t       *errcode,
+        int              fd,
+        int              function,
+        int              flags,
+        uint32_t         timeout_ms,
+        jinue_message_t *message);
+
+int send_async(int fd, int function, int cq_fd, jinue_message_t *message);
+
+int send_short(uintptr_t *errcode, int fd, int function, int flags, uintptr_t *data);
 
 void set_thread_local(void *addr, size_t size);
 
+int set_thread_priority(int fd, int priority);
+
+int signal_channel(int fd, int side);
+
 int signal_process(int fd, int signo);
 
 int signal_thread(int fd, int signo);
@@ -81,8 +122,16 @@ int start_thread(int fd, void (*entry)(void), void *stack_addr, sigmask_t sigmas
 
 void yield_thread(void);
 
+int wait_channel(int fd, int side);
+
+int wait_completions(int fd, int flags, jinue_completion_t *completions, int length);
+
+int wait_notification(int fd, uintptr_t *bits);
+
 int get_set_signal_mask(int how, const jinue_sigset_t *set, jinue_sigset_t *oset);
 
+int get_set_thread_affinity(int fd, uint32_t affinity);
+
 void set_signal_handler(jinue_sighandler_t handler);
 
 #endif
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef JINUE_KERNEL_DOMAIN_KMALLOC_H
+#define JINUE_KERNEL_DOMAIN_KMALLOC_H
+
+#include <kernel/types.h>
+
+/** number of slab-backed size classes */
+#define KMALLOC_NUM_CLASSES     15
+
+/** size of the largest slab-backed size class, larger sizes use whole pages */
+#define KMALLOC_MAX_CLASS_SIZE  1536
+
+/** number of entries reported by kmalloc_get_stats() (size classes + pages) */
+#define KMALLOC_NUM_STATS       (KMALLOC_NUM_CLASSES + 1)
+
+typedef struct {
+    /** object size of the class, zero for multi-page allocations */
+    size_t          size;
+    /** number of allocations currently outstanding */
+    unsigned int    allocated;
+    /** number of successful allocations since boot */
+    unsigned int    allocs;
+    /** number of failed allocations since boot */
+    unsigned int    failures;
+    /** memory currently allocated, in bytes */
+    size_t          bytes;
+} kmalloc_stats_t;
+
+void initialize_kmalloc(void);
+
+void *kmalloc(size_t size);
+
+void kfree(void *ptr);
+
+int kmalloc_get_stats(kmalloc_stats_t *stats, int length);
+
+#endif
@@ -36,6 +36,13 @@
 
 #define PFNULL ((paddr_t)-1)
 
+/** order of the largest block the page allocator manages (4MB) */
+#define PAGE_ALLOC_MAX_ORDER    10
+
+void *page_alloc_order(int order);
+
+void page_free_order(void *first_page, int order);
+
 void *page_alloc(void);
 
 void page_free(void *page);
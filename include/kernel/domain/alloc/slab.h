@@ -36,6 +36,7 @@
 #include <kernel/machine/spinlock.h>
 #include <kernel/utils/pmap.h>
 #include <kernel/types.h>
+#include <stdbool.h>
 
 #define SLAB_SIZE                   PAGE_SIZE
 
@@ -47,6 +48,9 @@
 
 #define SLAB_DEFAULT_WORKING_SET    2
 
+/** number of objects (rounds) a magazine can hold */
+#define SLAB_MAGAZINE_SIZE          14
+
 
 #define SLAB_DEFAULTS               (0)
 
@@ -58,9 +62,24 @@
 
 #define SLAB_COMPACT                (1<<3)
 
+#define SLAB_NO_MAGAZINES           (1<<4)
+
 
 struct slab_t;
 
+struct slab_magazine_t {
+    struct slab_magazine_t  *next;
+    unsigned int             rounds;
+    void                    *objects[SLAB_MAGAZINE_SIZE];
+};
+
+typedef struct slab_magazine_t slab_magazine_t;
+
+typedef struct {
+    slab_magazine_t     *loaded;
+    slab_magazine_t     *previous;
+} slab_cpu_cache_t;
+
 struct slab_cache_t {
     struct slab_t       *slabs_empty;
     struct slab_t       *slabs_partial;
@@ -77,7 +96,12 @@ struct slab_cache_t {
     slab_ctor_t          dtor;
     char                *name;
     int                  flags;
+    bool                 use_magazines;
     spinlock_t           lock;
+    slab_magazine_t     *depot_full;
+    slab_magazine_t     *depot_empty;
+    spinlock_t           depot_lock;
+    slab_cpu_cache_t     cpu_caches[MAX_CPUS];
 };
 
 struct slab_bufctl_t {
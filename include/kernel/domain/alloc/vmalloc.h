@@ -34,10 +34,20 @@
 
 #include <kernel/types.h>
 
+void initialize_vmalloc(void);
+
 addr_t vmalloc(void);
 
+addr_t vmalloc_n(int num_pages);
+
+addr_t vmalloc_large(size_t size);
+
 void vmfree(addr_t page);
 
+void vmfree_n(addr_t addr, int num_pages);
+
+void vmfree_large(addr_t addr, size_t size);
+
 bool vmalloc_is_in_range(addr_t page);
 
 #endif
@@ -104,6 +104,16 @@ int descriptor_close(process_t *process, int fd);
 
 ipc_endpoint_t *descriptor_get_endpoint(descriptor_t *desc);
 
+ipc_endpoint_set_t *descriptor_get_endpoint_set(descriptor_t *desc);
+
+channel_t *descriptor_get_channel(descriptor_t *desc);
+
+completion_queue_t *descriptor_get_completion_queue(descriptor_t *desc);
+
+notification_t *descriptor_get_notification(descriptor_t *desc);
+
+int descriptor_get_receive_queue(ipc_queue_t **pqueue, descriptor_t *desc);
+
 process_t *descriptor_get_process(descriptor_t *desc);
 
 thread_t *descriptor_get_thread(descriptor_t *desc);
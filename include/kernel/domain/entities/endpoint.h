@@ -32,6 +32,7 @@
 #ifndef JINUE_KERNEL_ENTITIES_ENDPOINT_H
 #define JINUE_KERNEL_ENTITIES_ENDPOINT_H
 
+#include <kernel/domain/entities/object.h>
 #include <kernel/types.h>
 
 extern const object_type_t *object_type_ipc_endpoint;
@@ -40,8 +41,22 @@ static inline object_header_t *endpoint_object(ipc_endpoint_t *endpoint) {
     return &endpoint->header;
 }
 
+/**
+ * Check whether an IPC endpoint is a member of an endpoint set
+ *
+ * An endpoint stops being a member of its endpoint set when the set is
+ * destroyed.
+ *
+ * @param endpoint the endpoint
+ * @return true if the endpoint is a member of a set, false otherwise
+ */
+static inline bool endpoint_is_in_set(ipc_endpoint_t *endpoint) {
+    ipc_endpoint_set_t *set = endpoint->set;
+    return set != NULL && !object_is_destroyed(&set->header);
+}
+
 void initialize_endpoint_cache(void);
 
-ipc_endpoint_t *endpoint_new(void);
+ipc_endpoint_t *endpoint_new(int flags);
 
 #endif
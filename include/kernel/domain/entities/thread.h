@@ -54,4 +54,8 @@ int thread_await(thread_t *thread);
 
 void thread_set_local_storage(thread_t *thread, addr_t addr, size_t size);
 
+void thread_set_priority(thread_t *thread, int priority);
+
+int thread_get_priority(const thread_t *thread);
+
 #endif
@@ -32,6 +32,7 @@
 #ifndef JINUE_KERNEL_SERVICES_ASM_SCHEDULER_H
 #define JINUE_KERNEL_SERVICES_ASM_SCHEDULER_H
 
-#define SCHEDULER_BASE_CREDITS 3
+/** number of timer ticks between load balancing passes on each CPU */
+#define SCHEDULER_BALANCE_TICKS 10
 
 #endif
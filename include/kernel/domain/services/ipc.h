@@ -34,20 +34,92 @@
 
 #include <kernel/types.h>
 
+void initialize_ipc(void);
+
 int send_message(
         uintptr_t               *errcode,
         ipc_endpoint_t          *endpoint,
         thread_t                *sender,
         int                      function,
         uintptr_t                cookie,
+        int                      flags,
+        uint32_t                 timeout,
+        jinue_message_t         *message);
+
+int send_async_message(
+        ipc_endpoint_t          *endpoint,
+        completion_queue_t      *queue,
+        thread_t                *sender,
+        int                      function,
+        uintptr_t                cookie,
         const jinue_message_t   *message);
 
-int receive_message(ipc_endpoint_t *endpoint, thread_t *receiver,jinue_message_t *message);
+int collect_completions(
+        completion_queue_t  *queue,
+        thread_t            *thread,
+        int                  flags,
+        jinue_completion_t  *completions,
+        int                  length);
+
+int send_short_message(
+        uintptr_t               *errcode,
+        ipc_endpoint_t          *endpoint,
+        thread_t                *sender,
+        int                      function,
+        uintptr_t                cookie,
+        int                      flags,
+        uintptr_t               *data);
+
+int receive_message(
+        ipc_queue_t         *queue,
+        thread_t            *receiver,
+        int                  flags,
+        uint32_t             timeout,
+        jinue_message_t     *message);
+
+int receive_short_message(
+        ipc_queue_t             *queue,
+        thread_t                *receiver,
+        int                      flags,
+        jinue_short_message_t   *short_message);
+
+ipc_endpoint_t *get_message_endpoint(const thread_t *receiver);
 
 int reply_to_message(thread_t *replier, const jinue_message_t *message);
 
+int reply_short_message(thread_t *replier, const uintptr_t *data);
+
+int reply_and_receive_message(
+        ipc_queue_t         *queue,
+        thread_t            *receiver,
+        int                  flags,
+        uint32_t             timeout,
+        jinue_message_t     *message);
+
 int reply_error_to_message(thread_t *replier, uintptr_t errcode);
 
+void acknowledge_request(thread_t *receiver);
+
+void send_notification(notification_t *notification, uintptr_t bits);
+
+int wait_for_notification(notification_t *notification, thread_t *thread, uintptr_t *bits);
+
+int bind_notification_to_queue(notification_t *notification, ipc_queue_t *queue);
+
+void unbind_notification(ipc_queue_t *queue);
+
+void enqueue_sender(ipc_queue_t *queue, thread_t *sender);
+
+void return_lent_pages(thread_t *receiver);
+
 void abort_message(thread_t *thread);
 
+void abort_current_message(thread_t *receiver);
+
+void prepare_message_wait(thread_t *thread);
+
+void abort_request(ipc_request_t *request);
+
+void discard_request(ipc_request_t *request);
+
 #endif
@@ -37,6 +37,10 @@
 
 void *map_in_kernel(paddr_t paddr, size_t size, int prot, int flags);
 
+addr_t reserve_in_kernel(size_t size);
+
+addr_t reserve_large_pages_in_kernel(size_t *size);
+
 void resize_map_in_kernel(size_t size);
 
 void undo_map_in_kernel(void);
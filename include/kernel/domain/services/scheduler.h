@@ -35,21 +35,28 @@
 #include <kernel/domain/services/asm/scheduler.h>
 #include <kernel/types.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 void reschedule(void);
 
-void scheduler_tick(void);
+void scheduler_tick(uint64_t now);
 
 void ready_thread(thread_t *thread);
 
+void set_thread_affinity(thread_t *thread, uint32_t affinity);
+
 void yield_current_thread(void);
 
 void switch_to_thread(thread_t *to);
 
 void switch_to_thread_and_block(thread_t *to);
 
+void switch_to_thread_block_and_unlock(thread_t *to, spinlock_t *lock);
+
 void block_current_thread_and_unlock(spinlock_t *lock);
 
 void switch_from_exiting_thread(void);
 
+void scheduler_start_cpus(void);
+
 #endif
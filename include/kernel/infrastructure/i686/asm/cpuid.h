@@ -73,6 +73,8 @@
 
 #define CPUID_FEATURE_ECX_SSE3          (1<<0)
 
+#define CPUID_FEATURE_ECX_MONITOR       (1<<3)
+
 #define CPUID_FEATURE_ECX_SSSE3         (1<<9)
 
 #define CPUID_FEATURE_ECX_SSSE4_1       (1<<19)
@@ -95,6 +97,8 @@
 
 #define CPUID_FEATURE_PSE               (1<<3)
 
+#define CPUID_FEATURE_TSC               (1<<4)
+
 #define CPUID_FEATURE_PAE               (1<<6)
 
 #define CPUID_FEATURE_APIC              (1<<9)
@@ -152,4 +156,8 @@
 
 #define CPUID_EXT_FEATURE_NX            (1<<20)
 
+/* Extended leaf 7 (0x80000007) edx */
+
+#define CPUID_EXT7_INVARIANT_TSC        (1<<8)
+
 #endif
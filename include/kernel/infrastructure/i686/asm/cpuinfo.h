@@ -58,6 +58,14 @@
 
 #define CPU_FEATURE_SYSENTER    (1<<11)
 
+#define CPU_FEATURE_MWAIT       (1<<12)
+
+#define CPU_FEATURE_TSC         (1<<13)
+
+#define CPU_FEATURE_TSC_DEADLINE (1<<14)
+
+#define CPU_FEATURE_INVARIANT_TSC (1<<15)
+
 /* workarounds */
 
 #define CPU_WORKAROUND_CVE2018_3665 (1<<0)
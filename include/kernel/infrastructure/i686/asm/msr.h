@@ -42,6 +42,8 @@
 
 #define MSR_IA32_PAT                0x277
 
+#define MSR_IA32_TSC_DEADLINE       0x6e0
+
 #define MSR_IA32_MTRR_DEF_TYPE      0x2ff
 
 #define MSR_EFER                    0xC0000080
@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef JINUE_KERNEL_INFRASTRUCTURE_I686_ASM_SMP_H
+#define JINUE_KERNEL_INFRASTRUCTURE_I686_ASM_SMP_H
+
+/** physical address where the application processors startup code is copied */
+#define AP_STARTUP_ADDR             0x8000
+
+/** vector sent with the startup IPI (i.e. start address divided by 4096) */
+#define AP_STARTUP_VECTOR           (AP_STARTUP_ADDR >> 12)
+
+/* The AP_PARAMS_OFFSET_... definitions here must match the offsets in the
+ * ap_startup_params_t struct. They are used by the startup trampoline, which
+ * can't use the struct definition. */
+
+#define AP_PARAMS_OFFSET_CR0        0
+
+#define AP_PARAMS_OFFSET_CR3        4
+
+#define AP_PARAMS_OFFSET_CR4        8
+
+#define AP_PARAMS_OFFSET_NX         12
+
+#define AP_PARAMS_OFFSET_STACK      16
+
+#define AP_PARAMS_OFFSET_ENTRY      20
+
+#define AP_PARAMS_OFFSET_ARG        24
+
+#define AP_PARAMS_SIZE              28
+
+#endif
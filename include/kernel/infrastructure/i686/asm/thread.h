@@ -39,6 +39,9 @@
 
 #define THREAD_CONTEXT_MASK     (~(THREAD_CONTEXT_SIZE - 1))
 
+/** offset of the is_on_cpu member in machine_thread_t */
+#define MACHINE_THREAD_OFFSET_IS_ON_CPU 4
+
 
 #define THREAD_FPU_AREA_SIZE        512
 
@@ -66,6 +66,10 @@
 
 #define APIC_REG_LVT_CMCI       0x2f0
 
+#define APIC_REG_ICR_LOW        0x300
+
+#define APIC_REG_ICR_HIGH       0x310
+
 #define APIC_REG_LVT_TIMER      0x320
 
 #define APIC_REG_LVT_THERMAL    0x330
@@ -115,6 +119,25 @@
 #define APIC_LVT_TIMER_TSC_DEADLINE (2 << 17)
 
 
+#define APIC_ICR_DELIVERY_FIXED     0
+
+#define APIC_ICR_DELIVERY_INIT      0x500
+
+#define APIC_ICR_DELIVERY_STARTUP   0x600
+
+#define APIC_ICR_PENDING            (1 << 12)
+
+#define APIC_ICR_LEVEL_DEASSERT     0
+
+#define APIC_ICR_LEVEL_ASSERT       (1 << 14)
+
+#define APIC_ICR_TRIGGER_EDGE       0
+
+#define APIC_ICR_TRIGGER_LEVEL      (1 << 15)
+
+#define APIC_ICR_DEST_SHIFT         24
+
+
 #define APIC_SVR_DISABLED           0
 
 #define APIC_SVR_ENABLED            (1 << 8)
@@ -44,6 +44,20 @@
 
 #define PIT8253_IO_CW_REG       (PIT8253_IO_BASE + 3)
 
+/** system control port B, which controls the gate of counter 2 */
+#define PIT8253_IO_PORT_B       0x61
+
+/* System control port B flags */
+
+/** gate input of counter 2 */
+#define PIT8253_PORT_B_GATE2    (1<<0)
+
+/** connects the output of counter 2 to the PC speaker */
+#define PIT8253_PORT_B_SPEAKER  (1<<1)
+
+/** output of counter 2 (read only) */
+#define PIT8253_PORT_B_OUT2     (1<<5)
+
 /* Individual flag definitions */
 
 /** BCD (1) or binary (0) counter selection */
@@ -33,9 +33,28 @@
 #define JINUE_KERNEL_INFRASTRUCTURE_I686_DRIVERS_LAPIC_H
 
 #include <kernel/infrastructure/i686/drivers/asm/lapic.h>
+#include <stdint.h>
 
 void local_apic_init(void);
 
+void local_apic_init_ap(void);
+
+int local_apic_get_id(void);
+
+void local_apic_init_timer(uint32_t flags);
+
+void local_apic_start_timer(uint32_t count);
+
+uint32_t local_apic_get_timer_count(void);
+
+void local_apic_set_timer_deadline(uint64_t tsc);
+
+void local_apic_send_interrupt(int apic_id, int vector);
+
+void local_apic_send_init(int apic_id);
+
+void local_apic_send_startup(int apic_id, int vector);
+
 void local_apic_eoi(void);
 
 #endif
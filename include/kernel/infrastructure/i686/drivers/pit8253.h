@@ -34,6 +34,13 @@
 
 #include <kernel/infrastructure/i686/drivers/asm/pit8253.h>
 
+#include <stdbool.h>
+#include <stdint.h>
+
 void pit8253_init(void);
 
+void pit8253_start_countdown(uint16_t count);
+
+bool pit8253_countdown_done(void);
+
 #endif
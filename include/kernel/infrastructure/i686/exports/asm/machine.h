@@ -45,4 +45,15 @@
 
 #define MAPPING_AREA_ADDR       (LARGE_PAGES_AREA_ADDR - MAPPING_AREA_SIZE)
 
+/* Virtual address space allocated at run time with vmalloc(). This region
+ * starts above the memory mapped by the setup code for allocations during
+ * boot (see BOOT_SIZE_AT_16MB) and ends where the mapping area starts. */
+#define VMALLOC_AREA_ADDR       0xc1000000
+
+#define VMALLOC_AREA_SIZE       (MAPPING_AREA_ADDR - VMALLOC_AREA_ADDR)
+
+/* Maximum number of CPUs. The per-CPU data of all application processors fits
+ * in a single page. */
+#define MAX_CPUS                16
+
 #endif
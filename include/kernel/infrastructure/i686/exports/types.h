@@ -63,8 +63,10 @@ typedef struct pdpt_t pdpt_t;
 
 typedef struct {
     /* The assembly language thread switching code makes the assumption that
-     * saved_stack_pointer is the first member of this structure. */
+     * saved_stack_pointer is the first member of this structure and is_on_cpu
+     * the second. */
     addr_t  saved_stack_pointer;
+    int     is_on_cpu;
     int     flags;
 } machine_thread_t;
 
@@ -47,4 +47,6 @@ bool acpi_is_vga_present(void);
 
 paddr_t acpi_get_local_apic_address(void);
 
+int acpi_get_cpu_apic_ids(int *apic_ids, int max);
+
 #endif
@@ -75,6 +75,12 @@
 
 #define MP_BUS_TYPE_PCI             "PCI"
 
+/* Multiprocessor Specification 1.4 section 4.3.1 Processor Entries */
+
+#define MP_CPU_FLAG_EN              (1 << 0)
+
+#define MP_CPU_FLAG_BP              (1 << 1)
+
 /* Multiprocessor Specification 1.4 section 4.3.3 I/O APIC Entries */
 
 #define MP_IO_API_FLAG_EN           (1 << 0)
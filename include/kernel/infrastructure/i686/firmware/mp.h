@@ -120,4 +120,6 @@ void init_mp(void);
 
 paddr_t mp_get_local_apic_addr(void);
 
+int mp_get_cpu_apic_ids(int *apic_ids, int max);
+
 #endif
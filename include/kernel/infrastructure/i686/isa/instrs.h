@@ -40,6 +40,14 @@ void sti(void);
 
 void hlt(void);
 
+void sti_hlt(void);
+
+void pause(void);
+
+void monitor(const volatile void *addr);
+
+void sti_mwait(void);
+
 void invlpg(void *vaddr);
 
 void lgdt(pseudo_descriptor_t *gdt_info);
@@ -50,6 +58,8 @@ void ltr(seg_selector_t sel);
 
 uint64_t rdmsr(uint32_t addr);
 
+uint64_t rdtsc(void);
+
 void wrmsr(uint32_t addr, uint64_t val);
 
 void sfence(void);
@@ -34,8 +34,11 @@
 
 #include <jinue/shared/asm/memtype.h>
 #include <kernel/interface/i686/types.h>
+#include <stdbool.h>
 #include <stdint.h>
 
+bool is_available_memory(const bootinfo_t *bootinfo, uint64_t addr, uint64_t size);
+
 void check_system_address_map(const bootinfo_t *bootinfo);
 
 void initialize_address_map(const bootinfo_t *bootinfo);
@@ -41,6 +41,8 @@ bool platform_is_vga_present(void);
 
 paddr_t platform_get_local_apic_address(void);
 
+int platform_get_cpu_apic_ids(int *apic_ids, int max);
+
 int platform_get_video_type(void);
 
 #endif
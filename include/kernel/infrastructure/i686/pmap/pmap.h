@@ -70,4 +70,12 @@ void pmap_destroy_addr_space(addr_space_t *addr_space);
 
 void pmap_switch_addr_space(addr_space_t *addr_space);
 
+void pmap_switch_to_initial_addr_space(void);
+
+void pmap_init_ap(void);
+
+bool pmap_map_identity(addr_space_t *addr_space, paddr_t paddr, size_t size);
+
+void pmap_invalidate_local(const addr_space_t *addr_space, addr_t addr, size_t size);
+
 #endif
@@ -80,4 +80,23 @@ static inline bool pte_is_present(const pte_t *pte) {
     return !!( *(const uint32_t *)pte & (X86_PTE_PRESENT | X86_PTE_PROT_NONE));
 }
 
+/**
+ * Whether the specified page table entry maps a page accessible from user space
+ *
+ * @param pte page table entry
+ * @param writable whether write access is required
+ * @return true if page is accessible from user space, false otherwise
+ */
+static inline bool pte_is_user_accessible(const pte_t *pte, bool writable) {
+    /* Same micro-optimization as pte_is_present() above: all the flags we are
+     * interested in are in the lower four bytes of the entry. */
+    uint32_t required = X86_PTE_PRESENT | X86_PTE_USER;
+
+    if(writable) {
+        required |= X86_PTE_READ_WRITE;
+    }
+
+    return ( *(const uint32_t *)pte & required) == required;
+}
+
 #endif
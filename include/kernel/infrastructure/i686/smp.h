@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef JINUE_KERNEL_INFRASTRUCTURE_I686_SMP_H
+#define JINUE_KERNEL_INFRASTRUCTURE_I686_SMP_H
+
+#include <kernel/infrastructure/i686/asm/smp.h>
+#include <kernel/infrastructure/i686/types.h>
+#include <stdint.h>
+
+/** parameters block of the application processors startup trampoline */
+typedef struct {
+    uint32_t    cr0;
+    uint32_t    cr3;
+    uint32_t    cr4;
+    uint32_t    nx;
+    uint32_t    stack;
+    uint32_t    entry;
+    uint32_t    arg;
+} ap_startup_params_t;
+
+extern const char ap_trampoline_start[];
+
+extern const char ap_trampoline_params[];
+
+extern const char ap_trampoline_end[];
+
+extern int tlb_shootdown_remaining;
+
+void init_smp(void);
+
+void init_application_processor(percpu_t *cpu_data);
+
+void tlb_shootdown(const addr_space_t *addr_space, addr_t addr, size_t size);
+
+void service_tlb_shootdown(void);
+
+#endif
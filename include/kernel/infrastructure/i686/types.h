@@ -116,6 +116,7 @@ struct percpu_t {
     /* should be aligned on an 8-byte boundary for performance. */
     seg_descriptor_t     gdt[GDT_NUM_ENTRIES];
     tss_t                tss;
+    int                  cpu;
 };
 
 typedef struct percpu_t percpu_t;
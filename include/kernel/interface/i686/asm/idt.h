@@ -38,6 +38,12 @@
 
 #define IDT_PIC8259_BASE     	(IDT_LAST_EXCEPTION + 1)
 
+/** inter-processor interrupt sent to invalidate TLB entries on another CPU */
+#define IDT_APIC_TLB_SHOOTDOWN  0xfc
+
+/** inter-processor interrupt sent to wake up another CPU */
+#define IDT_APIC_WAKEUP         0xfd
+
 #define IDT_APIC_TIMER          0xfe
 
 /**
@@ -36,4 +36,10 @@ int add_atomic(int *value, int increment);
 
 int or_atomic(int *value, int mask);
 
+int swap_atomic(int *value, int new_value);
+
+int compare_and_swap_atomic(int *value, int expected, int new_value);
+
+void *compare_and_swap_ptr_atomic(void **value, void *expected, void *new_value);
+
 #endif
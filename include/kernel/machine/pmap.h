@@ -47,8 +47,16 @@ bool machine_map_userspace(
         int              prot,
         int              flags);
 
+void machine_unmap_userspace(process_t *process, addr_t addr, size_t size);
+
 paddr_t machine_lookup_kernel_paddr(const void *addr);
 
+bool machine_lookup_userspace_paddr(
+        process_t       *process,
+        const void      *addr,
+        int              prot,
+        paddr_t         *paddr);
+
 size_t machine_large_page_size(void);
 
 #endif
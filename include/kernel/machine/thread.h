@@ -38,6 +38,8 @@ thread_t *get_current_thread(void);
 
 void machine_prepare_thread(thread_t *thread, const thread_params_t *params);
 
+void machine_prepare_idle_thread(thread_t *thread, void (*entry)(void));
+
 thread_t *machine_alloc_thread(void);
 
 void machine_free_thread(thread_t *thread);
@@ -48,4 +50,6 @@ void machine_switch_and_unref_thread(thread_t *from, thread_t *to);
 
 void machine_switch_thread_and_unlock(thread_t *from, thread_t *to, spinlock_t *lock);
 
+void machine_wait_thread_off_cpu(const thread_t *thread);
+
 #endif
@@ -35,6 +35,7 @@
 #include <jinue/shared/asm/ipc.h>
 #include <jinue/shared/asm/descriptors.h>
 #include <jinue/shared/types.h>
+#include <kernel/machine/asm/machine.h>
 #include <kernel/machine/types.h>
 #include <kernel/utils/list.h>
 #include <kernel/typedeps.h>
@@ -88,6 +89,19 @@ typedef struct {
     descriptor_t        descriptors[JINUE_DESC_NUM];
 } process_t;
 
+typedef struct timer_t timer_t;
+
+typedef void (*timer_func_t)(timer_t *);
+
+/** Kernel timer, see kernel/domain/services/timer.c */
+struct timer_t {
+    struct timer_t      *next;
+    struct timer_t     **pprev;
+    uint64_t             expires;
+    timer_func_t         func;
+    bool                 is_running;
+};
+
 typedef enum {
     THREAD_STATE_CREATED,
     THREAD_STATE_STARTING,
@@ -102,7 +116,9 @@ struct thread_t {
     machine_thread_t     machine_thread;
     list_node_t          thread_list;
     thread_state_t       state;
-    int                  cpu_credits;
+    int                  priority;
+    int                  cpu;
+    uint32_t             affinity;
     process_t           *process;
     struct thread_t     *sender;
     struct thread_t     *awaiter;
@@ -113,11 +129,28 @@ struct thread_t {
     addr_t               local_storage_addr;
     size_t               local_storage_size;
     size_t               recv_buffer_size;
+    const jinue_message_t *message;
+    struct ipc_endpoint_t *message_endpoint;
+    struct ipc_queue_t  *recv_queue;
+    bool                 recv_requests_only;
+    struct thread_t     *servicer;
+    struct ipc_request_t *request;
+    timer_t              timeout_timer;
+    uintptr_t            notification_bits;
     int                  message_errno;
+    int                  message_state;
+    int                  sender_state;
     uintptr_t            message_reply_errcode;
     uintptr_t            message_function;
     uintptr_t            message_cookie;
     size_t               message_size;
+    addr_t               lent_addr;
+    size_t               lent_size;
+    int                  send_descs_count;
+    int                  recv_descs_length;
+    int                  recv_descs_count;
+    descriptor_t         send_descs[JINUE_MAX_DESCS_IN_MESSAGE];
+    int                  recv_descs[JINUE_MAX_DESCS_IN_MESSAGE];
     char                 message_buffer[JINUE_MAX_MESSAGE_SIZE];
 };
 
@@ -129,13 +162,87 @@ typedef struct {
     sigmask_t    sigmask;
 } thread_params_t;
 
+/** Queues of threads waiting to exchange messages */
+struct ipc_queue_t {
+    spinlock_t               lock;
+    list_t                   send_list;
+    list_t                   recv_list;
+    list_t                   async_list;
+    struct notification_t   *notification;
+    bool                     is_lifo;
+};
+
+typedef struct ipc_queue_t ipc_queue_t;
+
+struct notification_t {
+    object_header_t  header;
+    spinlock_t       lock;
+    uintptr_t        bits;
+    list_t           wait_list;
+    ipc_queue_t     *bound_queue;
+    int              receivers_count;
+};
+
+typedef struct notification_t notification_t;
+
 typedef struct {
     object_header_t header;
-    spinlock_t      lock;
-    list_t          send_list;
-    list_t          recv_list;
+    ipc_queue_t     queue;
     int             receivers_count;
-} ipc_endpoint_t;
+} ipc_endpoint_set_t;
+
+struct ipc_endpoint_t {
+    object_header_t      header;
+    ipc_queue_t          queue;
+    int                  receivers_count;
+    ipc_endpoint_set_t  *set;
+    int                  set_member_fd;
+};
+
+typedef struct ipc_endpoint_t ipc_endpoint_t;
+
+typedef struct {
+    object_header_t  header;
+    spinlock_t       lock;
+    list_t           completed;
+    list_t           wait_list;
+    int              outstanding;
+    uintptr_t        next_id;
+    process_t       *process;
+    int              receivers_count;
+} completion_queue_t;
+
+/** Asynchronous request, see send_async_message() */
+struct ipc_request_t {
+    list_node_t          request_list;
+    completion_queue_t  *completion_queue;
+    ipc_endpoint_t      *endpoint;
+    uintptr_t            id;
+    uintptr_t            function;
+    uintptr_t            cookie;
+    int                  priority;
+    size_t               recv_buffer_size;
+    int                  recv_buffers_length;
+    jinue_buffer_t       recv_buffers[JINUE_MAX_ASYNC_RECV_BUFFERS];
+    int                  error;
+    uintptr_t            errcode;
+    size_t               size;
+    char                 buffer[JINUE_MAX_MESSAGE_SIZE];
+};
+
+typedef struct ipc_request_t ipc_request_t;
+
+typedef struct {
+    object_header_t          header;
+    spinlock_t               lock;
+    jinue_channel_header_t  *ring;
+    size_t                   size;
+    uint32_t                 entries;
+    int                      users_count;
+    list_t                   wait_lists[2];
+    list_t                   mappings;
+    void                   **pages;
+} channel_t;
 
 typedef struct {
     void    *start;
@@ -77,6 +77,10 @@ static inline void *list_node_entry_by_offset(list_node_t *node, size_t offset)
 #define list_node_entry(node, type, member) \
     ( (type *)list_node_entry_by_offset(node, OFFSET_OF(type, member)) )
 
+static inline bool list_is_empty(const list_t *list) {
+    return list->head == NULL;
+}
+
 static inline void list_enqueue(list_t *list, list_node_t *node) {
     /* no next node at the tail */
     node->next = NULL;
@@ -95,6 +99,18 @@ static inline void list_enqueue(list_t *list, list_node_t *node) {
     list->tail = node;
 }
 
+static inline void list_push(list_t *list, list_node_t *node) {
+    /* if adding to an empty list... */
+    if(list->head == NULL) {
+        /* ... the tail is the same as the head */
+        list->tail = node;
+    }
+
+    /* add node at the head */
+    node->next = list->head;
+    list->head = node;
+}
+
 static inline list_node_t *list_dequeue_node(list_t *list) {
     list_node_t *node = list->head;
     
@@ -126,6 +142,46 @@ static inline list_cursor_t list_head(list_t *list) {
     return &(list->head);
 }
 
+static inline list_node_t *list_remove_node(list_t *list, list_cursor_t cur) {
+    list_node_t *node = *cur;
+
+    if(node == NULL) {
+        return NULL;
+    }
+
+    *cur = node->next;
+
+    /* if removing the last node from the list ... */
+    if(list->tail == node) {
+        /* ... the previous node becomes the tail. The cursor points to the
+         * next pointer of that node, which is its first member, unless it
+         * points to the head. */
+        if(cur == &list->head) {
+            list->tail = NULL;
+        }
+        else {
+            list->tail = (list_node_t *)cur;
+        }
+    }
+
+    return node;
+}
+
+#define list_remove(list, cur, type, member) \
+    list_node_entry(list_remove_node(list, cur), type, member)
+
+static inline void list_insert(list_t *list, list_cursor_t cur, list_node_t *node) {
+    /* insert before the node the cursor points to */
+    node->next  = *cur;
+    *cur        = node;
+
+    /* if inserting at the end of the list ... */
+    if(node->next == NULL) {
+        /* ... the new node is the new tail */
+        list->tail = node;
+    }
+}
+
 static inline list_cursor_t list_cursor_next(list_cursor_t cur) {
     if(cur == NULL) {
         return NULL;
@@ -45,4 +45,30 @@
 
 #define ARRAY_COUNT(ar)         (sizeof(ar) / sizeof(ar[0]))
 
+/**
+ * Get the index of the least significant bit set
+ *
+ * This compiles to a single bit scan instruction (BSF) on x86.
+ *
+ * @param value value, must not be zero
+ * @return bit index
+ *
+ */
+static inline int bit_scan_forward(uint32_t value) {
+    return __builtin_ctz(value);
+}
+
+/**
+ * Get the index of the most significant bit set
+ *
+ * This compiles to a single bit scan instruction (BSR) on x86.
+ *
+ * @param value value, must not be zero
+ * @return bit index
+ *
+ */
+static inline int bit_scan_reverse(uint32_t value) {
+    return 31 - __builtin_clz(value);
+}
+
 #endif
@@ -33,6 +33,7 @@
 #define _JINUE_LIBC_PTHREAD_H
 
 #include <asm/pthread.h>
+#include <sched.h>
 #include <stddef.h>
 
 typedef struct __pthread *pthread_t;
@@ -83,6 +84,14 @@ int pthread_join(pthread_t thread, void **exit_status);
 
 void pthread_exit(void *exit_status);
 
+/* -------------------------------------------------------------------------
+ * CPU affinity (non-portable)
+ * ------------------------------------------------------------------------- */
+
+int pthread_getaffinity_np(pthread_t thread, size_t cpusetsize, cpu_set_t *cpuset);
+
+int pthread_setaffinity_np(pthread_t thread, size_t cpusetsize, const cpu_set_t *cpuset);
+
 /* -------------------------------------------------------------------------
  * Thread cancellation
  * ------------------------------------------------------------------------- */
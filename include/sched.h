@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _JINUE_LIBC_SCHED_H
+#define _JINUE_LIBC_SCHED_H
+
+#include <stdint.h>
+
+/** number of CPUs that can be represented in a CPU set */
+#define CPU_SETSIZE 32
+
+typedef struct {
+    uint32_t __bits;
+} cpu_set_t;
+
+#define CPU_ZERO(set) ((set)->__bits = 0)
+
+#define CPU_SET(cpu, set) \
+        ((unsigned int)(cpu) < CPU_SETSIZE ? ((set)->__bits |= (uint32_t)1 << (cpu)) : 0)
+
+#define CPU_CLR(cpu, set) \
+        ((unsigned int)(cpu) < CPU_SETSIZE ? ((set)->__bits &= ~((uint32_t)1 << (cpu))) : 0)
+
+#define CPU_ISSET(cpu, set) \
+        ((unsigned int)(cpu) < CPU_SETSIZE && ((set)->__bits & ((uint32_t)1 << (cpu))) != 0)
+
+#endif
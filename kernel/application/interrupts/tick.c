@@ -31,7 +31,14 @@
 
 #include <kernel/application/interrupts.h>
 #include <kernel/domain/services/scheduler.h>
+#include <kernel/domain/services/timer.h>
+#include <kernel/machine/timer.h>
 
 void tick_interrupt(void) {
-   scheduler_tick();
+   /* Each CPU sets its own timer for the next time it needs to be interrupted,
+    * so this is not called on every tick. */
+   uint64_t now = machine_get_ticks();
+
+   timer_update(now);
+   scheduler_tick(now);
 }
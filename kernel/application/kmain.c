@@ -29,13 +29,21 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <kernel/domain/alloc/kmalloc.h>
+#include <kernel/domain/alloc/vmalloc.h>
+#include <kernel/domain/entities/channel.h>
+#include <kernel/domain/entities/completion_queue.h>
 #include <kernel/domain/entities/endpoint.h>
+#include <kernel/domain/entities/endpoint_set.h>
+#include <kernel/domain/entities/notification.h>
 #include <kernel/domain/entities/process.h>
 #include <kernel/domain/entities/thread.h>
 #include <kernel/domain/services/cmdline.h>
 #include <kernel/domain/services/exec.h>
+#include <kernel/domain/services/ipc.h>
 #include <kernel/domain/services/logging.h>
 #include <kernel/domain/services/panic.h>
+#include <kernel/domain/services/scheduler.h>
 #include <kernel/domain/config.h>
 #include <kernel/machine/init.h>
 #include <kernel/kmain.h>
@@ -72,6 +80,13 @@ void kmain(const char *cmdline) {
     /* Initialize machine-dependent code. */
     machine_init(config);
 
+    /* Initialize the virtual address allocator. This is done once the
+     * machine-dependent code is done mapping memory during initialization. */
+    initialize_vmalloc();
+
+    /* Initialize the general-purpose allocator. */
+    initialize_kmalloc();
+
     kern_mem_block_t ramdisk;
     machine_get_ramdisk(&ramdisk);
 
@@ -81,10 +96,21 @@ void kmain(const char *cmdline) {
         ramdisk.start
     );
 
+    /* Initialize IPC. */
+    initialize_ipc();
+
     /* Initialize object caches. */
     initialize_endpoint_cache();
+    initialize_endpoint_set_cache();
+    initialize_notification_cache();
+    initialize_channel_cache();
+    initialize_completion_queue_cache();
     initialize_process_cache();
 
+    /* Start the other CPUs. Each CPU runs its idle thread until there are
+     * threads ready to run. */
+    scheduler_start_cpus();
+
     /* Create process for user space loader. */
     process_t *process = process_new();
 
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jinue/shared/asm/errno.h>
+#include <jinue/shared/asm/permissions.h>
+#include <kernel/application/syscalls.h>
+#include <kernel/domain/entities/descriptor.h>
+#include <kernel/domain/entities/endpoint_set.h>
+#include <kernel/domain/entities/process.h>
+
+/**
+ * Add an IPC endpoint to an endpoint set
+ *
+ * Both descriptors must have the receive permission.
+ *
+ * @param set_fd descriptor that references the endpoint set
+ * @param endpoint_fd descriptor that references the endpoint to add
+ * @return zero on success, negated error number on error
+ *
+ */
+int add_to_endpoint_set(int set_fd, int endpoint_fd) {
+    process_t *process = get_current_process();
+
+    descriptor_t set_desc;
+    int status = descriptor_access_object(&set_desc, process, set_fd);
+
+    if(status < 0) {
+        return status;
+    }
+
+    ipc_endpoint_set_t *set = descriptor_get_endpoint_set(&set_desc);
+
+    if(set == NULL) {
+        descriptor_unreference_object(&set_desc);
+        return -JINUE_EBADF;
+    }
+
+    if(!descriptor_has_permissions(&set_desc, JINUE_PERM_RECEIVE)) {
+        descriptor_unreference_object(&set_desc);
+        return -JINUE_EPERM;
+    }
+
+    descriptor_t endpoint_desc;
+    status = descriptor_access_object(&endpoint_desc, process, endpoint_fd);
+
+    if(status < 0) {
+        descriptor_unreference_object(&set_desc);
+        return status;
+    }
+
+    ipc_endpoint_t *endpoint = descriptor_get_endpoint(&endpoint_desc);
+
+    if(endpoint == NULL) {
+        status = -JINUE_EBADF;
+    }
+    else if(!descriptor_has_permissions(&endpoint_desc, JINUE_PERM_RECEIVE)) {
+        status = -JINUE_EPERM;
+    }
+    else {
+        status = endpoint_set_add(set, endpoint, endpoint_fd);
+    }
+
+    descriptor_unreference_object(&endpoint_desc);
+    descriptor_unreference_object(&set_desc);
+
+    return status;
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jinue/shared/asm/errno.h>
+#include <jinue/shared/asm/permissions.h>
+#include <kernel/application/syscalls.h>
+#include <kernel/domain/entities/descriptor.h>
+#include <kernel/domain/entities/process.h>
+#include <kernel/domain/services/ipc.h>
+
+/**
+ * Bind a notification to an IPC endpoint or endpoint set
+ *
+ * Both descriptors must have the receive permission.
+ *
+ * @param fd descriptor that references the notification
+ * @param target_fd descriptor that references the endpoint or endpoint set
+ * @return zero on success, negated error number on error
+ *
+ */
+int bind_notification(int fd, int target_fd) {
+    process_t *process = get_current_process();
+
+    descriptor_t desc;
+    int status = descriptor_access_object(&desc, process, fd);
+
+    if(status < 0) {
+        return status;
+    }
+
+    notification_t *notification = descriptor_get_notification(&desc);
+
+    if(notification == NULL) {
+        descriptor_unreference_object(&desc);
+        return -JINUE_EBADF;
+    }
+
+    if(!descriptor_has_permissions(&desc, JINUE_PERM_RECEIVE)) {
+        descriptor_unreference_object(&desc);
+        return -JINUE_EPERM;
+    }
+
+    descriptor_t target_desc;
+    status = descriptor_access_object(&target_desc, process, target_fd);
+
+    if(status < 0) {
+        descriptor_unreference_object(&desc);
+        return status;
+    }
+
+    ipc_queue_t *queue;
+    status = descriptor_get_receive_queue(&queue, &target_desc);
+
+    if(status == 0 && !descriptor_has_permissions(&target_desc, JINUE_PERM_RECEIVE)) {
+        status = -JINUE_EPERM;
+    }
+
+    if(status == 0) {
+        status = bind_notification_to_queue(notification, queue);
+    }
+
+    descriptor_unreference_object(&target_desc);
+    descriptor_unreference_object(&desc);
+
+    return status;
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jinue/shared/asm/errno.h>
+#include <kernel/application/syscalls.h>
+#include <kernel/domain/entities/channel.h>
+#include <kernel/domain/entities/descriptor.h>
+#include <kernel/domain/entities/object.h>
+#include <kernel/domain/entities/process.h>
+
+/**
+ * Create a channel owned by the current process
+ *
+ * @param fd descriptor number for the new channel
+ * @param entry_size size of a ring entry in bytes
+ * @param entries number of entries in the ring, a power of two
+ * @return zero on success, negated error number on error
+ *
+ */
+int create_channel(int fd, uint32_t entry_size, uint32_t entries) {
+    if(entry_size == 0 || entries == 0 || (entries & (entries - 1)) != 0) {
+        return -JINUE_EINVAL;
+    }
+
+    const uint32_t max_data_size = JINUE_CHANNEL_MAX_SIZE - JINUE_CHANNEL_HEADER_SIZE;
+
+    if(entry_size > max_data_size || entries > max_data_size / entry_size) {
+        return -JINUE_EINVAL;
+    }
+
+    process_t *process  = get_current_process();
+    int status          = descriptor_reserve_unused(process, fd);
+
+    if(status < 0) {
+        return status;
+    }
+
+    channel_t *channel = channel_new(entry_size, entries);
+
+    if(channel == NULL) {
+        descriptor_free_reservation(process, fd);
+        return -JINUE_EAGAIN;
+    }
+
+    descriptor_t desc;
+    desc.object = channel_object(channel);
+    desc.flags  = DESC_FLAG_OWNER | object_type_channel->all_permissions;
+    desc.cookie = 0;
+
+    descriptor_open(process, fd, &desc);
+
+    return 0;
+}
@@ -39,13 +39,12 @@
 /**
  * Create an IPC endpoint owned by the current thread
  *
- * All currently recognized flags will be deprecated.
- *
- * @param flags flags
- * @return IPC endpoint descriptor on success, negated error number on error
+ * @param fd descriptor number to bind to the new IPC endpoint
+ * @param flags endpoint creation flags (JINUE_ENDPOINT_...)
+ * @return zero on success, negated error number on error
  *
  */
-int create_endpoint(int fd) {
+int create_endpoint(int fd, int flags) {
     process_t *process  = get_current_process();
     int status          = descriptor_reserve_unused(process, fd);
 
@@ -53,7 +52,7 @@ int create_endpoint(int fd) {
         return status;
     }
 
-    ipc_endpoint_t *endpoint = endpoint_new();
+    ipc_endpoint_t *endpoint = endpoint_new(flags);
 
     if(endpoint == NULL) {
         descriptor_free_reservation(process, fd);
@@ -31,8 +31,12 @@
 
 #include <jinue/shared/asm/errno.h>
 #include <kernel/application/syscalls.h>
+#include <kernel/domain/entities/channel.h>
+#include <kernel/domain/entities/completion_queue.h>
 #include <kernel/domain/entities/descriptor.h>
 #include <kernel/domain/entities/endpoint.h>
+#include <kernel/domain/entities/endpoint_set.h>
+#include <kernel/domain/entities/notification.h>
 #include <kernel/domain/entities/object.h>
 #include <kernel/domain/entities/process.h>
 
@@ -49,7 +53,12 @@ int destroy(int fd) {
     object_header_t *object = desc.object;
 
     /* TODO support other object types */
-    if(object->type != object_type_ipc_endpoint) {
+    if(
+            object->type != object_type_ipc_endpoint &&
+            object->type != object_type_ipc_endpoint_set &&
+            object->type != object_type_notification &&
+            object->type != object_type_channel &&
+            object->type != object_type_completion_queue) {
         descriptor_unreference_object(&desc);
         return -JINUE_EBADF;
     }
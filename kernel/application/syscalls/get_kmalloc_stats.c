@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <kernel/application/syscalls.h>
+#include <kernel/domain/alloc/kmalloc.h>
+
+/**
+ * Get kernel memory allocator statistics
+ *
+ * One entry is written for each kmalloc() size class, in increasing size order,
+ * followed by one entry for allocations served in whole pages. If the buffer is
+ * too small for all entries, only the entries that fit are written.
+ *
+ * @param buffer buffer where the array of entries is written
+ * @return number of entries written
+ */
+int get_kmalloc_stats(const jinue_buffer_t *buffer) {
+    kmalloc_stats_t stats[KMALLOC_NUM_STATS];
+
+    int length = kmalloc_get_stats(stats, buffer->size / sizeof(jinue_kmalloc_stats_t));
+
+    jinue_kmalloc_stats_t *entries = buffer->addr;
+
+    for(int idx = 0; idx < length; ++idx) {
+        entries[idx].size       = stats[idx].size;
+        entries[idx].allocated  = stats[idx].allocated;
+        entries[idx].allocs     = stats[idx].allocs;
+        entries[idx].failures   = stats[idx].failures;
+        entries[idx].bytes      = stats[idx].bytes;
+    }
+
+    return length;
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jinue/shared/asm/errno.h>
+#include <jinue/shared/asm/permissions.h>
+#include <kernel/application/syscalls.h>
+#include <kernel/domain/entities/channel.h>
+#include <kernel/domain/entities/descriptor.h>
+#include <kernel/domain/entities/process.h>
+#include <kernel/utils/pmap.h>
+
+/**
+ * Map the shared memory of a channel into a process' address space
+ *
+ * Both descriptors must have the map permission.
+ *
+ * @param process_fd descriptor that references the process
+ * @param channel_fd descriptor that references the channel
+ * @param addr start address of the mapping, aligned on a page boundary
+ * @return zero on success, negated error number on error
+ *
+ */
+int map_channel(int process_fd, int channel_fd, void *addr) {
+    process_t *current = get_current_process();
+
+    descriptor_t channel_desc;
+    int status = descriptor_access_object(&channel_desc, current, channel_fd);
+
+    if(status < 0) {
+        return status;
+    }
+
+    channel_t *channel = descriptor_get_channel(&channel_desc);
+
+    if(channel == NULL) {
+        descriptor_unreference_object(&channel_desc);
+        return -JINUE_EBADF;
+    }
+
+    if(!descriptor_has_permissions(&channel_desc, JINUE_PERM_MAP)) {
+        descriptor_unreference_object(&channel_desc);
+        return -JINUE_EPERM;
+    }
+
+    if(!check_userspace_buffer(addr, channel->size)) {
+        descriptor_unreference_object(&channel_desc);
+        return -JINUE_EINVAL;
+    }
+
+    descriptor_t process_desc;
+    status = descriptor_access_object(&process_desc, current, process_fd);
+
+    if(status < 0) {
+        descriptor_unreference_object(&channel_desc);
+        return status;
+    }
+
+    process_t *process = descriptor_get_process(&process_desc);
+
+    if(process == NULL) {
+        status = -JINUE_EBADF;
+    }
+    else if(!descriptor_has_permissions(&process_desc, JINUE_PERM_MAP)) {
+        status = -JINUE_EPERM;
+    }
+    else {
+        status = channel_map(channel, process, (addr_t)addr);
+    }
+
+    descriptor_unreference_object(&process_desc);
+    descriptor_unreference_object(&channel_desc);
+
+    return status;
+}
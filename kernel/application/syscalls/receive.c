@@ -32,11 +32,12 @@
 #include <jinue/shared/asm/errno.h>
 #include <jinue/shared/asm/permissions.h>
 #include <kernel/application/syscalls.h>
+#include <kernel/application/ticks.h>
 #include <kernel/domain/entities/descriptor.h>
 #include <kernel/domain/services/ipc.h>
 #include <kernel/machine/thread.h>
 
-int receive(int fd, jinue_message_t *message) {
+int receive(int fd, int flags, uint32_t timeout_ms, jinue_message_t *message) {
     thread_t *receiver = get_current_thread();
 
     descriptor_t desc;
@@ -46,11 +47,12 @@ int receive(int fd, jinue_message_t *message) {
         return status;
     }
 
-    ipc_endpoint_t *endpoint = descriptor_get_endpoint(&desc);
+    ipc_queue_t *queue;
+    status = descriptor_get_receive_queue(&queue, &desc);
 
-    if(endpoint == NULL) {
+    if(status < 0) {
         descriptor_unreference_object(&desc);
-        return -JINUE_EBADF;
+        return status;
     }
 
     if(!descriptor_has_permissions(&desc, JINUE_PERM_RECEIVE)) {
@@ -58,7 +60,21 @@ int receive(int fd, jinue_message_t *message) {
         return -JINUE_EPERM;
     }
 
-    status = receive_message(endpoint, receiver, message);
+    status = receive_message(queue, receiver, flags, timeout_to_ticks(timeout_ms), message);
+
+    if(status >= 0) {
+        /* For an endpoint set, report the member endpoint to which the
+         * message was sent. A notification has no endpoint and is reported on
+         * the descriptor passed as argument. */
+        ipc_endpoint_t *endpoint = get_message_endpoint(receiver);
+
+        if(endpoint != NULL && descriptor_get_endpoint_set(&desc) != NULL) {
+            message->recv_endpoint = endpoint->set_member_fd;
+        }
+        else {
+            message->recv_endpoint = fd;
+        }
+    }
 
     descriptor_unreference_object(&desc);
 
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jinue/shared/asm/errno.h>
+#include <jinue/shared/asm/permissions.h>
+#include <kernel/application/syscalls.h>
+#include <kernel/domain/entities/descriptor.h>
+#include <kernel/domain/services/ipc.h>
+#include <kernel/machine/thread.h>
+#include <stdbool.h>
+
+/**
+ * Receive a batch of messages from an IPC endpoint
+ *
+ * The call blocks until a first message is received, unless JINUE_IPC_NONBLOCK
+ * is set, and then receives the messages that are already queued until the
+ * entries array is full. Each message is written to the buffer of its entry.
+ *
+ * A thread services one synchronous message at a time, so only asynchronous
+ * requests and notifications are received in a batch. Synchronous messages
+ * are left queued for a regular receive. Each request is acknowledged with an
+ * empty reply right away, which completes it.
+ *
+ * The entries array must have been checked by the caller.
+ *
+ * @param fd descriptor that references the IPC endpoint or endpoint set
+ * @param flags IPC flags (JINUE_IPC_...)
+ * @param entries entries array
+ * @param length number of elements in the entries array
+ * @return number of messages received on success, negated error number on error
+ *
+ */
+int receive_batch(int fd, int flags, jinue_recv_entry_t *entries, int length) {
+    thread_t *receiver = get_current_thread();
+
+    descriptor_t desc;
+    int status = descriptor_access_object(&desc, receiver->process, fd);
+
+    if(status < 0) {
+        return status;
+    }
+
+    ipc_queue_t *queue;
+    status = descriptor_get_receive_queue(&queue, &desc);
+
+    if(status < 0) {
+        descriptor_unreference_object(&desc);
+        return status;
+    }
+
+    if(!descriptor_has_permissions(&desc, JINUE_PERM_RECEIVE)) {
+        descriptor_unreference_object(&desc);
+        return -JINUE_EPERM;
+    }
+
+    bool is_set     = (descriptor_get_endpoint_set(&desc) != NULL);
+    int received    = 0;
+
+    receiver->recv_requests_only = true;
+
+    while(received < length) {
+        jinue_recv_entry_t *entry = &entries[received];
+
+        jinue_message_t message;
+        message.send_buffers            = NULL;
+        message.send_buffers_length     = 0;
+        message.recv_buffers            = &entry->buffer;
+        message.recv_buffers_length     = 1;
+        message.send_bulk.addr          = NULL;
+        message.send_bulk.size          = 0;
+        message.bulk_window.addr        = NULL;
+        message.bulk_window.size        = 0;
+        message.send_descs              = NULL;
+        message.send_descs_length       = 0;
+        message.recv_descs              = NULL;
+        message.recv_descs_length       = 0;
+        message.recv_descs_count        = 0;
+
+        /* Only wait for the first message. */
+        int recv_flags = (received == 0) ? flags : (flags | JINUE_IPC_NONBLOCK);
+
+        status = receive_message(queue, receiver, recv_flags, 0, &message);
+
+        if(status < 0) {
+            break;
+        }
+
+        ipc_endpoint_t *endpoint = get_message_endpoint(receiver);
+
+        entry->function         = message.recv_function;
+        entry->cookie           = message.recv_cookie;
+        entry->size             = status;
+        entry->recv_endpoint    = (endpoint != NULL && is_set) ? endpoint->set_member_fd : fd;
+
+        acknowledge_request(receiver);
+
+        ++received;
+    }
+
+    receiver->recv_requests_only = false;
+
+    descriptor_unreference_object(&desc);
+
+    if(received == 0) {
+        return status;
+    }
+
+    return received;
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jinue/shared/asm/errno.h>
+#include <jinue/shared/asm/permissions.h>
+#include <kernel/application/syscalls.h>
+#include <kernel/application/ticks.h>
+#include <kernel/domain/entities/descriptor.h>
+#include <kernel/domain/services/ipc.h>
+#include <kernel/machine/thread.h>
+
+int reply_receive(int fd, int flags, uint32_t timeout_ms, jinue_message_t *message) {
+    thread_t *receiver = get_current_thread();
+
+    descriptor_t desc;
+    int status = descriptor_access_object(&desc, receiver->process, fd);
+
+    if(status < 0) {
+        return status;
+    }
+
+    ipc_queue_t *queue;
+    status = descriptor_get_receive_queue(&queue, &desc);
+
+    if(status < 0) {
+        descriptor_unreference_object(&desc);
+        return status;
+    }
+
+    if(!descriptor_has_permissions(&desc, JINUE_PERM_RECEIVE)) {
+        descriptor_unreference_object(&desc);
+        return -JINUE_EPERM;
+    }
+
+    status = reply_and_receive_message(queue, receiver, flags, timeout_to_ticks(timeout_ms), message);
+
+    if(status >= 0) {
+        /* For an endpoint set, report the member endpoint to which the
+         * message was sent. A notification has no endpoint and is reported on
+         * the descriptor passed as argument. */
+        ipc_endpoint_t *endpoint = get_message_endpoint(receiver);
+
+        if(endpoint != NULL && descriptor_get_endpoint_set(&desc) != NULL) {
+            message->recv_endpoint = endpoint->set_member_fd;
+        }
+        else {
+            message->recv_endpoint = fd;
+        }
+    }
+
+    descriptor_unreference_object(&desc);
+
+    return status;
+}
@@ -32,11 +32,19 @@
 #include <jinue/shared/asm/errno.h>
 #include <jinue/shared/asm/permissions.h>
 #include <kernel/application/syscalls.h>
+#include <kernel/application/ticks.h>
 #include <kernel/domain/entities/descriptor.h>
 #include <kernel/domain/services/ipc.h>
 #include <kernel/machine/thread.h>
 
-int send(uintptr_t *errcode, int fd, int function, const jinue_message_t *message) {
+int send(
+        uintptr_t       *errcode,
+        int              fd,
+        int              function,
+        int              flags,
+        uint32_t         timeout_ms,
+        jinue_message_t *message) {
+
     thread_t *sender = get_current_thread();
 
     descriptor_t desc;
@@ -58,7 +66,15 @@ int send(uintptr_t *errcode, int fd, int function, const jinue_message_t *messag
         return -JINUE_EPERM;
     }
 
-    status = send_message(errcode, endpoint, sender, function, desc.cookie, message);
+    status = send_message(
+            errcode,
+            endpoint,
+            sender,
+            function,
+            desc.cookie,
+            flags,
+            timeout_to_ticks(timeout_ms),
+            message);
 
     descriptor_unreference_object(&desc);
 
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jinue/shared/asm/errno.h>
+#include <jinue/shared/asm/permissions.h>
+#include <kernel/application/syscalls.h>
+#include <kernel/domain/entities/descriptor.h>
+#include <kernel/domain/services/ipc.h>
+#include <kernel/machine/thread.h>
+
+/**
+ * Send an asynchronous request to an IPC endpoint
+ *
+ * The endpoint descriptor must have the send permission. The completion queue
+ * descriptor must also have the send permission and the completion queue must
+ * have been created by the current process.
+ *
+ * @param fd descriptor that references the IPC endpoint
+ * @param function function number of the message
+ * @param cq_fd descriptor that references the completion queue
+ * @param message structure describing the message
+ * @return request identifier on success, negated error number on error
+ *
+ */
+int send_async(int fd, int function, int cq_fd, jinue_message_t *message) {
+    thread_t *sender = get_current_thread();
+
+    descriptor_t desc;
+    int status = descriptor_access_object(&desc, sender->process, fd);
+
+    if(status < 0) {
+        return status;
+    }
+
+    ipc_endpoint_t *endpoint = descriptor_get_endpoint(&desc);
+
+    if(endpoint == NULL) {
+        descriptor_unreference_object(&desc);
+        return -JINUE_EBADF;
+    }
+
+    if(!descriptor_has_permissions(&desc, JINUE_PERM_SEND)) {
+        descriptor_unreference_object(&desc);
+        return -JINUE_EPERM;
+    }
+
+    descriptor_t cq_desc;
+    status = descriptor_access_object(&cq_desc, sender->process, cq_fd);
+
+    if(status < 0) {
+        descriptor_unreference_object(&desc);
+        return status;
+    }
+
+    completion_queue_t *queue = descriptor_get_completion_queue(&cq_desc);
+
+    if(queue == NULL) {
+        descriptor_unreference_object(&cq_desc);
+        descriptor_unreference_object(&desc);
+        return -JINUE_EBADF;
+    }
+
+    if(!descriptor_has_permissions(&cq_desc, JINUE_PERM_SEND) || queue->process != sender->process) {
+        descriptor_unreference_object(&cq_desc);
+        descriptor_unreference_object(&desc);
+        return -JINUE_EPERM;
+    }
+
+    status = send_async_message(endpoint, queue, sender, function, desc.cookie, message);
+
+    descriptor_unreference_object(&cq_desc);
+    descriptor_unreference_object(&desc);
+
+    return status;
+}
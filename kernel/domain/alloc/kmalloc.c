@@ -0,0 +1,340 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <kernel/domain/alloc/kmalloc.h>
+#include <kernel/domain/alloc/page_alloc.h>
+#include <kernel/domain/alloc/slab.h>
+#include <kernel/machine/asm/machine.h>
+#include <kernel/machine/smp.h>
+#include <kernel/utils/utils.h>
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file
+ *
+ * General-purpose kernel memory allocator
+ *
+ * kmalloc() is meant for variable-size kernel data structures that do not have
+ * their own object cache (see init_object_cache()). Requests up to
+ * KMALLOC_MAX_CLASS_SIZE bytes are rounded up to a size class and served by a
+ * slab cache for that class. The size classes are the powers of two from 8
+ * bytes, plus one intermediate class between consecutive powers of two from 16
+ * bytes so that no more than a third of an object is wasted by rounding up.
+ *
+ * Larger requests are rounded up to a power of two number of pages and served
+ * by the page allocator (i.e. page_alloc_order()). These blocks, single pages
+ * included, are always in the page allocator's buddy region, where their order
+ * is recorded so kfree() can tell them apart from slab objects.
+ *
+ * */
+
+/** alignment of memory returned by kmalloc() */
+#define KMALLOC_ALIGNMENT   8
+
+/** number of pages in the region where page allocations are tracked */
+#define LARGE_PAGES         ((VMALLOC_AREA_ADDR - ALLOC_BASE) / PAGE_SIZE)
+
+/** index of the statistics entry for multi-page allocations */
+#define LARGE_STATS         KMALLOC_NUM_CLASSES
+
+typedef struct {
+    size_t   size;
+    char    *name;
+} size_class_t;
+
+static const size_class_t size_classes[KMALLOC_NUM_CLASSES] = {
+    {8,     "kmalloc_8"},
+    {16,    "kmalloc_16"},
+    {24,    "kmalloc_24"},
+    {32,    "kmalloc_32"},
+    {48,    "kmalloc_48"},
+    {64,    "kmalloc_64"},
+    {96,    "kmalloc_96"},
+    {128,   "kmalloc_128"},
+    {192,   "kmalloc_192"},
+    {256,   "kmalloc_256"},
+    {384,   "kmalloc_384"},
+    {512,   "kmalloc_512"},
+    {768,   "kmalloc_768"},
+    {1024,  "kmalloc_1024"},
+    {1536,  "kmalloc_1536"}
+};
+
+static slab_cache_t caches[KMALLOC_NUM_CLASSES];
+
+/** size class for each size, in multiples of KMALLOC_ALIGNMENT */
+static uint8_t class_lookup[KMALLOC_MAX_CLASS_SIZE / KMALLOC_ALIGNMENT + 1];
+
+/** one plus the order of the multi-page block starting at each page, zero if
+ * no such block starts there */
+static uint8_t large_orders[LARGE_PAGES];
+
+typedef struct {
+    unsigned int    allocs;
+    unsigned int    frees;
+    unsigned int    failures;
+} class_counters_t;
+
+/* Statistics are counted per CPU so that keeping them does not add contention
+ * to allocations and frees. Each CPU only updates its own counters, and kernel
+ * code runs with interrupts disabled and is never preempted, so the counters
+ * are updated without atomics or locking. */
+
+static class_counters_t counters[MAX_CPUS][KMALLOC_NUM_STATS];
+
+/** pages allocated (minus pages freed) for multi-page allocations by each CPU */
+static int large_pages[MAX_CPUS];
+
+/**
+ * Initialize the general-purpose allocator
+ *
+ * This function initializes the slab cache of each size class, so it must be
+ * called during kernel initialization, once the page allocator is ready.
+ *
+ * */
+void initialize_kmalloc(void) {
+    int class = 0;
+
+    for(int idx = 0; idx < sizeof(class_lookup); ++idx) {
+        while(size_classes[class].size < idx * KMALLOC_ALIGNMENT) {
+            ++class;
+        }
+
+        class_lookup[idx] = class;
+    }
+
+    for(int idx = 0; idx < KMALLOC_NUM_CLASSES; ++idx) {
+        slab_cache_init(
+            &caches[idx],
+            size_classes[idx].name,
+            size_classes[idx].size,
+            KMALLOC_ALIGNMENT,
+            NULL,
+            NULL,
+            SLAB_DEFAULTS
+        );
+    }
+}
+
+/**
+ * Get the statistics counters of the current CPU
+ *
+ * @param index size class, or LARGE_STATS for multi-page allocations
+ * @return counters
+ *
+ * */
+static class_counters_t *get_counters(int index) {
+    return &counters[machine_get_current_cpu()][index];
+}
+
+/**
+ * Get the index of a page in the multi-page allocation region
+ *
+ * @param ptr address in the page
+ * @return page index, -1 if the address is outside the region
+ *
+ * */
+static int large_index_of(const void *ptr) {
+    addr_t addr = (addr_t)ptr;
+
+    if(addr < (addr_t)ALLOC_BASE || addr >= (addr_t)VMALLOC_AREA_ADDR) {
+        return -1;
+    }
+
+    return (addr - (addr_t)ALLOC_BASE) / PAGE_SIZE;
+}
+
+/**
+ * Allocate memory using whole pages
+ *
+ * @param size size of the allocation in bytes
+ * @return allocated memory, NULL if allocation failed
+ *
+ * */
+static void *alloc_large(size_t size) {
+    class_counters_t *stats = get_counters(LARGE_STATS);
+
+    if(size > ((size_t)PAGE_SIZE << PAGE_ALLOC_MAX_ORDER)) {
+        ++stats->failures;
+        return NULL;
+    }
+
+    int order = 0;
+
+    while(((size_t)PAGE_SIZE << order) < size) {
+        ++order;
+    }
+
+    void *block = page_alloc_order(order);
+
+    if(block == NULL) {
+        ++stats->failures;
+        return NULL;
+    }
+
+    int index = large_index_of(block);
+
+    /** ASSERTION: page_alloc_order() only returns blocks in the buddy region */
+    assert(index >= 0);
+
+    large_orders[index] = order + 1;
+
+    ++stats->allocs;
+    large_pages[machine_get_current_cpu()] += 1 << order;
+
+    return block;
+}
+
+/**
+ * Allocate kernel memory
+ *
+ * The returned memory is aligned on at least eight bytes and its content is
+ * undefined. Allocations larger than KMALLOC_MAX_CLASS_SIZE bytes are aligned
+ * on a page boundary.
+ *
+ * @param size size of the allocation in bytes
+ * @return allocated memory, NULL if allocation failed or if size is zero
+ *
+ * */
+void *kmalloc(size_t size) {
+    if(size == 0) {
+        return NULL;
+    }
+
+    if(size > KMALLOC_MAX_CLASS_SIZE) {
+        return alloc_large(size);
+    }
+
+    int class = class_lookup[(size + KMALLOC_ALIGNMENT - 1) / KMALLOC_ALIGNMENT];
+
+    class_counters_t *stats = get_counters(class);
+
+    void *ptr = slab_cache_alloc(&caches[class]);
+
+    if(ptr == NULL) {
+        ++stats->failures;
+    }
+    else {
+        ++stats->allocs;
+    }
+
+    return ptr;
+}
+
+/**
+ * Free memory allocated by kmalloc()
+ *
+ * @param ptr the memory to free, or NULL
+ *
+ * */
+void kfree(void *ptr) {
+    if(ptr == NULL) {
+        return;
+    }
+
+    int index = large_index_of(ptr);
+
+    if(index >= 0 && large_orders[index] != 0) {
+        int order = large_orders[index] - 1;
+        large_orders[index] = 0;
+
+        ++get_counters(LARGE_STATS)->frees;
+        large_pages[machine_get_current_cpu()] -= 1 << order;
+
+        page_free_order(ptr, order);
+        return;
+    }
+
+    addr_t slab_start   = ALIGN_START_PTR(ptr, SLAB_SIZE);
+    slab_t *slab        = (slab_t *)(slab_start + SLAB_SIZE - sizeof(slab_t));
+    int class           = slab->cache - caches;
+
+    /** ASSERTION: the memory was allocated by kmalloc() */
+    assert(class >= 0 && class < KMALLOC_NUM_CLASSES);
+
+    ++get_counters(class)->frees;
+
+    slab_cache_free(ptr);
+}
+
+/**
+ * Get usage statistics for each size class
+ *
+ * One entry is reported for each slab-backed size class, in increasing size
+ * order, followed by one entry for multi-page allocations. Counters are summed
+ * over all CPUs without synchronization, so they might be slightly off while
+ * allocations are in progress on other CPUs.
+ *
+ * @param stats array where the statistics are stored
+ * @param length number of entries in the array
+ * @return number of entries stored
+ *
+ * */
+int kmalloc_get_stats(kmalloc_stats_t *stats, int length) {
+    if(length > KMALLOC_NUM_STATS) {
+        length = KMALLOC_NUM_STATS;
+    }
+
+    for(int idx = 0; idx < length; ++idx) {
+        unsigned int allocs     = 0;
+        unsigned int frees      = 0;
+        unsigned int failures   = 0;
+
+        for(int cpu = 0; cpu < MAX_CPUS; ++cpu) {
+            allocs      += counters[cpu][idx].allocs;
+            frees       += counters[cpu][idx].frees;
+            failures    += counters[cpu][idx].failures;
+        }
+
+        stats[idx].allocated    = allocs - frees;
+        stats[idx].allocs       = allocs;
+        stats[idx].failures     = failures;
+
+        if(idx < KMALLOC_NUM_CLASSES) {
+            stats[idx].size     = size_classes[idx].size;
+            stats[idx].bytes    = (allocs - frees) * size_classes[idx].size;
+        }
+        else {
+            int pages = 0;
+
+            for(int cpu = 0; cpu < MAX_CPUS; ++cpu) {
+                pages += large_pages[cpu];
+            }
+
+            stats[idx].size     = 0;
+            stats[idx].bytes    = (size_t)pages * PAGE_SIZE;
+        }
+    }
+
+    return length;
+}
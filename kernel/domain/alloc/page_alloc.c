@@ -34,19 +34,342 @@
 #include <kernel/domain/alloc/vmalloc.h>
 #include <kernel/machine/asm/machine.h>
 #include <kernel/machine/pmap.h>
+#include <kernel/machine/smp.h>
 #include <kernel/machine/spinlock.h>
+#include <assert.h>
+#include <stdint.h>
 #include <string.h>
 
 
+/* Pages are managed by a binary buddy allocator. Free blocks of 2^order
+ * contiguous pages are kept in one free list per order. When a block is freed
+ * and its buddy (the other half of the block of the next order) is also free,
+ * the two are merged, and so on up to PAGE_ALLOC_MAX_ORDER.
+ *
+ * Merging is only possible in the region from ALLOC_BASE to VMALLOC_AREA_ADDR,
+ * which is where the machine-dependent code maps the memory it allocates during
+ * boot. This region is mapped linearly so blocks that are contiguous in it are
+ * also physically contiguous. Blocks are aligned on their size relative to
+ * ALLOC_BASE, not to virtual address zero: ALLOC_BASE is only aligned on one
+ * megabyte, so blocks of more than 256 pages are not aligned on their size
+ * virtually. ALLOC_BASE maps to physical address 16MB, which is aligned on
+ * PAGE_SIZE << PAGE_ALLOC_MAX_ORDER, so all blocks are aligned on their size
+ * physically. Pages outside this region, e.g. page frames added with
+ * add_page_frame(), are kept on a separate list and only handed out one at a
+ * time by page_alloc(), so every block returned by page_alloc_order(), single
+ * pages included, is in the region. */
+
+/** number of pages in the region where blocks can be merged */
+#define BUDDY_PAGES         ((VMALLOC_AREA_ADDR - ALLOC_BASE) / PAGE_SIZE)
+
+/** value in the order map for pages that are not the first page of a free block */
+#define ORDER_NOT_FREE      (-1)
+
 struct alloc_page {
     struct alloc_page *next;
+    struct alloc_page *prev;
 };
 
-static struct alloc_page *head_page = NULL;
+/** free lists, one per order */
+static struct alloc_page *free_lists[PAGE_ALLOC_MAX_ORDER + 1];
+
+/** free pages outside the buddy region */
+static struct alloc_page *outside_pages;
+
+/** one plus the order of the free block starting at each page of the buddy
+ * region, zero if no free block starts there */
+static uint8_t free_orders[BUDDY_PAGES];
 
 static unsigned int page_count = 0;
 
-static spinlock_t alloc_lock;
+static spinlock_t alloc_lock = SPINLOCK_INITIALIZER;
+
+/* Each CPU has a cache of single pages in front of the free lists, so most
+ * calls to page_alloc() and page_free() do not take the global lock. The cache
+ * is refilled up to the low watermark when it is empty, and drained down to
+ * the low watermark when it reaches the high watermark.
+ *
+ * A CPU's cache is never accessed by other CPUs. Kernel code runs with
+ * interrupts disabled and is never preempted, so nothing else can run on the
+ * current CPU between the call to machine_get_current_cpu() and the accesses
+ * to the cache it selects. A CPU can thus access its own cache without
+ * locking. The slab allocator's magazines and the kmalloc() statistics
+ * counters rely on the same reasoning. */
+
+/** number of pages left in a page cache after a refill or a drain */
+#define PAGE_CACHE_LOW      16
+
+/** maximum number of pages in a page cache */
+#define PAGE_CACHE_HIGH     64
+
+typedef struct {
+    struct alloc_page   *pages[PAGE_CACHE_HIGH];
+    int                  count;
+} page_cache_t;
+
+static page_cache_t page_caches[MAX_CPUS];
+
+/**
+ * Get the page cache of the current CPU
+ *
+ * @return page cache
+ *
+ * */
+static page_cache_t *get_page_cache(void) {
+    return &page_caches[machine_get_current_cpu()];
+}
+
+/**
+ * Get the index of a page in the buddy region
+ *
+ * @param page the page
+ * @return index of the page, -1 if it is outside the region
+ *
+ * */
+static int buddy_index_of(const void *page) {
+    uintptr_t addr = (uintptr_t)page;
+
+    if(addr < ALLOC_BASE || addr >= VMALLOC_AREA_ADDR) {
+        return -1;
+    }
+
+    return (addr - ALLOC_BASE) / PAGE_SIZE;
+}
+
+/**
+ * Record the order of the free block that starts at a page (without locking)
+ *
+ * @param page first page of the block
+ * @param order order of the block, ORDER_NOT_FREE if the block is not free
+ *
+ * */
+static void set_free_order_locked(const void *page, int order) {
+    int index = buddy_index_of(page);
+
+    if(index >= 0) {
+        free_orders[index] = order + 1;
+    }
+}
+
+/**
+ * Add a block to the free list for its order (without locking)
+ *
+ * @param block the block
+ * @param order order of the block
+ *
+ * */
+static void push_block_locked(struct alloc_page *block, int order) {
+    block->prev = NULL;
+    block->next = free_lists[order];
+
+    if(block->next != NULL) {
+        block->next->prev = block;
+    }
+
+    free_lists[order] = block;
+
+    set_free_order_locked(block, order);
+}
+
+/**
+ * Remove a block from the free list for its order (without locking)
+ *
+ * @param block the block
+ * @param order order of the block
+ *
+ * */
+static void unlink_block_locked(struct alloc_page *block, int order) {
+    if(block->prev == NULL) {
+        free_lists[order] = block->next;
+    } else {
+        block->prev->next = block->next;
+    }
+
+    if(block->next != NULL) {
+        block->next->prev = block->prev;
+    }
+
+    set_free_order_locked(block, ORDER_NOT_FREE);
+}
+
+/**
+ * Allocate a block of pages from the free lists (without locking)
+ *
+ * @param order order of the block
+ * @return first page of the allocated block, NULL if allocation failed
+ *
+ * */
+static struct alloc_page *alloc_block_locked(int order) {
+    int current = order;
+
+    while(current <= PAGE_ALLOC_MAX_ORDER && free_lists[current] == NULL) {
+        ++current;
+    }
+
+    if(current > PAGE_ALLOC_MAX_ORDER) {
+        return NULL;
+    }
+
+    struct alloc_page *block = free_lists[current];
+    unlink_block_locked(block, current);
+
+    /* Split the block, keeping the lower half and freeing the upper half,
+     * until it has the requested order. */
+    while(current > order) {
+        --current;
+
+        struct alloc_page *upper = (struct alloc_page *)((char *)block + (PAGE_SIZE << current));
+        push_block_locked(upper, current);
+    }
+
+    page_count -= 1u << order;
+
+    return block;
+}
+
+/**
+ * Return a block of pages to the free lists (without locking)
+ *
+ * @param block the block
+ * @param order order of the block
+ *
+ * */
+static void free_block_locked(struct alloc_page *block, int order) {
+    page_count += 1u << order;
+
+    int index = buddy_index_of(block);
+
+    if(index < 0) {
+        /** ASSERTION: only single pages can be outside the buddy region */
+        assert(order == 0);
+
+        block->next     = outside_pages;
+        outside_pages   = block;
+        return;
+    }
+
+    while(order < PAGE_ALLOC_MAX_ORDER) {
+        int buddy_index = index ^ (1 << order);
+
+        if(buddy_index >= BUDDY_PAGES || free_orders[buddy_index] != order + 1) {
+            break;
+        }
+
+        struct alloc_page *buddy = (struct alloc_page *)(ALLOC_BASE + buddy_index * PAGE_SIZE);
+        unlink_block_locked(buddy, order);
+
+        index &= ~(1 << order);
+        block = (struct alloc_page *)(ALLOC_BASE + index * PAGE_SIZE);
+        ++order;
+    }
+
+    push_block_locked(block, order);
+}
+
+/**
+ * Fill the page cache of the current CPU up to the low watermark
+ *
+ * @param cache the page cache
+ *
+ * */
+static void refill_page_cache(page_cache_t *cache) {
+    spin_lock(&alloc_lock);
+
+    /* Pages outside the buddy region are used first since they cannot be
+     * merged and page_alloc_order() cannot return them. */
+    while(cache->count < PAGE_CACHE_LOW && outside_pages != NULL) {
+        cache->pages[cache->count++] = outside_pages;
+        outside_pages = outside_pages->next;
+        --page_count;
+    }
+
+    while(cache->count < PAGE_CACHE_LOW) {
+        struct alloc_page *page = alloc_block_locked(0);
+
+        if(page == NULL) {
+            break;
+        }
+
+        cache->pages[cache->count++] = page;
+    }
+
+    spin_unlock(&alloc_lock);
+}
+
+/**
+ * Return pages from the page cache of the current CPU to the free lists
+ *
+ * @param cache the page cache
+ * @param target number of pages left in the cache
+ *
+ * */
+static void drain_page_cache(page_cache_t *cache, int target) {
+    spin_lock(&alloc_lock);
+
+    while(cache->count > target) {
+        free_block_locked(cache->pages[--cache->count], 0);
+    }
+
+    spin_unlock(&alloc_lock);
+}
+
+/**
+ * Allocate a block of physically contiguous pages of kernel memory.
+ *
+ * The block contains 2^order pages and is aligned on its size physically and
+ * relative to ALLOC_BASE (see the comment at the top of this file). It is
+ * always in the buddy region, even if order is zero. If no free block of the
+ * requested order is available, a larger block is split.
+ *
+ * @param order order of the block, from 0 to PAGE_ALLOC_MAX_ORDER
+ * @return first page of the allocated block, NULL if allocation failed
+ *
+ * */
+void *page_alloc_order(int order) {
+    if(order < 0 || order > PAGE_ALLOC_MAX_ORDER) {
+        return NULL;
+    }
+
+    spin_lock(&alloc_lock);
+
+    struct alloc_page *block = alloc_block_locked(order);
+
+    spin_unlock(&alloc_lock);
+
+    if(block == NULL) {
+        /* Pages in the cache of the current CPU might be what prevents
+         * merging into a large enough block or, for a single page, be the
+         * only free pages left in the buddy region. The caches of other CPUs
+         * cannot be drained from here. */
+        drain_page_cache(get_page_cache(), 0);
+
+        spin_lock(&alloc_lock);
+
+        block = alloc_block_locked(order);
+
+        spin_unlock(&alloc_lock);
+    }
+
+    return block;
+}
+
+/**
+ * Free a block of pages of kernel memory.
+ *
+ * The block is merged with its buddy if it is free too, and so on with the
+ * resulting block.
+ *
+ * @param first_page first page of the block
+ * @param order order of the block, as passed to page_alloc_order()
+ *
+ * */
+void page_free_order(void *first_page, int order) {
+    spin_lock(&alloc_lock);
+
+    free_block_locked(first_page, order);
+
+    spin_unlock(&alloc_lock);
+}
 
 /**
  * Allocate a page of kernel memory.
@@ -54,22 +377,24 @@ static spinlock_t alloc_lock;
  * Pages allocated by this function can be used for any purpose in the kernel,
  * e.g. as slabs for the slab allocator or as page tables.
  *
+ * The page is taken from the page cache of the current CPU, which is refilled
+ * from the free lists in batches.
+ *
  * @return allocated page
  *
  * */
 void *page_alloc(void) {
-    spin_lock(&alloc_lock);
+    page_cache_t *cache = get_page_cache();
 
-    struct alloc_page *alloc_page = head_page;
+    if(cache->count == 0) {
+        refill_page_cache(cache);
 
-    if(alloc_page != NULL) {
-        head_page = alloc_page->next;
-        --page_count;
+        if(cache->count == 0) {
+            return NULL;
+        }
     }
 
-    spin_unlock(&alloc_lock);
-
-    return alloc_page;
+    return cache->pages[--cache->count];
 }
 
 /**
@@ -82,28 +407,40 @@ void *page_alloc(void) {
  * reclaim pages allocated during kernel initialization by boot_page_alloc() or
  * boot_page_alloc_n().
  *
+ * The page is added to the page cache of the current CPU. If the cache reaches
+ * its high watermark, it is drained down to its low watermark.
+ *
  * @param page the page to free
  *
  * */
 void page_free(void *page) {
-    spin_lock(&alloc_lock);
+    page_cache_t *cache = get_page_cache();
 
-    struct alloc_page *alloc_page = page;
-    alloc_page->next    = head_page;
-    head_page           = alloc_page;
-    ++page_count;
+    if(cache->count >= PAGE_CACHE_HIGH) {
+        drain_page_cache(cache, PAGE_CACHE_LOW);
+    }
 
-    spin_unlock(&alloc_lock);
+    cache->pages[cache->count++] = page;
 }
 
 /** 
  * Get the number of pages currently allocatable by the page allocator
  *
+ * This includes the pages in the page caches of all CPUs. The caches of other
+ * CPUs are read without synchronization, so the count might be slightly off
+ * while they are in use.
+ *
  * @return page count
  *
  * */
 unsigned int get_page_count(void) {
-    return page_count;
+    unsigned int count = page_count;
+
+    for(int cpu = 0; cpu < MAX_CPUS; ++cpu) {
+        count += page_caches[cpu].count;
+    }
+
+    return count;
 }
 
 /**
@@ -143,8 +480,8 @@ bool add_page_frame(paddr_t paddr) {
  *
  * This function is used implement a system call that allows userspace to
  * reclaim free kernel memory for its own use. The address space page is
- * freed with vmfree() and the physical address of the underlying page frame is
- * returned.
+ * freed with vmfree() if it was allocated with vmalloc() and the physical
+ * address of the underlying page frame is returned.
  *
  * @return physical address of the freed page frame, or PFNULL if none is available
  *
@@ -165,7 +502,11 @@ paddr_t remove_page_frame(void) {
 
     machine_unmap_kernel(page, PAGE_SIZE);
 
-    vmfree(page);
+    /* Pages allocated during boot are not in the region managed by vmalloc(),
+     * so their address cannot be reused. */
+    if(vmalloc_is_in_range(page)) {
+        vmfree(page);
+    }
 
     return paddr;
 }
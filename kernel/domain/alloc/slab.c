@@ -34,6 +34,7 @@
 #include <kernel/domain/services/logging.h>
 #include <kernel/domain/services/panic.h>
 #include <kernel/machine/cpuinfo.h>
+#include <kernel/machine/smp.h>
 #include <kernel/utils/utils.h>
 #include <kernel/types.h>
 #include <assert.h>
@@ -55,8 +56,24 @@
  * This is the main object allocator for the kernel. (Some early allocations
  * performed during kernel initialization use the boot heap instead - see boot.c.)
  *
+ * A magazine layer, as described in Jeff Bonwick and Jonathan Adams' paper
+ * "Magazines and Vmem: Extending the Slab Allocator to Many CPUs and Arbitrary
+ * Resources", sits in front of the slabs:
+ *
+ *  https://www.usenix.org/legacy/event/usenix01/full_papers/bonwick/bonwick.pdf
+ *
+ * Each CPU has a loaded and a previous magazine of constructed objects for
+ * each cache. Most allocations and frees only pop from or push to the loaded
+ * magazine of the current CPU, without taking any lock or touching the slabs.
+ * When both magazines are exhausted, full or empty magazines are exchanged
+ * with the cache's depot, and the slab layer is only used when the depot
+ * cannot help.
+ *
  * */
 
+/** slab cache used for allocating the magazines themselves */
+static slab_cache_t magazine_cache;
+
 static void init_and_add_slab(slab_cache_t *cache, void *slab_addr);
 
 static void destroy_slab(slab_cache_t *cache, slab_t *slab);
@@ -105,6 +122,10 @@ static size_t compute_alignment(size_t alignment, int flags) {
  *    pattern before calling the constructor function to help identify members
  *    that do not get initialized. Do the same when freeing objects and use this
  *    to detect writes to freed objects.
+ *  - SLAB_NO_MAGAZINES Allocate and free all objects directly on the slabs,
+ *    under the cache lock, instead of through per-CPU magazines. This is
+ *    implied by SLAB_RED_ZONE and SLAB_POISON because the checks they enable
+ *    are performed on the slabs.
  *
  * This function uses the kernel's boot-time page allocator to allocate an
  * initial slab. This helps with bootstrapping because it allows a few objects
@@ -148,6 +169,31 @@ void slab_cache_init(
     cache->next_colour      = 0;
     cache->working_set      = SLAB_DEFAULT_WORKING_SET;
     cache->alignment        = compute_alignment(alignment, flags);
+    cache->use_magazines    = !(flags & (SLAB_NO_MAGAZINES | SLAB_RED_ZONE | SLAB_POISON));
+    cache->depot_full       = NULL;
+    cache->depot_empty      = NULL;
+
+    for(int cpu = 0; cpu < MAX_CPUS; ++cpu) {
+        cache->cpu_caches[cpu].loaded   = NULL;
+        cache->cpu_caches[cpu].previous = NULL;
+    }
+
+    init_spinlock(&cache->lock);
+    init_spinlock(&cache->depot_lock);
+
+    /* The magazine cache is initialized along with the first cache that needs
+     * it. It does not use magazines itself. */
+    if(cache->use_magazines && magazine_cache.name == NULL) {
+        slab_cache_init(
+            &magazine_cache,
+            "slab_magazine_cache",
+            sizeof(slab_magazine_t),
+            0,
+            NULL,
+            NULL,
+            SLAB_NO_MAGAZINES
+        );
+    }
     
     /* Reserve space for bufctl and/or redzone word. */
     cache->obj_size = ALIGN_END(size, sizeof(uint32_t));
@@ -330,18 +376,13 @@ void *slab_cache_alloc_locked(slab_cache_t *cache) {
 }
 
 /**
- * Allocate an object from the specified cache.
- *
- * The cache must have been initialized with slab_cache_init(). If no more space
- * is available on existing slabs, this function tries to allocate a new slab
- * using the kernel's page allocator (i.e. page_alloc()). If page allocation
- * fails, this function fails by returning NULL.
+ * Allocate an object directly from the slabs
  *
  * @param cache the cache from which to allocate an object
  * @return the address of the allocated object, or NULL if allocation failed
  *
  * */
-void *slab_cache_alloc(slab_cache_t *cache) {
+static void *alloc_from_slabs(slab_cache_t *cache) {
     spin_lock(&cache->lock);
 
     void *buffer = slab_cache_alloc_locked(cache);
@@ -352,22 +393,20 @@ void *slab_cache_alloc(slab_cache_t *cache) {
 }
 
 /**
- * Free an object.
+ * Return an object to its slab under lock
  *
+ * @param cache the cache to which the object belongs
  * @param buffer the object to free
  *
  * */
-void slab_cache_free(void *buffer) {
+static void free_to_slab_locked(slab_cache_t *cache, void *buffer) {
     /* compute address of slab data structure */
     addr_t slab_start       = ALIGN_START_PTR(buffer, SLAB_SIZE);
     slab_t *slab            = (slab_t *)(slab_start + SLAB_SIZE - sizeof(slab_t) );
-    
-    /* obtain address of cache and bufctl */
-    slab_cache_t *cache     = slab->cache;
+
+    /* obtain address of bufctl */
     slab_bufctl_t *bufctl   = (slab_bufctl_t *)((char *)buffer + cache->bufctl_offset);
 
-    spin_lock(&cache->lock);
-    
     /* If slab is on the full slabs list, move it to the partial list
      * since we are about to return a buffer to it. */
     if(slab->free_list == NULL) {
@@ -450,10 +489,173 @@ void slab_cache_free(void *buffer) {
         
         ++(cache->empty_count);
     }
+}
+
+/**
+ * Return an object directly to its slab
+ *
+ * @param cache the cache to which the object belongs
+ * @param buffer the object to free
+ *
+ * */
+static void free_to_slabs(slab_cache_t *cache, void *buffer) {
+    spin_lock(&cache->lock);
+
+    free_to_slab_locked(cache, buffer);
 
     spin_unlock(&cache->lock);
 }
 
+/**
+ * Get the magazines of the current CPU for a cache
+ *
+ * Kernel code runs with interrupts disabled, so the current CPU can access its
+ * own magazines without locking.
+ *
+ * @param cache the cache
+ * @return per-CPU magazines
+ *
+ * */
+static slab_cpu_cache_t *get_cpu_cache(slab_cache_t *cache) {
+    return &cache->cpu_caches[machine_get_current_cpu()];
+}
+
+/**
+ * Allocate an object from the specified cache.
+ *
+ * The cache must have been initialized with slab_cache_init(). The object is
+ * taken from the current CPU's magazines if possible, then from a full magazine
+ * in the cache's depot. Otherwise, it is allocated from the slabs. If no more
+ * space is available on existing slabs, this function tries to allocate a new
+ * slab using the kernel's page allocator (i.e. page_alloc()). If page
+ * allocation fails, this function fails by returning NULL.
+ *
+ * @param cache the cache from which to allocate an object
+ * @return the address of the allocated object, or NULL if allocation failed
+ *
+ * */
+void *slab_cache_alloc(slab_cache_t *cache) {
+    if(! cache->use_magazines) {
+        return alloc_from_slabs(cache);
+    }
+
+    slab_cpu_cache_t *cpu_cache = get_cpu_cache(cache);
+    slab_magazine_t *loaded     = cpu_cache->loaded;
+
+    if(loaded != NULL && loaded->rounds > 0) {
+        return loaded->objects[--loaded->rounds];
+    }
+
+    slab_magazine_t *previous = cpu_cache->previous;
+
+    /* The previous magazine is always either full or empty. */
+    if(previous != NULL && previous->rounds > 0) {
+        cpu_cache->loaded   = previous;
+        cpu_cache->previous = loaded;
+        return previous->objects[--previous->rounds];
+    }
+
+    spin_lock(&cache->depot_lock);
+
+    slab_magazine_t *full = cache->depot_full;
+
+    if(full != NULL) {
+        cache->depot_full = full->next;
+
+        if(previous != NULL) {
+            previous->next      = cache->depot_empty;
+            cache->depot_empty  = previous;
+        }
+    }
+
+    spin_unlock(&cache->depot_lock);
+
+    if(full == NULL) {
+        return alloc_from_slabs(cache);
+    }
+
+    cpu_cache->previous = loaded;
+    cpu_cache->loaded   = full;
+
+    return full->objects[--full->rounds];
+}
+
+/**
+ * Free an object.
+ *
+ * The object is kept, in its constructed state, in the current CPU's magazines
+ * if possible. Otherwise, a full magazine is exchanged for an empty one from
+ * the cache's depot or for a newly allocated one. The object is only returned
+ * to its slab if no empty magazine can be obtained.
+ *
+ * @param buffer the object to free
+ *
+ * */
+void slab_cache_free(void *buffer) {
+    /* compute address of slab data structure */
+    addr_t slab_start       = ALIGN_START_PTR(buffer, SLAB_SIZE);
+    slab_t *slab            = (slab_t *)(slab_start + SLAB_SIZE - sizeof(slab_t) );
+    slab_cache_t *cache     = slab->cache;
+
+    if(! cache->use_magazines) {
+        free_to_slabs(cache, buffer);
+        return;
+    }
+
+    slab_cpu_cache_t *cpu_cache = get_cpu_cache(cache);
+    slab_magazine_t *loaded     = cpu_cache->loaded;
+
+    if(loaded != NULL && loaded->rounds < SLAB_MAGAZINE_SIZE) {
+        loaded->objects[loaded->rounds++] = buffer;
+        return;
+    }
+
+    slab_magazine_t *previous = cpu_cache->previous;
+
+    if(previous != NULL && previous->rounds == 0) {
+        cpu_cache->loaded   = previous;
+        cpu_cache->previous = loaded;
+        previous->objects[previous->rounds++] = buffer;
+        return;
+    }
+
+    spin_lock(&cache->depot_lock);
+
+    slab_magazine_t *empty = cache->depot_empty;
+
+    if(empty != NULL) {
+        cache->depot_empty = empty->next;
+    }
+
+    spin_unlock(&cache->depot_lock);
+
+    if(empty == NULL) {
+        empty = slab_cache_alloc(&magazine_cache);
+
+        if(empty == NULL) {
+            free_to_slabs(cache, buffer);
+            return;
+        }
+
+        empty->rounds = 0;
+    }
+
+    /* At this point, the previous magazine is either full or NULL. */
+    if(previous != NULL) {
+        spin_lock(&cache->depot_lock);
+
+        previous->next      = cache->depot_full;
+        cache->depot_full   = previous;
+
+        spin_unlock(&cache->depot_lock);
+    }
+
+    cpu_cache->previous = loaded;
+    cpu_cache->loaded   = empty;
+
+    empty->objects[empty->rounds++] = buffer;
+}
+
 /**
  * Initialize a new empty slab and add it to a cache's free list.
  *
@@ -575,12 +777,46 @@ static void destroy_slab(slab_cache_t *cache, slab_t *slab) {
 /**
  * Return memory to the page allocator.
  *
- * Free slabs in excess to the cache's working set are finalized and freed.
+ * The objects in the full magazines of the cache's depot are returned to their
+ * slabs and the depot's magazines are freed. Then, free slabs in excess to the
+ * cache's working set are finalized and freed. The magazines loaded on each CPU
+ * are left alone.
  *
  * @param cache the cache from which to reclaim memory
  *
  * */
 void slab_cache_reap(slab_cache_t *cache) {
+    spin_lock(&cache->depot_lock);
+
+    slab_magazine_t *full   = cache->depot_full;
+    slab_magazine_t *empty  = cache->depot_empty;
+    cache->depot_full       = NULL;
+    cache->depot_empty      = NULL;
+
+    spin_unlock(&cache->depot_lock);
+
+    spin_lock(&cache->lock);
+
+    for(slab_magazine_t *magazine = full; magazine != NULL; magazine = magazine->next) {
+        while(magazine->rounds > 0) {
+            free_to_slab_locked(cache, magazine->objects[--magazine->rounds]);
+        }
+    }
+
+    spin_unlock(&cache->lock);
+
+    while(full != NULL) {
+        slab_magazine_t *next = full->next;
+        slab_cache_free(full);
+        full = next;
+    }
+
+    while(empty != NULL) {
+        slab_magazine_t *next = empty->next;
+        slab_cache_free(empty);
+        empty = next;
+    }
+
     spin_lock(&cache->lock);
 
     while(cache->empty_count > cache->working_set) {
@@ -30,8 +30,15 @@
  */
 
 #include <kernel/domain/alloc/vmalloc.h>
+#include <kernel/domain/services/mman.h>
 #include <kernel/domain/services/panic.h>
-#include <kernel/utils/pmap.h>
+#include <kernel/machine/asm/machine.h>
+#include <kernel/machine/pmap.h>
+#include <kernel/machine/spinlock.h>
+#include <kernel/utils/utils.h>
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
 
 
 /**
@@ -45,7 +52,289 @@
  * If you want to allocate a mapped page ready to use, use the page allocator
  * instead, i.e. page_alloc().
  *
+ * Addresses are allocated from two arenas:
+ *
+ * - The vmalloc area (VMALLOC_AREA_ADDR), with a granularity of one page.
+ *   vmalloc() and vmalloc_n() allocate from this arena.
+ * - The part of the large pages area (LARGE_PAGES_AREA_ADDR) that is not used
+ *   during kernel initialization, with a granularity of one large page (see
+ *   machine_large_page_size()). vmalloc_large() allocates from this arena.
+ *
+ * Each arena keeps a bitmap with one bit per allocation unit, set if the unit
+ * is free, and a summary bitmap with one bit per bitmap word, set if that word
+ * has any free unit. Finding a free unit only requires looking at the summary
+ * and at a single bitmap word, and contiguous ranges are allocated first fit.
+ *
+ * */
+
+/** number of units per bitmap word */
+#define BITS_PER_WORD       32
+
+/** number of bitmap words needed for a given number of units */
+#define NUM_WORDS(n)        (((n) + BITS_PER_WORD - 1) / BITS_PER_WORD)
+
+/** maximum number of units in the vmalloc area arena */
+#define VMALLOC_MAX_UNITS   (VMALLOC_AREA_SIZE / PAGE_SIZE)
+
+/** maximum number of units in the large pages arena, i.e. if large pages are not supported */
+#define LARGE_MAX_UNITS     (LARGE_PAGES_AREA_SIZE / PAGE_SIZE)
+
+typedef struct {
+    uintptr_t        start;
+    size_t           unit_size;
+    unsigned int     num_units;
+    unsigned int     free_units;
+    uint32_t        *bitmap;
+    uint32_t        *summary;
+    spinlock_t       lock;
+} arena_t;
+
+static uint32_t vmalloc_bitmap[NUM_WORDS(VMALLOC_MAX_UNITS)];
+
+static uint32_t vmalloc_summary[NUM_WORDS(NUM_WORDS(VMALLOC_MAX_UNITS))];
+
+static uint32_t large_bitmap[NUM_WORDS(LARGE_MAX_UNITS)];
+
+static uint32_t large_summary[NUM_WORDS(NUM_WORDS(LARGE_MAX_UNITS))];
+
+static arena_t vmalloc_arena = {
+    .num_units  = 0,
+    .bitmap     = vmalloc_bitmap,
+    .summary    = vmalloc_summary,
+    .lock       = SPINLOCK_INITIALIZER
+};
+
+static arena_t large_arena = {
+    .num_units  = 0,
+    .bitmap     = large_bitmap,
+    .summary    = large_summary,
+    .lock       = SPINLOCK_INITIALIZER
+};
+
+/**
+ * Mark a range of units as free or allocated (without locking)
+ *
+ * @param arena the arena
+ * @param first index of the first unit
+ * @param count number of units
+ * @param is_free true to mark the units as free, false to mark them allocated
+ *
+ * */
+static void mark_units_locked(arena_t *arena, unsigned int first, unsigned int count, bool is_free) {
+    for(unsigned int index = first; index < first + count; ++index) {
+        unsigned int word   = index / BITS_PER_WORD;
+        uint32_t mask       = (uint32_t)1 << (index % BITS_PER_WORD);
+
+        if(is_free) {
+            arena->bitmap[word] |= mask;
+        } else {
+            arena->bitmap[word] &= ~mask;
+        }
+
+        uint32_t summary_mask = (uint32_t)1 << (word % BITS_PER_WORD);
+
+        if(arena->bitmap[word] != 0) {
+            arena->summary[word / BITS_PER_WORD] |= summary_mask;
+        } else {
+            arena->summary[word / BITS_PER_WORD] &= ~summary_mask;
+        }
+    }
+
+    if(is_free) {
+        arena->free_units += count;
+    } else {
+        arena->free_units -= count;
+    }
+}
+
+/**
+ * Find the first bitmap word with a free unit, starting at a given word (without locking)
+ *
+ * @param arena the arena
+ * @param word index of the bitmap word where to start
+ * @return index of the bitmap word, or the number of words if there are none
+ *
+ * */
+static unsigned int find_free_word_locked(const arena_t *arena, unsigned int word) {
+    unsigned int num_words  = NUM_WORDS(arena->num_units);
+    unsigned int index      = word / BITS_PER_WORD;
+
+    if(word >= num_words) {
+        return num_words;
+    }
+
+    uint32_t bits = arena->summary[index] & (~(uint32_t)0 << (word % BITS_PER_WORD));
+
+    while(bits == 0) {
+        ++index;
+
+        if(index >= NUM_WORDS(num_words)) {
+            return num_words;
+        }
+
+        bits = arena->summary[index];
+    }
+
+    return index * BITS_PER_WORD + bit_scan_forward(bits);
+}
+
+/**
+ * Find the first free unit, starting at a given unit (without locking)
+ *
+ * @param arena the arena
+ * @param from index of the unit where to start
+ * @return index of the free unit, or the number of units if there are none
+ *
+ * */
+static unsigned int find_free_unit_locked(const arena_t *arena, unsigned int from) {
+    if(from >= arena->num_units) {
+        return arena->num_units;
+    }
+
+    unsigned int word   = from / BITS_PER_WORD;
+    uint32_t bits       = arena->bitmap[word] & (~(uint32_t)0 << (from % BITS_PER_WORD));
+
+    if(bits == 0) {
+        word = find_free_word_locked(arena, word + 1);
+
+        if(word >= NUM_WORDS(arena->num_units)) {
+            return arena->num_units;
+        }
+
+        bits = arena->bitmap[word];
+    }
+
+    return word * BITS_PER_WORD + bit_scan_forward(bits);
+}
+
+/**
+ * Check whether a unit is free (without locking)
+ *
+ * @param arena the arena
+ * @param index index of the unit
+ * @return true if the unit is free, false otherwise
+ *
  * */
+static bool is_unit_free_locked(const arena_t *arena, unsigned int index) {
+    return (arena->bitmap[index / BITS_PER_WORD] & ((uint32_t)1 << (index % BITS_PER_WORD))) != 0;
+}
+
+/**
+ * Allocate a range of contiguous units from an arena
+ *
+ * @param arena the arena
+ * @param count number of units, must not be zero
+ * @return start address of the range, NULL if allocation failed
+ *
+ * */
+static addr_t arena_alloc(arena_t *arena, unsigned int count) {
+    addr_t addr = NULL;
+
+    spin_lock(&arena->lock);
+
+    if(count <= arena->free_units) {
+        unsigned int first = find_free_unit_locked(arena, 0);
+
+        while(first + count <= arena->num_units) {
+            unsigned int index = first + 1;
+
+            while(index < first + count && is_unit_free_locked(arena, index)) {
+                ++index;
+            }
+
+            if(index == first + count) {
+                mark_units_locked(arena, first, count, false);
+                addr = (addr_t)(arena->start + first * arena->unit_size);
+                break;
+            }
+
+            /* The range starting at first is too short. Continue after the
+             * allocated unit that ends it. */
+            first = find_free_unit_locked(arena, index + 1);
+        }
+    }
+
+    spin_unlock(&arena->lock);
+
+    return addr;
+}
+
+/**
+ * Check whether an address is in an arena
+ *
+ * @param arena the arena
+ * @param addr the address
+ * @return true if the address is in the arena, false otherwise
+ *
+ * */
+static bool arena_contains(const arena_t *arena, addr_t addr) {
+    uintptr_t value = (uintptr_t)addr;
+
+    return value >= arena->start && value - arena->start < arena->num_units * arena->unit_size;
+}
+
+/**
+ * Free a range of contiguous units
+ *
+ * @param arena the arena
+ * @param addr start address of the range
+ * @param count number of units
+ *
+ * */
+static void arena_free(arena_t *arena, addr_t addr, unsigned int count) {
+    /** ASSERTION: the range is in the arena and aligned on a unit boundary */
+    assert(arena_contains(arena, addr) && arena_contains(arena, addr + count * arena->unit_size - 1));
+    assert(((uintptr_t)addr - arena->start) % arena->unit_size == 0);
+
+    unsigned int first = ((uintptr_t)addr - arena->start) / arena->unit_size;
+
+    spin_lock(&arena->lock);
+
+    for(unsigned int index = first; index < first + count; ++index) {
+        if(is_unit_free_locked(arena, index)) {
+            panic("vmfree(): page is already free");
+        }
+    }
+
+    mark_units_locked(arena, first, count, true);
+
+    spin_unlock(&arena->lock);
+}
+
+/**
+ * Initialize an arena with all units free
+ *
+ * @param arena the arena
+ * @param start start address
+ * @param size size, in bytes
+ * @param unit_size allocation granularity
+ *
+ * */
+static void initialize_arena(arena_t *arena, addr_t start, size_t size, size_t unit_size) {
+    arena->start        = (uintptr_t)start;
+    arena->unit_size    = unit_size;
+    arena->num_units    = size / unit_size;
+    arena->free_units   = 0;
+
+    mark_units_locked(arena, 0, arena->num_units, true);
+}
+
+/**
+ * Initialize the virtual address allocator
+ *
+ * This function must be called once initialization of the machine-dependent
+ * code is complete, since the large pages arena is made of the part of the
+ * large pages area it did not use.
+ *
+ * */
+void initialize_vmalloc(void) {
+    initialize_arena(&vmalloc_arena, (addr_t)VMALLOC_AREA_ADDR, VMALLOC_AREA_SIZE, PAGE_SIZE);
+
+    size_t large_size;
+    addr_t large_start = reserve_large_pages_in_kernel(&large_size);
+
+    initialize_arena(&large_arena, large_start, large_size, machine_large_page_size());
+}
 
 /**
  * Allocate a page of virtual address space.
@@ -54,11 +343,40 @@
  *
  * */
 addr_t vmalloc(void) {
-    /* TODO implement this */
-    panic("vmalloc(): not implemented");
+    return arena_alloc(&vmalloc_arena, 1);
+}
 
-    /* never reached */
-    return NULL;
+/**
+ * Allocate contiguous pages of virtual address space.
+ *
+ * @param num_pages number of pages, must not be zero
+ * @return address of the first allocated page or NULL if allocation failed
+ *
+ * */
+addr_t vmalloc_n(int num_pages) {
+    return arena_alloc(&vmalloc_arena, num_pages);
+}
+
+/**
+ * Allocate virtual address space to be mapped with large pages.
+ *
+ * The allocated range is aligned on a large page boundary and its size is a
+ * multiple of the large page size (see machine_large_page_size()). Mappings
+ * in that range with machine_map_kernel() use large pages if they are
+ * supported.
+ *
+ * @param size size of the range, rounded up to a multiple of the large page size
+ * @return address of the allocated range or NULL if allocation failed
+ *
+ * */
+addr_t vmalloc_large(size_t size) {
+    size_t unit_size = large_arena.unit_size;
+
+    if(size == 0 || unit_size == 0) {
+        return NULL;
+    }
+
+    return arena_alloc(&large_arena, ALIGN_END(size, unit_size) / unit_size);
 }
 
 /**
@@ -68,8 +386,31 @@ addr_t vmalloc(void) {
  *
  * */
 void vmfree(addr_t page) {
-    /* TODO implement this */
-    panic("vmfree(): not implemented");
+    arena_free(&vmalloc_arena, page, 1);
+}
+
+/**
+ * Free contiguous pages of virtual address space.
+ *
+ * @param addr the address of the first page
+ * @param num_pages number of pages
+ *
+ * */
+void vmfree_n(addr_t addr, int num_pages) {
+    arena_free(&vmalloc_arena, addr, num_pages);
+}
+
+/**
+ * Free virtual address space allocated with vmalloc_large().
+ *
+ * @param addr the address of the range
+ * @param size size of the range, as passed to vmalloc_large()
+ *
+ * */
+void vmfree_large(addr_t addr, size_t size) {
+    size_t unit_size = large_arena.unit_size;
+
+    arena_free(&large_arena, addr, ALIGN_END(size, unit_size) / unit_size);
 }
 
 /**
@@ -80,5 +421,5 @@ void vmfree(addr_t page) {
  *
  * */
 bool vmalloc_is_in_range(addr_t page) {
-    return is_kernel_pointer(page);
+    return arena_contains(&vmalloc_arena, page) || arena_contains(&large_arena, page);
 }
@@ -0,0 +1,480 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jinue/shared/asm/errno.h>
+#include <jinue/shared/asm/mman.h>
+#include <jinue/shared/asm/permissions.h>
+#include <kernel/domain/alloc/kmalloc.h>
+#include <kernel/domain/alloc/page_alloc.h>
+#include <kernel/domain/alloc/slab.h>
+#include <kernel/domain/entities/channel.h>
+#include <kernel/domain/entities/descriptor.h>
+#include <kernel/domain/entities/object.h>
+#include <kernel/domain/services/ipc.h>
+#include <kernel/domain/services/scheduler.h>
+#include <kernel/machine/asm/machine.h>
+#include <kernel/machine/atomic.h>
+#include <kernel/machine/pmap.h>
+#include <kernel/machine/spinlock.h>
+#include <kernel/utils/list.h>
+#include <stddef.h>
+
+static void cache_ctor_op(void *buffer, size_t size);
+
+static void open_op(object_header_t *object, const descriptor_t *desc);
+
+static void close_op(object_header_t *object, const descriptor_t *desc);
+
+static void destroy_op(object_header_t *object);
+
+static void free_op(object_header_t *object);
+
+static const object_type_t object_type = {
+    .all_permissions    = JINUE_PERM_SEND | JINUE_PERM_RECEIVE | JINUE_PERM_MAP,
+    .name               = "channel",
+    .size               = sizeof(channel_t),
+    .open               = open_op,
+    .close              = close_op,
+    .destroy            = destroy_op,
+    .free               = free_op,
+    .cache_ctor         = cache_ctor_op,
+    .cache_dtor         = NULL
+};
+
+/** runtime type definition for a channel */
+const object_type_t *object_type_channel = &object_type;
+
+/** slab cache used for allocating channel objects */
+static slab_cache_t channel_cache;
+
+/** mapping of the shared memory of a channel in a process */
+typedef struct {
+    list_node_t  mapping_list;
+    process_t   *process;
+    addr_t       addr;
+} channel_mapping_t;
+
+/** slab cache used for allocating channel mappings */
+static slab_cache_t mapping_cache;
+
+/**
+ * Object constructor for channel slab allocator
+ *
+ * @param buffer channel object being constructed
+ * @param size size in bytes of the channel object (ignored)
+ */
+static void cache_ctor_op(void *buffer, size_t size) {
+    channel_t *channel = buffer;
+
+    object_init_header(&channel->header, object_type_channel);
+    init_spinlock(&channel->lock);
+    init_list(&channel->wait_lists[JINUE_CHANNEL_CONSUMER]);
+    init_list(&channel->wait_lists[JINUE_CHANNEL_PRODUCER]);
+    init_list(&channel->mappings);
+    channel->ring           = NULL;
+    channel->pages          = NULL;
+    channel->size           = 0;
+    channel->entries        = 0;
+    channel->users_count    = 0;
+}
+
+/**
+ * Open a channel
+ *
+ * This function is defined as the "open" op in the runtime type definition,
+ * called when a new descriptor references the channel.
+ *
+ * @param object the channel object
+ * @param desc the new descriptor
+ */
+static void open_op(object_header_t *object, const descriptor_t *desc) {
+    channel_t *channel = (channel_t *)object;
+    add_atomic(&channel->users_count, 1);
+}
+
+/**
+ * Close a channel
+ *
+ * This function is defined as the "close" op in the runtime type definition,
+ * called when a a descriptor that references the channel is closed and stops
+ * referencing it.
+ *
+ * The channel is destroyed when the last descriptor that references it is
+ * closed.
+ *
+ * @param object the channel object
+ * @param desc the descriptor being closed
+ */
+static void close_op(object_header_t *object, const descriptor_t *desc) {
+    channel_t *channel = (channel_t *)object;
+    int users = add_atomic(&channel->users_count, -1);
+
+    if(users < 1) {
+        object_destroy(object);
+    }
+}
+
+/**
+ * Initialize the channel and channel mapping slab caches
+ */
+void initialize_channel_cache(void) {
+    init_object_cache(&channel_cache, object_type_channel);
+
+    slab_cache_init(
+        &mapping_cache,
+        "channel_mapping",
+        sizeof(channel_mapping_t),
+        0,
+        NULL,
+        NULL,
+        SLAB_DEFAULTS
+    );
+}
+
+/**
+ * Free the pages of a channel
+ *
+ * The array that holds the page addresses is freed as well.
+ *
+ * @param channel the channel
+ * @param num_pages number of pages to free
+ */
+static void free_pages(channel_t *channel, int num_pages) {
+    for(int idx = 0; idx < num_pages; ++idx) {
+        page_free(channel->pages[idx]);
+    }
+
+    kfree(channel->pages);
+    channel->pages = NULL;
+}
+
+/**
+ * Constructor for channel object
+ *
+ * The shared memory is allocated and cleared, and the ring header is
+ * initialized. The caller is responsible for ensuring the ring, header
+ * included, fits in JINUE_CHANNEL_MAX_SIZE bytes.
+ *
+ * @param entry_size size of a ring entry in bytes
+ * @param entries number of entries in the ring, a power of two
+ * @return channel on success, NULL on allocation failure
+ */
+channel_t *channel_new(uint32_t entry_size, uint32_t entries) {
+    channel_t *channel = slab_cache_alloc(&channel_cache);
+
+    if(channel == NULL) {
+        return NULL;
+    }
+
+    size_t size     = JINUE_CHANNEL_HEADER_SIZE + entry_size * entries;
+    int num_pages   = (size + PAGE_SIZE - 1) / PAGE_SIZE;
+
+    /* The size of this array depends on the size of the channel, from a few
+     * bytes up to JINUE_CHANNEL_MAX_SIZE / PAGE_SIZE pointers. */
+    channel->pages = kmalloc(num_pages * sizeof(void *));
+
+    if(channel->pages == NULL) {
+        slab_cache_free(channel);
+        return NULL;
+    }
+
+    for(int idx = 0; idx < num_pages; ++idx) {
+        void *page = page_alloc();
+
+        if(page == NULL) {
+            free_pages(channel, idx);
+            slab_cache_free(channel);
+            return NULL;
+        }
+
+        /* This page will be mapped in user space and may have data left from
+         * a previous boot which may contain sensitive information. */
+        clear_page(page);
+
+        channel->pages[idx] = page;
+    }
+
+    object_reset_header(&channel->header);
+
+    channel->ring       = channel->pages[0];
+    channel->size       = num_pages * PAGE_SIZE;
+    channel->entries    = entries;
+
+    channel->ring->entry_size   = entry_size;
+    channel->ring->entries      = entries;
+    channel->ring->data_offset  = JINUE_CHANNEL_HEADER_SIZE;
+
+    return channel;
+}
+
+/**
+ * Remove a mapping of the shared memory of a channel and free it
+ *
+ * A process that has been destroyed no longer has an address space, so there
+ * is nothing to unmap from it.
+ *
+ * @param channel the channel
+ * @param mapping the mapping
+ */
+static void unmap_and_free(channel_t *channel, channel_mapping_t *mapping) {
+    process_t *process = mapping->process;
+
+    if(!object_is_destroyed(&process->header)) {
+        machine_unmap_userspace(process, mapping->addr, channel->size);
+    }
+
+    object_sub_ref(&process->header);
+    slab_cache_free(mapping);
+}
+
+/**
+ * Map the shared memory of a channel into a process' address space
+ *
+ * The whole shared memory is mapped, header included, with read and write
+ * access. The mapping is recorded so it can be removed when the channel is
+ * destroyed. If the shared memory cannot be mapped in full, the pages mapped
+ * so far are unmapped.
+ *
+ * @param channel the channel
+ * @param process process in which to map
+ * @param addr start address of the mapping, aligned on a page boundary
+ * @return zero on success, negated error number on error
+ */
+int channel_map(channel_t *channel, process_t *process, addr_t addr) {
+    channel_mapping_t *mapping = slab_cache_alloc(&mapping_cache);
+
+    if(mapping == NULL) {
+        return -JINUE_ENOMEM;
+    }
+
+    for(size_t offset = 0; offset < channel->size; offset += PAGE_SIZE) {
+        bool success = machine_map_userspace(
+            process,
+            addr + offset,
+            PAGE_SIZE,
+            machine_lookup_kernel_paddr(channel->pages[offset / PAGE_SIZE]),
+            JINUE_PROT_READ | JINUE_PROT_WRITE,
+            JINUE_MAP_NONE
+        );
+
+        if(!success) {
+            machine_unmap_userspace(process, addr, offset);
+            slab_cache_free(mapping);
+            return -JINUE_ENOMEM;
+        }
+    }
+
+    object_add_ref(&process->header);
+
+    mapping->process    = process;
+    mapping->addr       = addr;
+
+    /* The channel might have been destroyed while it was being mapped, in
+     * which case the mapping would never be removed. */
+    spin_lock(&channel->lock);
+
+    bool is_destroyed = object_is_destroyed(&channel->header);
+
+    if(!is_destroyed) {
+        list_enqueue(&channel->mappings, &mapping->mapping_list);
+    }
+
+    spin_unlock(&channel->lock);
+
+    if(is_destroyed) {
+        unmap_and_free(channel, mapping);
+        return -JINUE_EIO;
+    }
+
+    return 0;
+}
+
+/**
+ * Check whether a side of a channel has to wait for its peer
+ *
+ * The consumer waits while the ring is empty and the producer waits while it
+ * is full. The number of entries is taken from the channel object rather than
+ * from the shared memory, which user space can modify.
+ *
+ * @param channel the channel
+ * @param side JINUE_CHANNEL_CONSUMER or JINUE_CHANNEL_PRODUCER
+ * @return true if the side has to wait, false otherwise
+ */
+static bool must_wait(const channel_t *channel, int side) {
+    uint32_t used = channel->ring->tail - channel->ring->head;
+
+    if(side == JINUE_CHANNEL_CONSUMER) {
+        return used == 0;
+    }
+
+    return used >= channel->entries;
+}
+
+/**
+ * Get the waiting flag of a side of a channel in the shared memory
+ *
+ * @param channel the channel
+ * @param side JINUE_CHANNEL_CONSUMER or JINUE_CHANNEL_PRODUCER
+ * @return pointer to waiting flag
+ */
+static int *waiting_flag(channel_t *channel, int side) {
+    if(side == JINUE_CHANNEL_CONSUMER) {
+        return (int *)&channel->ring->consumer_waiting;
+    }
+
+    return (int *)&channel->ring->producer_waiting;
+}
+
+/**
+ * Wait until the peer of a channel makes progress
+ *
+ * The consumer waits until the ring is not empty and the producer waits until
+ * it is not full. Before checking the ring, the waiting flag of the side is set
+ * in the shared memory so the peer knows it has to call channel_signal() once
+ * it has made progress. The flag is set with a locked instruction, so the peer
+ * either sees it or its progress is seen here.
+ *
+ * @param channel the channel
+ * @param thread the waiting thread
+ * @param side JINUE_CHANNEL_CONSUMER or JINUE_CHANNEL_PRODUCER
+ * @return zero on success, negated error number on error
+ */
+int channel_wait(channel_t *channel, thread_t *thread, int side) {
+    spin_lock(&channel->lock);
+
+    (void)swap_atomic(waiting_flag(channel, side), 1);
+
+    if(!must_wait(channel, side)) {
+        *waiting_flag(channel, side) = 0;
+        spin_unlock(&channel->lock);
+        return 0;
+    }
+
+    prepare_message_wait(thread);
+
+    list_enqueue(&channel->wait_lists[side], &thread->thread_list);
+    block_current_thread_and_unlock(&channel->lock);
+
+    if(thread->message_errno != 0) {
+        return -thread->message_errno;
+    }
+
+    return 0;
+}
+
+/**
+ * Wake up the threads waiting on a side of a channel
+ *
+ * The waiting flag of the side is cleared.
+ *
+ * @param channel the channel
+ * @param side JINUE_CHANNEL_CONSUMER or JINUE_CHANNEL_PRODUCER
+ */
+void channel_signal(channel_t *channel, int side) {
+    spin_lock(&channel->lock);
+
+    *waiting_flag(channel, side) = 0;
+
+    while(true) {
+        thread_t *thread = list_dequeue(&channel->wait_lists[side], thread_t, thread_list);
+
+        if(thread == NULL) {
+            break;
+        }
+
+        ready_thread(thread);
+    }
+
+    spin_unlock(&channel->lock);
+}
+
+/**
+ * Destroy a channel
+ *
+ * This function is defined as the "destroy" op in the runtime type definition.
+ *
+ * Threads waiting on the channel fail with JINUE_EIO and the shared memory is
+ * unmapped from all processes in which it was mapped.
+ *
+ * @param object the channel object
+ */
+static void destroy_op(object_header_t *object) {
+    channel_t *channel = (channel_t *)object;
+
+    spin_lock(&channel->lock);
+
+    /* Unmapping requires a TLB shootdown, which must not be done with the lock
+     * held, so the mappings are removed after the lock is released. */
+    list_t mappings = channel->mappings;
+    init_list(&channel->mappings);
+
+    for(int side = 0; side < 2; ++side) {
+        while(true) {
+            thread_t *thread = list_dequeue(&channel->wait_lists[side], thread_t, thread_list);
+
+            if(thread == NULL) {
+                break;
+            }
+
+            abort_message(thread);
+        }
+    }
+
+    spin_unlock(&channel->lock);
+
+    while(true) {
+        channel_mapping_t *mapping = list_dequeue(&mappings, channel_mapping_t, mapping_list);
+
+        if(mapping == NULL) {
+            break;
+        }
+
+        unmap_and_free(channel, mapping);
+    }
+}
+
+/**
+ * Free a channel
+ *
+ * This function is defined as the "free" op in the runtime type definition,
+ * called automatically when the channel's reference count falls to zero.
+ *
+ * @param object the channel object
+ */
+static void free_op(object_header_t *object) {
+    channel_t *channel = (channel_t *)object;
+
+    /* The channel was destroyed before it got here, so the pages are no longer
+     * mapped in any process. */
+    free_pages(channel, channel->size / PAGE_SIZE);
+
+    slab_cache_free(object);
+}
@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jinue/shared/asm/permissions.h>
+#include <kernel/domain/alloc/slab.h>
+#include <kernel/domain/entities/completion_queue.h>
+#include <kernel/domain/entities/descriptor.h>
+#include <kernel/domain/entities/object.h>
+#include <kernel/domain/services/ipc.h>
+#include <kernel/machine/atomic.h>
+#include <kernel/machine/spinlock.h>
+#include <kernel/utils/list.h>
+#include <stddef.h>
+
+static void cache_ctor_op(void *buffer, size_t size);
+
+static void open_op(object_header_t *object, const descriptor_t *desc);
+
+static void close_op(object_header_t *object, const descriptor_t *desc);
+
+static void destroy_op(object_header_t *object);
+
+static void free_op(object_header_t *object);
+
+static const object_type_t object_type = {
+    .all_permissions    = JINUE_PERM_SEND | JINUE_PERM_RECEIVE,
+    .name               = "completion_queue",
+    .size               = sizeof(completion_queue_t),
+    .open               = open_op,
+    .close              = close_op,
+    .destroy            = destroy_op,
+    .free               = free_op,
+    .cache_ctor         = cache_ctor_op,
+    .cache_dtor         = NULL
+};
+
+/** runtime type definition for a completion queue */
+const object_type_t *object_type_completion_queue = &object_type;
+
+/** slab cache used for allocating completion queue objects */
+static slab_cache_t completion_queue_cache;
+
+/**
+ * Object constructor for completion queue slab allocator
+ *
+ * @param buffer completion queue object being constructed
+ * @param size size in bytes of the completion queue object (ignored)
+ */
+static void cache_ctor_op(void *buffer, size_t size) {
+    completion_queue_t *queue = buffer;
+
+    object_init_header(&queue->header, object_type_completion_queue);
+    init_spinlock(&queue->lock);
+    init_list(&queue->completed);
+    init_list(&queue->wait_list);
+    queue->outstanding      = 0;
+    queue->next_id          = 0;
+    queue->process          = NULL;
+    queue->receivers_count  = 0;
+}
+
+/**
+ * Open a completion queue
+ *
+ * This function is defined as the "open" op in the runtime type definition,
+ * called when a new descriptor references the completion queue.
+ *
+ * @param object the completion queue object
+ * @param desc the new descriptor
+ */
+static void open_op(object_header_t *object, const descriptor_t *desc) {
+    if(descriptor_has_permissions(desc, JINUE_PERM_RECEIVE)) {
+        completion_queue_t *queue = (completion_queue_t *)object;
+        add_atomic(&queue->receivers_count, 1);
+    }
+}
+
+/**
+ * Close a completion queue
+ *
+ * This function is defined as the "close" op in the runtime type definition,
+ * called when a a descriptor that references the completion queue is closed
+ * and stops referencing it.
+ *
+ * @param object the completion queue object
+ * @param desc the descriptor being closed
+ */
+static void close_op(object_header_t *object, const descriptor_t *desc) {
+    if(descriptor_has_permissions(desc, JINUE_PERM_RECEIVE)) {
+        completion_queue_t *queue = (completion_queue_t *)object;
+        int receivers = add_atomic(&queue->receivers_count, -1);
+
+        if(receivers < 1) {
+            object_destroy(object);
+        }
+    }
+}
+
+/**
+ * Initialize the completion queue slab cache
+ */
+void initialize_completion_queue_cache(void) {
+    init_object_cache(&completion_queue_cache, object_type_completion_queue);
+}
+
+/**
+ * Constructor for completion queue object
+ *
+ * The completion queue can only be used by threads of the process passed as
+ * argument since the replies posted to it are written to that process' address
+ * space when they are collected. No reference is taken on the process: the
+ * pointer is only compared with the current process.
+ *
+ * @param process process that uses the completion queue
+ * @return completion queue on success, NULL on allocation failure
+ */
+completion_queue_t *completion_queue_new(process_t *process) {
+    completion_queue_t *queue = slab_cache_alloc(&completion_queue_cache);
+
+    if(queue != NULL) {
+        object_reset_header(&queue->header);
+        queue->outstanding  = 0;
+        queue->next_id      = 0;
+        queue->process      = process;
+    }
+
+    return queue;
+}
+
+/**
+ * Destroy a completion queue
+ *
+ * This function is defined as the "destroy" op in the runtime type definition.
+ *
+ * Threads waiting on the completion queue fail with JINUE_EIO and completed
+ * requests that were not collected are discarded. Requests that are still
+ * outstanding keep a reference on the completion queue and are discarded when
+ * they complete.
+ *
+ * @param object the completion queue object
+ */
+static void destroy_op(object_header_t *object) {
+    completion_queue_t *queue = (completion_queue_t *)object;
+
+    spin_lock(&queue->lock);
+
+    while(true) {
+        thread_t *waiter = list_dequeue(&queue->wait_list, thread_t, thread_list);
+
+        if(waiter == NULL) {
+            break;
+        }
+
+        abort_message(waiter);
+    }
+
+    spin_unlock(&queue->lock);
+
+    while(true) {
+        spin_lock(&queue->lock);
+        ipc_request_t *request = list_dequeue(&queue->completed, ipc_request_t, request_list);
+        spin_unlock(&queue->lock);
+
+        if(request == NULL) {
+            break;
+        }
+
+        discard_request(request);
+    }
+}
+
+/**
+ * Free a completion queue
+ *
+ * This function is defined as the "free" op in the runtime type definition,
+ * called automatically when the completion queue's reference count falls to
+ * zero.
+ *
+ * @param object the completion queue object
+ */
+static void free_op(object_header_t *object) {
+    slab_cache_free(object);
+}
@@ -30,8 +30,12 @@
  */
 
 #include <jinue/shared/asm/errno.h>
+#include <kernel/domain/entities/channel.h>
+#include <kernel/domain/entities/completion_queue.h>
 #include <kernel/domain/entities/descriptor.h>
 #include <kernel/domain/entities/endpoint.h>
+#include <kernel/domain/entities/endpoint_set.h>
+#include <kernel/domain/entities/notification.h>
 #include <kernel/domain/entities/object.h>
 #include <kernel/domain/entities/process.h>
 #include <kernel/domain/entities/thread.h>
@@ -336,6 +340,132 @@ ipc_endpoint_t *descriptor_get_endpoint(descriptor_t *desc) {
     return (ipc_endpoint_t *)object;
 }
 
+/**
+ * Get IPC endpoint set referenced by descriptor
+ * 
+ * If the specified descriptor refers to an IPC endpoint set, a pointer to that
+ * endpoint set is returned. Otherwise, the function fails by returning NULL.
+ * 
+ * This function is typically called on a descriptor copy obtain by calling
+ * descriptor_access_object().
+ * 
+ * @param desc descriptor
+ * @return IPC endpoint set on success, NULL on failure
+ */
+ipc_endpoint_set_t *descriptor_get_endpoint_set(descriptor_t *desc) {
+    object_header_t *object = desc->object;
+
+    if(object->type != object_type_ipc_endpoint_set) {
+        return NULL;
+    }
+
+    return (ipc_endpoint_set_t *)object;
+}
+
+/**
+ * Get channel referenced by descriptor
+ * 
+ * If the specified descriptor refers to a channel, a pointer to that channel
+ * is returned. Otherwise, the function fails by returning NULL.
+ * 
+ * This function is typically called on a descriptor copy obtain by calling
+ * descriptor_access_object().
+ * 
+ * @param desc descriptor
+ * @return channel on success, NULL on failure
+ */
+channel_t *descriptor_get_channel(descriptor_t *desc) {
+    object_header_t *object = desc->object;
+
+    if(object->type != object_type_channel) {
+        return NULL;
+    }
+
+    return (channel_t *)object;
+}
+
+/**
+ * Get completion queue referenced by descriptor
+ * 
+ * If the specified descriptor refers to a completion queue, a pointer to that
+ * completion queue is returned. Otherwise, the function fails by returning
+ * NULL.
+ * 
+ * This function is typically called on a descriptor copy obtain by calling
+ * descriptor_access_object().
+ * 
+ * @param desc descriptor
+ * @return completion queue on success, NULL on failure
+ */
+completion_queue_t *descriptor_get_completion_queue(descriptor_t *desc) {
+    object_header_t *object = desc->object;
+
+    if(object->type != object_type_completion_queue) {
+        return NULL;
+    }
+
+    return (completion_queue_t *)object;
+}
+
+/**
+ * Get notification referenced by descriptor
+ * 
+ * If the specified descriptor refers to a notification, a pointer to that
+ * notification is returned. Otherwise, the function fails by returning NULL.
+ * 
+ * This function is typically called on a descriptor copy obtain by calling
+ * descriptor_access_object().
+ * 
+ * @param desc descriptor
+ * @return notification on success, NULL on failure
+ */
+notification_t *descriptor_get_notification(descriptor_t *desc) {
+    object_header_t *object = desc->object;
+
+    if(object->type != object_type_notification) {
+        return NULL;
+    }
+
+    return (notification_t *)object;
+}
+
+/**
+ * Get the IPC queues from which to receive messages through a descriptor
+ * 
+ * The descriptor must refer either to an IPC endpoint set or to an IPC
+ * endpoint that is not a member of an endpoint set. The caller is responsible
+ * for checking the descriptor's permissions.
+ * 
+ * This function is typically called on a descriptor copy obtain by calling
+ * descriptor_access_object().
+ * 
+ * @param pqueue pointer to where to store the queues (out)
+ * @param desc descriptor
+ * @return zero on success, negated error number on error
+ */
+int descriptor_get_receive_queue(ipc_queue_t **pqueue, descriptor_t *desc) {
+    ipc_endpoint_set_t *set = descriptor_get_endpoint_set(desc);
+
+    if(set != NULL) {
+        *pqueue = &set->queue;
+        return 0;
+    }
+
+    ipc_endpoint_t *endpoint = descriptor_get_endpoint(desc);
+
+    if(endpoint == NULL) {
+        return -JINUE_EBADF;
+    }
+
+    /* messages sent to a member endpoint are received from the set */
+    if(endpoint_is_in_set(endpoint)) {
+        return -JINUE_EBUSY;
+    }
+
+    *pqueue = &endpoint->queue;
+    return 0;
+}
+
 /**
  * Get process referenced by descriptor
  * 
@@ -30,10 +30,12 @@
  */
 
 #include <jinue/shared/asm/errno.h>
+#include <jinue/shared/asm/ipc.h>
 #include <jinue/shared/asm/permissions.h>
 #include <kernel/domain/alloc/slab.h>
 #include <kernel/domain/entities/descriptor.h>
 #include <kernel/domain/entities/endpoint.h>
+#include <kernel/domain/entities/endpoint_set.h>
 #include <kernel/domain/entities/object.h>
 #include <kernel/domain/services/ipc.h>
 #include <kernel/machine/atomic.h>
@@ -81,10 +83,15 @@ static void cache_ctor_op(void *buffer, size_t size) {
     ipc_endpoint_t *endpoint = buffer;
     
     object_init_header(&endpoint->header, object_type_ipc_endpoint);
-    init_list(&endpoint->send_list);
-    init_list(&endpoint->recv_list);
-    init_spinlock(&endpoint->lock);
-    endpoint->receivers_count = 0;
+    init_list(&endpoint->queue.send_list);
+    init_list(&endpoint->queue.recv_list);
+    init_list(&endpoint->queue.async_list);
+    init_spinlock(&endpoint->queue.lock);
+    endpoint->queue.notification = NULL;
+    endpoint->queue.is_lifo     = false;
+    endpoint->receivers_count   = 0;
+    endpoint->set               = NULL;
+    endpoint->set_member_fd     = -1;
 }
 
 /**
@@ -153,13 +160,15 @@ void initialize_endpoint_cache(void) {
 /**
  * Constructor for IPC endpoint object
  *
+ * @param flags endpoint creation flags (JINUE_ENDPOINT_...)
  * @return endpoint on success, NULL on allocation failure
  */
-ipc_endpoint_t *endpoint_new(void) {
+ipc_endpoint_t *endpoint_new(int flags) {
     ipc_endpoint_t *endpoint = slab_cache_alloc(&ipc_endpoint_cache);
 
     if(endpoint != NULL) {
         object_reset_header(&endpoint->header);
+        endpoint->queue.is_lifo = !!(flags & JINUE_ENDPOINT_LIFO);
     }
 
     return endpoint;
@@ -175,8 +184,14 @@ ipc_endpoint_t *endpoint_new(void) {
 static void destroy_op(object_header_t *object) {
     ipc_endpoint_t *endpoint = (ipc_endpoint_t *)object;
 
+    unbind_notification(&endpoint->queue);
+
+    if(endpoint->set != NULL) {
+        endpoint_set_abort_senders(endpoint->set, endpoint);
+    }
+
     while(true) {
-        thread_t *sender = list_dequeue(&endpoint->send_list, thread_t, thread_list);
+        thread_t *sender = list_dequeue(&endpoint->queue.send_list, thread_t, thread_list);
         
         if(sender == NULL) {
             break;
@@ -186,7 +201,17 @@ static void destroy_op(object_header_t *object) {
     }
 
     while(true) {
-        thread_t *receiver = list_dequeue(&endpoint->recv_list, thread_t, thread_list);
+        ipc_request_t *request = list_dequeue(&endpoint->queue.async_list, ipc_request_t, request_list);
+
+        if(request == NULL) {
+            break;
+        }
+
+        abort_request(request);
+    }
+
+    while(true) {
+        thread_t *receiver = list_dequeue(&endpoint->queue.recv_list, thread_t, thread_list);
         
         if(receiver == NULL) {
             break;
@@ -205,5 +230,14 @@ static void destroy_op(object_header_t *object) {
  * @param object the endpoint object
  */
 static void free_op(object_header_t *object) {
+    ipc_endpoint_t *endpoint = (ipc_endpoint_t *)object;
+
+    /* release the reference taken by endpoint_set_add() */
+    if(endpoint->set != NULL) {
+        object_sub_ref(endpoint_set_object(endpoint->set));
+        endpoint->set           = NULL;
+        endpoint->set_member_fd = -1;
+    }
+
     slab_cache_free(object);
 }
@@ -0,0 +1,320 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jinue/shared/asm/errno.h>
+#include <jinue/shared/asm/permissions.h>
+#include <kernel/domain/alloc/slab.h>
+#include <kernel/domain/entities/descriptor.h>
+#include <kernel/domain/entities/endpoint_set.h>
+#include <kernel/domain/entities/object.h>
+#include <kernel/domain/services/ipc.h>
+#include <kernel/machine/atomic.h>
+#include <kernel/machine/spinlock.h>
+#include <kernel/utils/list.h>
+#include <stddef.h>
+
+static void cache_ctor_op(void *buffer, size_t size);
+
+static void open_op(object_header_t *object, const descriptor_t *desc);
+
+static void close_op(object_header_t *object, const descriptor_t *desc);
+
+static void destroy_op(object_header_t *object);
+
+static void free_op(object_header_t *object);
+
+static const object_type_t object_type = {
+    .all_permissions    = JINUE_PERM_RECEIVE,
+    .name               = "ipc_endpoint_set",
+    .size               = sizeof(ipc_endpoint_set_t),
+    .open               = open_op,
+    .close              = close_op,
+    .destroy            = destroy_op,
+    .free               = free_op,
+    .cache_ctor         = cache_ctor_op,
+    .cache_dtor         = NULL
+};
+
+/** runtime type definition for an IPC endpoint set */
+const object_type_t *object_type_ipc_endpoint_set = &object_type;
+
+/** slab cache used for allocating IPC endpoint set objects */
+static slab_cache_t ipc_endpoint_set_cache;
+
+/**
+ * Object constructor for IPC endpoint set slab allocator
+ *
+ * @param buffer IPC endpoint set object being constructed
+ * @param size size in bytes of the IPC endpoint set object (ignored)
+ */
+static void cache_ctor_op(void *buffer, size_t size) {
+    ipc_endpoint_set_t *set = buffer;
+
+    object_init_header(&set->header, object_type_ipc_endpoint_set);
+    init_list(&set->queue.send_list);
+    init_list(&set->queue.recv_list);
+    init_list(&set->queue.async_list);
+    init_spinlock(&set->queue.lock);
+    set->queue.notification = NULL;
+    set->queue.is_lifo = false;
+    set->receivers_count = 0;
+}
+
+/**
+ * Open an IPC endpoint set
+ *
+ * This function is defined as the "open" op in the runtime type definition,
+ * called when a new descriptor references the endpoint set.
+ *
+ * @param object the endpoint set object
+ * @param desc the new descriptor
+ */
+static void open_op(object_header_t *object, const descriptor_t *desc) {
+    if(descriptor_has_permissions(desc, JINUE_PERM_RECEIVE)) {
+        ipc_endpoint_set_t *set = (ipc_endpoint_set_t *)object;
+        add_atomic(&set->receivers_count, 1);
+    }
+}
+
+/**
+ * Close an IPC endpoint set
+ *
+ * This function is defined as the "close" op in the runtime type definition,
+ * called when a a descriptor that references the endpoint set is closed and
+ * stops referencing it.
+ *
+ * The endpoint set is destroyed when the last descriptor that can be used to
+ * receive on it is closed. Its member endpoints then go back to being regular
+ * endpoints.
+ *
+ * @param object the endpoint set object
+ * @param desc the descriptor being closed
+ */
+static void close_op(object_header_t *object, const descriptor_t *desc) {
+    if(descriptor_has_permissions(desc, JINUE_PERM_RECEIVE)) {
+        ipc_endpoint_set_t *set = (ipc_endpoint_set_t *)object;
+        int receivers = add_atomic(&set->receivers_count, -1);
+
+        if(receivers < 1) {
+            object_destroy(object);
+        }
+    }
+}
+
+/**
+ * Initialize the IPC endpoint set slab cache
+ */
+void initialize_endpoint_set_cache(void) {
+    init_object_cache(&ipc_endpoint_set_cache, object_type_ipc_endpoint_set);
+}
+
+/**
+ * Constructor for IPC endpoint set object
+ *
+ * @return endpoint set on success, NULL on allocation failure
+ */
+ipc_endpoint_set_t *endpoint_set_new(void) {
+    ipc_endpoint_set_t *set = slab_cache_alloc(&ipc_endpoint_set_cache);
+
+    if(set != NULL) {
+        object_reset_header(&set->header);
+    }
+
+    return set;
+}
+
+/**
+ * Add an IPC endpoint to an endpoint set
+ *
+ * Once an endpoint is a member of a set, messages sent to it are received by
+ * receiving from the set and it can no longer be received from directly.
+ * Senders that are already waiting on the endpoint are moved to the set. An
+ * endpoint can be a member of a single set and it remains a member until
+ * either it or the set is destroyed.
+ *
+ * Lock order is endpoint, then endpoint set.
+ *
+ * @param set the endpoint set
+ * @param endpoint the endpoint to add
+ * @param member_fd descriptor reported to receivers for messages sent to the endpoint
+ * @return zero on success, negated error number on error
+ */
+int endpoint_set_add(ipc_endpoint_set_t *set, ipc_endpoint_t *endpoint, int member_fd) {
+    spin_lock(&endpoint->queue.lock);
+
+    /* A thread blocked receiving directly on the endpoint would never see
+     * messages that are now queued on the set. Likewise, receivers on the set
+     * would never see a notification bound to the endpoint. */
+    if(
+            endpoint->set != NULL ||
+            endpoint->queue.notification != NULL ||
+            !list_is_empty(&endpoint->queue.recv_list)) {
+        spin_unlock(&endpoint->queue.lock);
+        return -JINUE_EBUSY;
+    }
+
+    spin_lock(&set->queue.lock);
+
+    while(true) {
+        thread_t *sender = list_dequeue(&endpoint->queue.send_list, thread_t, thread_list);
+
+        if(sender == NULL) {
+            break;
+        }
+
+        enqueue_sender(&set->queue, sender);
+    }
+
+    while(true) {
+        list_node_t *node = list_dequeue_node(&endpoint->queue.async_list);
+
+        if(node == NULL) {
+            break;
+        }
+
+        list_enqueue(&set->queue.async_list, node);
+    }
+
+    /* released by the endpoint's "free" op */
+    object_add_ref(endpoint_set_object(set));
+
+    endpoint->set           = set;
+    endpoint->set_member_fd = member_fd;
+
+    spin_unlock(&set->queue.lock);
+    spin_unlock(&endpoint->queue.lock);
+
+    return 0;
+}
+
+/**
+ * Abort the messages queued on an endpoint set that were sent to an endpoint
+ *
+ * This function is called when a member endpoint is destroyed.
+ *
+ * @param set the endpoint set
+ * @param endpoint the endpoint being destroyed
+ */
+void endpoint_set_abort_senders(ipc_endpoint_set_t *set, ipc_endpoint_t *endpoint) {
+    spin_lock(&set->queue.lock);
+
+    list_cursor_t cur = list_head(&set->queue.send_list);
+
+    while(*cur != NULL) {
+        thread_t *sender = list_cursor_entry(cur, thread_t, thread_list);
+
+        if(sender->message_endpoint == endpoint) {
+            (void)list_remove(&set->queue.send_list, cur, thread_t, thread_list);
+            abort_message(sender);
+        }
+        else {
+            cur = list_cursor_next(cur);
+        }
+    }
+
+    cur = list_head(&set->queue.async_list);
+
+    while(*cur != NULL) {
+        ipc_request_t *request = list_cursor_entry(cur, ipc_request_t, request_list);
+
+        if(request->endpoint == endpoint) {
+            (void)list_remove(&set->queue.async_list, cur, ipc_request_t, request_list);
+            abort_request(request);
+        }
+        else {
+            cur = list_cursor_next(cur);
+        }
+    }
+
+    spin_unlock(&set->queue.lock);
+}
+
+/**
+ * Destroy an IPC endpoint set
+ *
+ * This function is defined as the "destroy" op in the runtime type definition.
+ *
+ * @param object the endpoint set object
+ */
+static void destroy_op(object_header_t *object) {
+    ipc_endpoint_set_t *set = (ipc_endpoint_set_t *)object;
+
+    /* Senders check whether the set is destroyed under this lock (see
+     * lock_send_queue()), so none can be queued after this. */
+    spin_lock(&set->queue.lock);
+
+    while(true) {
+        thread_t *sender = list_dequeue(&set->queue.send_list, thread_t, thread_list);
+
+        if(sender == NULL) {
+            break;
+        }
+
+        abort_message(sender);
+    }
+
+    while(true) {
+        ipc_request_t *request = list_dequeue(&set->queue.async_list, ipc_request_t, request_list);
+
+        if(request == NULL) {
+            break;
+        }
+
+        abort_request(request);
+    }
+
+    while(true) {
+        thread_t *receiver = list_dequeue(&set->queue.recv_list, thread_t, thread_list);
+
+        if(receiver == NULL) {
+            break;
+        }
+
+        abort_message(receiver);
+    }
+
+    spin_unlock(&set->queue.lock);
+
+    unbind_notification(&set->queue);
+}
+
+/**
+ * Free an IPC endpoint set
+ *
+ * This function is defined as the "free" op in the runtime type definition,
+ * called automatically when the endpoint set's reference count falls to zero,
+ * i.e. once it is no longer referenced by any descriptor or member endpoint.
+ *
+ * @param object the endpoint set object
+ */
+static void free_op(object_header_t *object) {
+    slab_cache_free(object);
+}
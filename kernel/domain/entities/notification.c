@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jinue/shared/asm/permissions.h>
+#include <kernel/domain/alloc/slab.h>
+#include <kernel/domain/entities/descriptor.h>
+#include <kernel/domain/entities/notification.h>
+#include <kernel/domain/entities/object.h>
+#include <kernel/domain/services/ipc.h>
+#include <kernel/machine/atomic.h>
+#include <kernel/machine/spinlock.h>
+#include <kernel/utils/list.h>
+#include <stddef.h>
+
+static void cache_ctor_op(void *buffer, size_t size);
+
+static void open_op(object_header_t *object, const descriptor_t *desc);
+
+static void close_op(object_header_t *object, const descriptor_t *desc);
+
+static void destroy_op(object_header_t *object);
+
+static void free_op(object_header_t *object);
+
+static const object_type_t object_type = {
+    .all_permissions    = JINUE_PERM_SEND | JINUE_PERM_RECEIVE,
+    .name               = "notification",
+    .size               = sizeof(notification_t),
+    .open               = open_op,
+    .close              = close_op,
+    .destroy            = destroy_op,
+    .free               = free_op,
+    .cache_ctor         = cache_ctor_op,
+    .cache_dtor         = NULL
+};
+
+/** runtime type definition for a notification */
+const object_type_t *object_type_notification = &object_type;
+
+/** slab cache used for allocating notification objects */
+static slab_cache_t notification_cache;
+
+/**
+ * Object constructor for notification slab allocator
+ *
+ * @param buffer notification object being constructed
+ * @param size size in bytes of the notification object (ignored)
+ */
+static void cache_ctor_op(void *buffer, size_t size) {
+    notification_t *notification = buffer;
+
+    object_init_header(&notification->header, object_type_notification);
+    init_spinlock(&notification->lock);
+    init_list(&notification->wait_list);
+    notification->bits             = 0;
+    notification->bound_queue      = NULL;
+    notification->receivers_count  = 0;
+}
+
+/**
+ * Open a notification
+ *
+ * This function is defined as the "open" op in the runtime type definition,
+ * called when a new descriptor references the notification.
+ *
+ * @param object the notification object
+ * @param desc the new descriptor
+ */
+static void open_op(object_header_t *object, const descriptor_t *desc) {
+    if(descriptor_has_permissions(desc, JINUE_PERM_RECEIVE)) {
+        notification_t *notification = (notification_t *)object;
+        add_atomic(&notification->receivers_count, 1);
+    }
+}
+
+/**
+ * Close a notification
+ *
+ * This function is defined as the "close" op in the runtime type definition,
+ * called when a a descriptor that references the notification is closed and
+ * stops referencing it.
+ *
+ * @param object the notification object
+ * @param desc the descriptor being closed
+ */
+static void close_op(object_header_t *object, const descriptor_t *desc) {
+    if(descriptor_has_permissions(desc, JINUE_PERM_RECEIVE)) {
+        notification_t *notification = (notification_t *)object;
+        int receivers = add_atomic(&notification->receivers_count, -1);
+
+        if(receivers < 1) {
+            object_destroy(object);
+        }
+    }
+}
+
+/**
+ * Initialize the notification slab cache
+ */
+void initialize_notification_cache(void) {
+    init_object_cache(&notification_cache, object_type_notification);
+}
+
+/**
+ * Constructor for notification object
+ *
+ * @return notification on success, NULL on allocation failure
+ */
+notification_t *notification_new(void) {
+    notification_t *notification = slab_cache_alloc(&notification_cache);
+
+    if(notification != NULL) {
+        object_reset_header(&notification->header);
+        notification->bits = 0;
+    }
+
+    return notification;
+}
+
+/**
+ * Destroy a notification
+ *
+ * This function is defined as the "destroy" op in the runtime type definition.
+ *
+ * Threads waiting on the notification fail with JINUE_EIO. If the notification
+ * is bound to an IPC endpoint or endpoint set, it remains bound until that
+ * endpoint or set is destroyed, but it can no longer be signalled.
+ *
+ * @param object the notification object
+ */
+static void destroy_op(object_header_t *object) {
+    notification_t *notification = (notification_t *)object;
+
+    spin_lock(&notification->lock);
+
+    while(true) {
+        thread_t *waiter = list_dequeue(&notification->wait_list, thread_t, thread_list);
+
+        if(waiter == NULL) {
+            break;
+        }
+
+        abort_message(waiter);
+    }
+
+    spin_unlock(&notification->lock);
+}
+
+/**
+ * Free a notification
+ *
+ * This function is defined as the "free" op in the runtime type definition,
+ * called automatically when the notification's reference count falls to zero.
+ *
+ * @param object the notification object
+ */
+static void free_op(object_header_t *object) {
+    slab_cache_free(object);
+}
@@ -187,7 +187,7 @@ static void free_op(object_header_t *object) {
 /**
  * Switch to specified process address space
  * 
- * @param process the process
+ * @param process the process, NULL for the initial address space
  */
 void process_switch_to(process_t *process) {
     machine_switch_to_process(process);
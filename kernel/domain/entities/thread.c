@@ -30,12 +30,15 @@
  */
 
 #include <jinue/shared/asm/errno.h>
+#include <jinue/shared/asm/thread.h>
 #include <kernel/domain/alloc/page_alloc.h>
 #include <kernel/domain/entities/object.h>
 #include <kernel/domain/entities/process.h>
 #include <kernel/domain/entities/thread.h>
 #include <kernel/domain/services/ipc.h>
 #include <kernel/domain/services/scheduler.h>
+#include <kernel/domain/services/timer.h>
+#include <kernel/machine/smp.h>
 #include <kernel/machine/spinlock.h>
 #include <kernel/machine/thread.h>
 #include <kernel/machine/tls.h>
@@ -43,7 +46,7 @@
 static void free_op(object_header_t *object);
 
 static const object_type_t object_type = {
-    .all_permissions    = JINUE_PERM_START | JINUE_PERM_AWAIT | JINUE_PERM_SIGNAL,
+    .all_permissions    = JINUE_PERM_START | JINUE_PERM_AWAIT | JINUE_PERM_SIGNAL | JINUE_PERM_SCHEDULE,
     .name               = "thread",
     .size               = sizeof(thread_t),
     .open               = NULL,
@@ -85,6 +88,9 @@ thread_t *thread_new(process_t *process) {
     thread->state               = THREAD_STATE_CREATED;
     thread->process             = process;
     thread->awaiter             = NULL;
+    thread->priority            = JINUE_PRIORITY_DEFAULT;
+    thread->cpu                 = machine_get_current_cpu();
+    thread->affinity            = ~(uint32_t)0;
     thread->local_storage_addr  = NULL;
     thread->local_storage_size  = 0;
  
@@ -123,8 +129,19 @@ static void free_op(object_header_t *object) {
  *
  */
 void thread_prepare(thread_t *thread, const thread_params_t *params) {
-    thread->sender      = NULL;
-    thread->cpu_credits = 0;
+    thread->sender              = NULL;
+    thread->servicer            = NULL;
+    thread->recv_queue          = NULL;
+    thread->recv_requests_only  = false;
+    thread->request             = NULL;
+    thread->message_state       = 0;
+    thread->sender_state        = 0;
+    thread->lent_size           = 0;
+    thread->send_descs_count    = 0;
+    thread->recv_descs_length   = 0;
+    thread->recv_descs_count    = 0;
+
+    initialize_timer(&thread->timeout_timer, NULL);
     
     spin_lock(&thread->await_lock);
     
@@ -218,10 +235,7 @@ void thread_terminate_current(void) {
 
     spin_unlock(&current->await_lock);
 
-    if(current->sender != NULL) {
-        abort_message(current->sender);
-        current->sender = NULL;
-    }
+    abort_current_message(current);
 
     switch_from_exiting_thread();
 }
@@ -274,3 +288,44 @@ void thread_set_local_storage(thread_t *thread, addr_t addr, size_t size) {
         machine_set_thread_local_storage(thread);
     }
 }
+
+/**
+ * Set the priority of a thread
+ *
+ * @param thread the thread
+ * @param priority new priority (JINUE_PRIORITY_MIN to JINUE_PRIORITY_MAX)
+ *
+ */
+void thread_set_priority(thread_t *thread, int priority) {
+    thread->priority = priority;
+}
+
+/**
+ * Get the effective priority of a thread
+ *
+ * A thread that is servicing a message inherits the priority of the sending
+ * thread until it replies, so a high priority client is not held up by a low
+ * priority server. Since the sending thread may itself be servicing a message,
+ * the priority is inherited transitively along the chain of senders. Likewise,
+ * a thread servicing an asynchronous request inherits the priority with which
+ * the request was sent.
+ *
+ * @param thread the thread
+ * @return effective priority
+ *
+ */
+int thread_get_priority(const thread_t *thread) {
+    int priority = thread->priority;
+
+    for(const thread_t *current = thread; current != NULL; current = current->sender) {
+        if(current->priority > priority) {
+            priority = current->priority;
+        }
+
+        if(current->request != NULL && current->request->priority > priority) {
+            priority = current->request->priority;
+        }
+    }
+
+    return priority;
+}
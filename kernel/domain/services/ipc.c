@@ -31,17 +31,202 @@
 
 #include <jinue/shared/asm/errno.h>
 #include <jinue/shared/asm/ipc.h>
+#include <jinue/shared/asm/mman.h>
 #include <jinue/shared/types.h>
+#include <kernel/domain/alloc/slab.h>
+#include <kernel/domain/entities/descriptor.h>
 #include <kernel/domain/entities/endpoint.h>
 #include <kernel/domain/entities/object.h>
+#include <kernel/domain/entities/thread.h>
 #include <kernel/domain/services/ipc.h>
+#include <kernel/domain/services/mman.h>
 #include <kernel/domain/services/scheduler.h>
+#include <kernel/domain/services/timer.h>
+#include <kernel/machine/atomic.h>
+#include <kernel/machine/pmap.h>
+#include <kernel/machine/smp.h>
 #include <kernel/machine/spinlock.h>
 #include <kernel/utils/pmap.h>
+#include <limits.h>
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <string.h>
 
+/** Kernel page through which the user memory of a peer thread is accessed
+ *
+ * When a message or reply is copied directly to the receive buffers of a thread
+ * in another address space, the page frames that back these buffers are mapped
+ * here, one page at a time. */
+typedef struct {
+    /** address of the page */
+    addr_t   addr;
+    /** physical address of the page frame currently mapped */
+    paddr_t  paddr;
+    /** whether a page frame is currently mapped */
+    bool     is_mapped;
+} peer_window_t;
+
+/** Peer windows, one per CPU
+ *
+ * A window is only ever mapped and accessed by the CPU that owns it, so
+ * invalidating the TLB entry of the current CPU is enough when it is remapped
+ * and no lock is needed. */
+static peer_window_t peer_windows[MAX_CPUS];
+
+/* A thread blocked on an IPC operation can be woken up by different threads at
+ * the same time, e.g. by a receiving thread replying to its message while its
+ * timeout expires on another CPU. Whichever completes the operation must first
+ * claim it by changing the message_state member of the blocked thread from
+ * MESSAGE_WAITING to MESSAGE_CLAIMED with compare-and-swap, so only one does.
+ *
+ * The bits above the state are a sequence number that is incremented each
+ * time the thread starts waiting (see prepare_message_wait()). A receiving
+ * thread that services a message remembers the value for the sending thread's
+ * operation (see the sender_state member), so it cannot claim a later
+ * operation by mistake once that one timed out. */
+
+/** the operation is waiting to be completed */
+#define MESSAGE_WAITING             0
+
+/** the operation is being or has been completed by the thread that claimed it */
+#define MESSAGE_CLAIMED             1
+
+/** the operation timed out while claimed, see release_message() */
+#define MESSAGE_EXPIRED             2
+
+/** mask for the state in the message_state member */
+#define MESSAGE_STATE_MASK          3
+
+/** sequence number increment in the message_state member */
+#define MESSAGE_SEQUENCE_INCREMENT  4
+
+/** number of receiving threads looked at on a LIFO queue to find one that last
+ * ran on the sender's CPU, see dequeue_sync_receiver() */
+#define LIFO_CPU_SEARCH_DEPTH       4
+
+/** slab cache used for allocating asynchronous requests */
+static slab_cache_t ipc_request_cache;
+
+/**
+ * Initialize the IPC service
+ *
+ * This function reserves the kernel pages used by each CPU to access the
+ * receive buffers of a peer thread (see transfer_message()) and initializes
+ * the slab cache for asynchronous requests. It must be called during kernel
+ * initialization, after machine_init().
+ *
+ */
+void initialize_ipc(void) {
+    addr_t addr = reserve_in_kernel(MAX_CPUS * PAGE_SIZE);
+
+    for(int cpu = 0; cpu < MAX_CPUS; ++cpu) {
+        peer_windows[cpu].addr      = addr + cpu * PAGE_SIZE;
+        peer_windows[cpu].is_mapped = false;
+    }
+
+    slab_cache_init(
+        &ipc_request_cache,
+        "ipc_request",
+        sizeof(ipc_request_t),
+        0,
+        NULL,
+        NULL,
+        SLAB_DEFAULTS
+    );
+}
+
+/**
+ * Map the page of a peer thread's user memory that contains an address
+ *
+ * The page is mapped in the peer window of the current CPU. The mapping
+ * remains valid until the next call to this function on the same CPU.
+ *
+ * @param peer peer thread
+ * @param addr user space address in the peer thread's address space
+ * @param prot required access, JINUE_PROT_READ and/or JINUE_PROT_WRITE
+ * @return kernel address at which addr is accessible, NULL on error
+ *
+ */
+static void *map_peer_address(thread_t *peer, const void *addr, int prot) {
+    paddr_t paddr;
+
+    if(! machine_lookup_userspace_paddr(peer->process, addr, prot, &paddr)) {
+        return NULL;
+    }
+
+    peer_window_t *window = &peer_windows[machine_get_current_cpu()];
+
+    /* Consecutive accesses usually fall in the same page, in which case the
+     * existing mapping can be reused. */
+    if(!window->is_mapped || paddr != window->paddr) {
+        machine_map_kernel(
+            window->addr,
+            PAGE_SIZE,
+            paddr,
+            JINUE_PROT_READ | JINUE_PROT_WRITE,
+            JINUE_MAP_NONE
+        );
+
+        window->paddr       = paddr;
+        window->is_mapped   = true;
+    }
+
+    return window->addr + page_offset_of(addr);
+}
+
+/**
+ * Copy data between the current address space and a peer thread's address space
+ *
+ * @param peer peer thread
+ * @param peer_addr user space address in the peer thread's address space
+ * @param local address in the current address space
+ * @param size size of the data to copy, in bytes
+ * @param to_peer true to write to the peer, false to read from the peer
+ * @return true on success, false if peer memory is not accessible
+ *
+ */
+static bool copy_peer(
+        thread_t    *peer,
+        char        *peer_addr,
+        char        *local,
+        size_t       size,
+        bool         to_peer) {
+
+    if(! check_userspace_buffer(peer_addr, size)) {
+        return false;
+    }
+
+    const int prot = to_peer ? JINUE_PROT_WRITE : JINUE_PROT_READ;
+
+    while(size > 0) {
+        char *mapped = map_peer_address(peer, peer_addr, prot);
+
+        if(mapped == NULL) {
+            return false;
+        }
+
+        size_t chunk = PAGE_SIZE - page_offset_of(peer_addr);
+
+        if(chunk > size) {
+            chunk = size;
+        }
+
+        if(to_peer) {
+            memcpy(mapped, local, chunk);
+        }
+        else {
+            memcpy(local, mapped, chunk);
+        }
+
+        peer_addr   += chunk;
+        local       += chunk;
+        size        -= chunk;
+    }
+
+    return true;
+}
+
 /**
  * Check receive buffers and count receive buffer size
  *
@@ -64,17 +249,17 @@ static int get_receive_buffers_size(const jinue_message_t *message) {
         }
 
         /* This is not the final check, which will happen in scatter_message()
-         * while it is actually writing the message to the user space buffers.
-         * We still want to make the check here though: on the sender side, we
-         * don't want to send the message to the receiving thread, have it
-         * process the message, and then realize we can't store the reply and,
-         * on the receiver side, we don't want to find out after we dequeued a
-         * sending thread.
+         * or transfer_message() while the message is actually being written to
+         * the user space buffers. We still want to make the check here though:
+         * on the sender side, we don't want to send the message to the
+         * receiving thread, have it process the message, and then realize we
+         * can't store the reply and, on the receiver side, we don't want to
+         * find out after we dequeued a sending thread.
          *
-         * If things change in user space between here and when scatter_message()
-         * does the write, it's fine. scatter_message() does the checks it needs
-         * to protect the kernel and the application gets undefined behaviour,
-         * which is fine in this context. */
+         * If things change in user space between here and when the write
+         * happens, it's fine. The write does the checks it needs to protect
+         * the kernel and the application gets undefined behaviour, which is
+         * fine in this context. */
         if(! check_userspace_buffer(recv_buffer->addr, recv_buffer->size)) {
             return -JINUE_EINVAL;
         }
@@ -92,15 +277,50 @@ static int get_receive_buffers_size(const jinue_message_t *message) {
 }
 
 /**
- * Copy message or reply from user space buffer(s) to thread message buffer
+ * Check send buffers and count message size
+ *
+ * @param message structure describing the send buffers
+ * @return total message size on success, negated error number on error
+ *
+ */
+static int get_send_buffers_size(const jinue_message_t *message) {
+    size_t message_size = 0;
+
+    if(message->send_buffers_length > JINUE_MAX_BUFFERS_IN_ARRAY) {
+        return -JINUE_EINVAL;
+    }
+
+    for(int idx = 0; idx < message->send_buffers_length; ++idx) {
+        const jinue_const_buffer_t *send_buffer = &message->send_buffers[idx];
+
+        if(! check_userspace_buffer(send_buffer->addr, send_buffer->size)) {
+            return -JINUE_EINVAL;
+        }
+
+        if(send_buffer->size > JINUE_MAX_MESSAGE_SIZE - message_size) {
+            return -JINUE_EINVAL;
+        }
+
+        message_size += send_buffer->size;
+    }
+
+    return message_size;
+}
+
+/**
+ * Copy message or reply from user space buffer(s) to a kernel message buffer
  *
- * @param thread thread sending the message or reply
+ * This is only used when the message cannot be copied directly to the
+ * receiving thread because no receiving thread is waiting for it yet (see
+ * transfer_message()), and for asynchronous requests and their replies.
+ *
+ * @param buffer message buffer of JINUE_MAX_MESSAGE_SIZE bytes (output)
  * @param message structure describing the message
- * @return zero on success, negated error number on error
+ * @return message size in bytes on success, negated error number on error
  *
  */
-static int gather_message(thread_t *thread, const jinue_message_t *message) {
-    thread->message_size = 0;
+static int gather_message(char *buffer, const jinue_message_t *message) {
+    size_t message_size = 0;
 
     if(message->send_buffers_length > JINUE_MAX_BUFFERS_IN_ARRAY) {
         return -JINUE_EINVAL;
@@ -119,36 +339,39 @@ static int gather_message(thread_t *thread, const jinue_message_t *message) {
             return -JINUE_EINVAL;
         }
 
-        size_t space_remaining = JINUE_MAX_MESSAGE_SIZE - thread->message_size;
+        size_t space_remaining = JINUE_MAX_MESSAGE_SIZE - message_size;
 
         if(send_buffer.size > space_remaining) {
             return -JINUE_EINVAL;
         }
 
-        char *write_ptr = &thread->message_buffer[thread->message_size];
-
-        memcpy(write_ptr, send_buffer.addr, send_buffer.size);
-        thread->message_size += send_buffer.size;
-
-        /* TODO copy descriptors */
+        memcpy(&buffer[message_size], send_buffer.addr, send_buffer.size);
+        message_size += send_buffer.size;
     }
 
-    return 0;
+    return message_size;
 }
 
 /**
- * Write message or reply to user space buffer(s)
+ * Write message from a kernel message buffer to user space buffer(s)
  *
- * @param thread thread receiving the message or reply
- * @param message structure describing the receive buffers
+ * @param buffer message buffer that contains the message
+ * @param size message size, in bytes
+ * @param recv_buffers receive buffers array
+ * @param recv_buffers_length number of elements in the receive buffers array
  * @return zero on success, negated error number on error
  *
  */
-static int scatter_message(thread_t *thread, const jinue_message_t *message) {
+static int scatter_message(
+        const char              *buffer,
+        size_t                   size,
+        const jinue_buffer_t    *recv_buffers,
+        int                      recv_buffers_length) {
+
     size_t read_position = 0;
 
-    for(int idx = 0; idx < message->recv_buffers_length; ++idx) {
-        size_t remaining = thread->message_size - read_position;
+    for(int idx = 0; idx < recv_buffers_length; ++idx) {
+        size_t remaining = size - read_position;
 
         if(remaining == 0) {
             break;
@@ -158,8 +381,8 @@ static int scatter_message(thread_t *thread, const jinue_message_t *message) {
          * sure to copy the data before we check and use it to prevent it from
          * being changed by user space between steps. */
         jinue_buffer_t recv_buffer;
-        recv_buffer.addr = message->recv_buffers[idx].addr;
-        recv_buffer.size = message->recv_buffers[idx].size;
+        recv_buffer.addr = recv_buffers[idx].addr;
+        recv_buffer.size = recv_buffers[idx].size;
 
         /* We already checked this at the start of the system call but we need
          * to check it again because another application thread might have
@@ -168,7 +391,7 @@ static int scatter_message(thread_t *thread, const jinue_message_t *message) {
             return -JINUE_EINVAL;
         }
 
-        char *read_ptr = &thread->message_buffer[read_position];
+        const char *read_ptr = &buffer[read_position];
 
         size_t write_size = recv_buffer.size;
 
@@ -178,258 +401,2653 @@ static int scatter_message(thread_t *thread, const jinue_message_t *message) {
 
         memcpy(recv_buffer.addr, read_ptr, write_size);
         read_position += write_size;
-
-        /* TODO copy descriptors */
     }
 
     return 0;
 }
 
 /**
- * Send a message to an IPC endpoint.
+ * Write a message from the thread message buffer to a short message
  *
- * This function sends a message to an IPC endpoint so it can be received by
- * another thread, possibly in another process.
+ * The data words past the end of the message are set to zero.
  *
- * If a receiving thread is blocked on the IPC endpoint waiting for a message,
- * then the message is processed immediately. Otherwise, the sending thread
- * blocks until a receiving thread receives the message. Threads blocked waiting
- * for a receiving thread are enqueued to a sender queue and processed in order.
+ * @param data short message data words (output)
+ * @param buffer message buffer that contains the message
+ * @param size message size, in bytes
  *
- * The send buffers pointed to by the message structure passed as argument
- * contain the message to be sent. The receive buffers will be used to store the
- * reply from the receiving thread.
+ */
+static void copy_short_message_data(uintptr_t *data, const char *buffer, size_t size) {
+    memset(data, 0, JINUE_SHORT_MESSAGE_SIZE);
+    memcpy(data, buffer, size);
+}
+
+/** Write position in the receive buffers of a blocked peer thread */
+typedef struct {
+    thread_t        *peer;
+    jinue_buffer_t   recv_buffer;
+    int              recv_index;
+    size_t           written;
+    bool             peer_fault;
+} recv_cursor_t;
+
+/**
+ * Initialize the write position at the start of a peer's receive buffers
  *
- * @param endpoint IPC endpoint to which the message is sent
- * @param sender thread sending the message
- * @param function function number of the message
- * @param cookie cookie value sent with the message
- * @param message structure describing the message
- * @return message size in bytes on success, negated error number on error
+ * @param cursor write position (output)
+ * @param peer thread receiving the message or reply
  *
  */
-int send_message(
-        uintptr_t               *errcode,
-        ipc_endpoint_t          *endpoint,
-        thread_t                *sender,
-        int                      function,
-        uintptr_t                cookie,
-        const jinue_message_t   *message) {
+static void init_recv_cursor(recv_cursor_t *cursor, thread_t *peer) {
+    cursor->peer                = peer;
+    cursor->recv_buffer.addr    = NULL;
+    cursor->recv_buffer.size    = 0;
+    cursor->recv_index          = 0;
+    cursor->written             = 0;
+    cursor->peer_fault          = false;
+}
 
-    int recv_buffer_size = get_receive_buffers_size(message);
+/**
+ * Write data to the receive buffers of a blocked peer thread
+ *
+ * If the peer thread receives a short message (i.e. its message member is
+ * NULL), the data is written to its message buffer. Otherwise, the data is
+ * written to its receive buffers, which are in the peer's address space and are
+ * accessed through a temporary kernel mapping.
+ *
+ * If the receive buffers are not accessible, the peer_fault member of the
+ * cursor is set so the caller can tell this error apart from an error in the
+ * data being written.
+ *
+ * @param cursor write position, updated by this function
+ * @param data data to write
+ * @param size size of the data, in bytes
+ * @return zero on success, negated error number on error
+ *
+ */
+static int write_to_peer(recv_cursor_t *cursor, const char *data, size_t size) {
+    thread_t *peer = cursor->peer;
 
-    if(recv_buffer_size < 0) {
-        return recv_buffer_size;
+    if(size > peer->recv_buffer_size - cursor->written) {
+        return -JINUE_E2BIG;
     }
-    
-    sender->recv_buffer_size        = recv_buffer_size;
-    sender->message_errno           = 0;
-    sender->message_reply_errcode   = 0;
-    sender->message_function        = function;
-    sender->message_cookie          = cookie;
 
-    int gather_result = gather_message(sender, message);
+    const jinue_message_t *peer_message = peer->message;
 
-    if(gather_result < 0) {
-        return gather_result;
+    if(peer_message == NULL) {
+        memcpy(&peer->message_buffer[cursor->written], data, size);
+        cursor->written += size;
+        return 0;
     }
 
-    spin_lock(&endpoint->lock);
-
-    thread_t *receiver = list_dequeue(&endpoint->recv_list, thread_t, thread_list);
+    jinue_buffer_t *recv_buffer = &cursor->recv_buffer;
+
+    while(size > 0) {
+        if(recv_buffer->size == 0) {
+            if(cursor->recv_index >= peer_message->recv_buffers_length) {
+                return -JINUE_E2BIG;
+            }
+
+            /* The receive buffers array is in the peer's address space. */
+            bool copied = copy_peer(
+                peer,
+                (char *)&peer_message->recv_buffers[cursor->recv_index],
+                (char *)recv_buffer,
+                sizeof(*recv_buffer),
+                false
+            );
+
+            if(! copied) {
+                cursor->peer_fault = true;
+                return -JINUE_EINVAL;
+            }
+
+            ++cursor->recv_index;
+            continue;
+        }
 
-    if(receiver == NULL) {
-        /* No thread is waiting to receive this message, so we must wait on the sender list. */
-        list_enqueue(&endpoint->send_list, &sender->thread_list);
-        block_current_thread_and_unlock(&endpoint->lock);
-    }
-    else {
-        spin_unlock(&endpoint->lock);
-        receiver->sender = sender;
+        size_t chunk = size;
 
-        /* switch to receiver thread, which will resume inside syscall_receive() */
-        switch_to_thread_and_block(receiver);
-    }
+        if(chunk > recv_buffer->size) {
+            chunk = recv_buffer->size;
+        }
 
-    if(sender->message_errno == JINUE_EPROTO) {
-        *errcode = sender->message_reply_errcode;
-        return -JINUE_EPROTO;
-    }
+        if(! copy_peer(peer, recv_buffer->addr, (char *)data, chunk, true)) {
+            cursor->peer_fault = true;
+            return -JINUE_EINVAL;
+        }
 
-    if(sender->message_errno != 0) {
-        return -sender->message_errno;
+        data                += chunk;
+        size                -= chunk;
+        recv_buffer->addr    = (char *)recv_buffer->addr + chunk;
+        recv_buffer->size   -= chunk;
+        cursor->written     += chunk;
     }
 
-    /* copy reply to user space buffer */
-    int scatter_result = scatter_message(sender, message);
+    return 0;
+}
 
-    if(scatter_result < 0) {
-        return scatter_result;
+/**
+ * Report to the caller of a transfer function whether the peer was at fault
+ *
+ * @param peer_fault where to report it, may be NULL
+ * @param cursor write position after the failed write
+ *
+ */
+static void set_peer_fault(bool *peer_fault, const recv_cursor_t *cursor) {
+    if(peer_fault != NULL) {
+        *peer_fault = cursor->peer_fault;
     }
-
-    return sender->message_size;
 }
 
 /**
- * Receive a message from an IPC endpoint
- *
- * This function receives a message that another thread, probably in another
- * process, sent to a specific IPC endpoint.
+ * Copy message or reply directly to the receive buffers of a blocked thread
  *
- * If a sending thread is blocked on the IPC endpoint waiting for a receiving
- * thread, then its message is processed immediately. Otherwise, the receiving
- * thread blocks until a sending thread attempts to send a message. Threads
- * blocked waiting to receive a message are enqueued to a receiving thread queue.
+ * The message is copied in a single pass from the send buffers, which are in
+ * the current address space, to the receive buffers of the peer thread (see
+ * write_to_peer()). The thread message buffer of the current thread is not
+ * used.
  *
- * The receive buffers pointed to by the message structure passed as argument
- * will be used to receive the message.
+ * The peer thread must be blocked, with its message and recv_buffer_size
+ * members describing its receive buffers.
  *
- * @param endpoint IPC endpoint from which to receive a message
- * @param receiver thread receiving the message
- * @param message structure describing the receive buffers
- * @return received message size in bytes on success, negated error number on error
+ * @param peer thread receiving the message or reply
+ * @param message structure describing the send buffers
+ * @param peer_fault set to true if the peer's receive buffers are not accessible, may be NULL
+ * @return message size in bytes on success, negated error number on error
  *
  */
-int receive_message(ipc_endpoint_t *endpoint, thread_t *receiver, jinue_message_t *message) {
-    int recv_buffer_size = get_receive_buffers_size(message);
+static int transfer_message(thread_t *peer, const jinue_message_t *message, bool *peer_fault) {
+    int message_size = get_send_buffers_size(message);
 
-    if(recv_buffer_size < 0) {
-        return recv_buffer_size;
+    if(message_size < 0) {
+        return message_size;
     }
 
-    receiver->message_errno = 0;
+    if(message_size > peer->recv_buffer_size) {
+        return -JINUE_E2BIG;
+    }
 
-    while(true) {
-        spin_lock(&endpoint->lock);
+    recv_cursor_t cursor;
+    init_recv_cursor(&cursor, peer);
 
-        thread_t *sender = list_dequeue(&endpoint->send_list, thread_t, thread_list);
-        
-        if(sender == NULL) {
-            /* No thread is waiting to send a message, so we must wait on the receive list. */
-            list_enqueue(&endpoint->recv_list, &receiver->thread_list);
-            block_current_thread_and_unlock(&endpoint->lock);
-            
-            /* set by sending thread */
-            sender = receiver->sender;
-        }
-        else {
-            spin_unlock(&endpoint->lock);
-            receiver->sender = sender;
-        }
+    for(int idx = 0; idx < message->send_buffers_length; ++idx) {
+        /* We are reading the buffer definition from user space so let's make
+         * sure to copy the data before we check and use it to prevent it
+         * from being changed by user space between steps. */
+        jinue_const_buffer_t send_buffer;
+        send_buffer.addr = message->send_buffers[idx].addr;
+        send_buffer.size = message->send_buffers[idx].size;
 
-        if(receiver->message_errno != 0) {
-            receiver->sender = NULL;
-            return -receiver->message_errno;
+        if(! check_userspace_buffer(send_buffer.addr, send_buffer.size)) {
+            return -JINUE_EINVAL;
         }
 
-        if(sender->message_size > recv_buffer_size) {
-            /* message is too big for the receive buffer */
-            sender->message_errno   = JINUE_E2BIG;
-            receiver->sender        = NULL;
-            
-            ready_thread(sender);
-            continue;
+        if(send_buffer.size > JINUE_MAX_MESSAGE_SIZE - cursor.written) {
+            return -JINUE_EINVAL;
         }
 
-        /* copy reply to user space buffer */
-        int scatter_result = scatter_message(sender, message);
+        int write_result = write_to_peer(&cursor, send_buffer.addr, send_buffer.size);
 
-        if(scatter_result < 0) {
-            receiver->sender = NULL;
-            return scatter_result;
+        if(write_result < 0) {
+            set_peer_fault(peer_fault, &cursor);
+            return write_result;
         }
-        
-        message->recv_function  = sender->message_function;
-        message->recv_cookie    = sender->message_cookie;
-        message->reply_max_size = sender->recv_buffer_size;
-
-        return sender->message_size;
     }
+
+    return cursor.written;
 }
 
 /**
- * Reply to a message
+ * Copy message or reply from kernel memory to the receive buffers of a blocked thread
  *
- * This function is called by a receiving thread to end processing of the
- * current message and send the reply to the sending thread.
- *
- * The send buffers pointed to by the message structure passed as argument
- * contain the reply.
+ * This function is used for short messages, whose data is passed in registers,
+ * and for asynchronous requests, whose data was copied to the request when it
+ * was sent. In both cases, the data does not need to be read from user space.
  *
- * @param replier thread replying to the message
- * @param message structure describing the reply message
- * @return zero on success, negated error number on error
+ * @param peer thread receiving the message or reply
+ * @param data message data
+ * @param size message size, in bytes
+ * @param peer_fault set to true if the peer's receive buffers are not accessible, may be NULL
+ * @return message size in bytes on success, negated error number on error
  *
  */
-int reply_to_message(thread_t *replier, const jinue_message_t *message) {
-    thread_t *replyto = replier->sender;
-
-    if(replyto == NULL) {
-        return -JINUE_ENOMSG;
-    }
+static int transfer_short_message(thread_t *peer, const void *data, size_t size, bool *peer_fault) {
+    recv_cursor_t cursor;
+    init_recv_cursor(&cursor, peer);
 
-    int gather_result = gather_message(replyto, message);
+    int write_result = write_to_peer(&cursor, data, size);
 
-    if(gather_result < 0) {
-        return gather_result;
+    if(write_result < 0) {
+        set_peer_fault(peer_fault, &cursor);
+        return write_result;
     }
 
-    /* the reply must fit in the sender's receive buffer */
-    if(replyto->message_size > replyto->recv_buffer_size) {
-        return -JINUE_E2BIG;
-    }
+    return size;
+}
 
-    replier->sender = NULL;
-    
-    /* switch back to sender thread to return from call immediately */
-    switch_to_thread(replyto);
+/**
+ * Release the references on descriptors that were not transferred
+ *
+ * @param thread sending thread
+ *
+ */
+static void drop_descriptors(thread_t *thread) {
+    for(int idx = 0; idx < thread->send_descs_count; ++idx) {
+        descriptor_unreference_object(&thread->send_descs[idx]);
+    }
 
-    return 0;
+    thread->send_descs_count = 0;
 }
 
 /**
- * Reply to a message with an error
+ * Take references on the descriptors sent with a message or reply
  *
- * This function is called by a receiving thread to end processing of the
- * current message and send an error code to the sending thread.
+ * This function must be called in the context of the sending thread since the
+ * descriptors are looked up in its process. The permissions of each descriptor
+ * are masked with the permissions specified by the sender, so a descriptor can
+ * only be transferred with the same or fewer permissions. The transferred
+ * descriptor keeps the cookie of the original but is never an owner
+ * descriptor.
  *
- * @param replier thread replying to the message
- * @param errcode error code
+ * The references must be released with drop_descriptors() once the message
+ * has been received or has failed to be sent. install_descriptors() does this
+ * for descriptors it installs.
+ *
+ * @param thread sending thread
+ * @param message structure describing the message
  * @return zero on success, negated error number on error
  *
  */
-int reply_error_to_message(thread_t *replier, uintptr_t errcode) {
-    thread_t *replyto = replier->sender;
+static int gather_descriptors(thread_t *thread, const jinue_message_t *message) {
+    thread->send_descs_count = 0;
 
-    if(replyto == NULL) {
-        return -JINUE_ENOMSG;
+    if(message->send_descs_length > JINUE_MAX_DESCS_IN_MESSAGE) {
+        return -JINUE_EINVAL;
     }
 
-    replyto->message_errno          = JINUE_EPROTO;
-    replyto->message_reply_errcode  = errcode;
-    replier->sender                 = NULL;
-    
-    /* switch back to sender thread to return from call immediately */
-    switch_to_thread(replyto);
+    for(int idx = 0; idx < message->send_descs_length; ++idx) {
+        /* We are reading the array from user space so let's make sure to copy
+         * each element before we use it. */
+        jinue_send_desc_t send_desc = message->send_descs[idx];
+        descriptor_t *desc          = &thread->send_descs[idx];
+
+        int status = descriptor_access_object(desc, thread->process, send_desc.fd);
+
+        if(status < 0) {
+            drop_descriptors(thread);
+            return status;
+        }
+
+        /* This also clears the owner flag: ownership is never transferred. */
+        desc->flags &= send_desc.perms & desc->object->type->all_permissions;
+
+        ++thread->send_descs_count;
+    }
 
     return 0;
 }
 
 /**
- * Abort a send or receive operation in progress
+ * Free the reserved descriptors in which no descriptor was installed
  *
- * The send or receive operation fails with JINUE_EIO.
- * 
- * Situations that make calling this function necessary:
- *  - The thread is queued on an IPC endpoint's send or receive queue and the
- *    endpoint is being destroyed.
- *  - The sending thread is blocked being serviced by a receiver thread and the
- *    receiver thread exits without replying.
- * 
- * @param thread thread blocked on an IPC operation
+ * @param thread thread that reserved the descriptors
  *
  */
-void abort_message(thread_t *thread) {
-    thread->message_errno = JINUE_EIO;
-    ready_thread(thread);
+static void free_descriptor_slots(thread_t *thread) {
+    for(int idx = thread->recv_descs_count; idx < thread->recv_descs_length; ++idx) {
+        descriptor_free_reservation(thread->process, thread->recv_descs[idx]);
+    }
+
+    thread->recv_descs_length = 0;
+}
+
+/**
+ * Reserve the descriptors in which a thread accepts transferred descriptors
+ *
+ * This function must be called in the context of the thread that will receive
+ * the descriptors, i.e. the receiving thread for a message or the sending
+ * thread for the reply. Reserving the descriptors up front ensures installing
+ * the transferred descriptors cannot fail once the message has been copied.
+ *
+ * The reservations that end up not being used must be freed with
+ * free_descriptor_slots().
+ *
+ * @param thread thread that will receive descriptors
+ * @param message structure describing the receive descriptors, NULL for none
+ * @return zero on success, negated error number on error
+ *
+ */
+static int reserve_descriptor_slots(thread_t *thread, const jinue_message_t *message) {
+    thread->recv_descs_length   = 0;
+    thread->recv_descs_count    = 0;
+
+    if(message == NULL) {
+        return 0;
+    }
+
+    if(message->recv_descs_length > JINUE_MAX_DESCS_IN_MESSAGE) {
+        return -JINUE_EINVAL;
+    }
+
+    for(int idx = 0; idx < message->recv_descs_length; ++idx) {
+        int fd      = message->recv_descs[idx];
+        int status  = descriptor_reserve_unused(thread->process, fd);
+
+        if(status < 0) {
+            free_descriptor_slots(thread);
+            return status;
+        }
+
+        thread->recv_descs[idx] = fd;
+        ++thread->recv_descs_length;
+    }
+
+    return 0;
+}
+
+/**
+ * Check whether the descriptors sent by a thread fit in its peer's reserved descriptors
+ *
+ * @param peer thread receiving the descriptors
+ * @param thread thread sending the descriptors
+ * @return true if they fit, false otherwise
+ *
+ */
+static bool descriptors_fit(const thread_t *peer, const thread_t *thread) {
+    return thread->send_descs_count <= peer->recv_descs_length;
+}
+
+/**
+ * Install the descriptors sent by a thread in its peer's reserved descriptors
+ *
+ * The caller must have checked the descriptors fit with descriptors_fit().
+ *
+ * @param peer thread receiving the descriptors
+ * @param thread thread sending the descriptors
+ *
+ */
+static void install_descriptors(thread_t *peer, thread_t *thread) {
+    for(int idx = 0; idx < thread->send_descs_count; ++idx) {
+        descriptor_t *desc = &thread->send_descs[idx];
+
+        descriptor_open(peer->process, peer->recv_descs[idx], desc);
+        descriptor_unreference_object(desc);
+    }
+
+    peer->recv_descs_count      = thread->send_descs_count;
+    thread->send_descs_count    = 0;
+}
+
+/**
+ * Get the size of the pages lent by a sending thread with its message
+ *
+ * @param sender sending thread
+ * @return size in bytes, zero if the message is not in bulk mode
+ *
+ */
+static size_t get_bulk_size(const thread_t *sender) {
+    if(sender->message == NULL) {
+        return 0;
+    }
+
+    return sender->message->send_bulk.size;
+}
+
+/**
+ * Get the size of the window in which a receiving thread accepts lent pages
+ *
+ * @param receiver receiving thread
+ * @return size in bytes, zero if the receiver does not accept bulk messages
+ *
+ */
+static size_t get_bulk_window_size(const thread_t *receiver) {
+    if(receiver->message == NULL) {
+        return 0;
+    }
+
+    return receiver->message->bulk_window.size;
+}
+
+/**
+ * Add a sending thread to the send list of IPC queues
+ *
+ * The send list is ordered by priority, so the messages of higher priority
+ * threads are received first. Messages of threads with the same priority are
+ * received in the order in which they were sent.
+ *
+ * Must be called with the queue lock held.
+ *
+ * @param queue IPC queues
+ * @param sender sending thread
+ *
+ */
+void enqueue_sender(ipc_queue_t *queue, thread_t *sender) {
+    list_t *list    = &queue->send_list;
+    int priority    = thread_get_priority(sender);
+
+    /* Fast path for the common case where all senders have the same priority
+     * or the sender has the lowest. */
+    if(list_is_empty(list) ||
+            thread_get_priority(list_node_entry(list->tail, thread_t, thread_list)) >= priority) {
+        list_enqueue(list, &sender->thread_list);
+        return;
+    }
+
+    list_cursor_t cur = list_head(list);
+
+    while(thread_get_priority(list_cursor_entry(cur, thread_t, thread_list)) >= priority) {
+        cur = list_cursor_next(cur);
+    }
+
+    list_insert(list, cur, &sender->thread_list);
+}
+
+/**
+ * Abort a send or receive operation in progress with the specified error
+ *
+ * See abort_message().
+ *
+ * @param thread thread blocked on an IPC operation
+ * @param error error number with which the operation fails
+ *
+ */
+static void abort_message_with_error(thread_t *thread, int error) {
+    thread->message_errno = error;
+    ready_thread(thread);
+}
+
+/**
+ * Get the value of the message state of a thread while its operation waits
+ *
+ * @param thread thread blocked on an IPC operation
+ * @return message state with MESSAGE_WAITING
+ *
+ */
+static int get_waiting_state(const thread_t *thread) {
+    return thread->message_state & ~MESSAGE_STATE_MASK;
+}
+
+/**
+ * Claim a specific IPC operation of a blocked thread
+ *
+ * @param thread thread blocked on an IPC operation
+ * @param waiting message state of the operation while it waits
+ * @return true if the operation was claimed, false if it is already claimed or over
+ *
+ */
+static bool claim_message_state(thread_t *thread, int waiting) {
+    int state = compare_and_swap_atomic(
+        &thread->message_state,
+        waiting,
+        waiting | MESSAGE_CLAIMED
+    );
+
+    return state == waiting;
+}
+
+/**
+ * Claim the current IPC operation of a blocked thread
+ *
+ * The thread that claims the operation is the one that completes it and makes
+ * the blocked thread ready to run. Threads dequeued from a list of blocked
+ * threads are claimed with the lock of the list held, so the operation is the
+ * one for which the thread was queued.
+ *
+ * @param thread thread blocked on an IPC operation
+ * @return true if the operation was claimed, false if it is already claimed
+ *
+ */
+static bool claim_message(thread_t *thread) {
+    return claim_message_state(thread, get_waiting_state(thread));
+}
+
+/**
+ * Give up the claim on the IPC operation of a blocked thread
+ *
+ * This is done when the operation cannot be completed after all, e.g. when a
+ * receiving thread is put back on the receive list. If the operation timed out
+ * while it was claimed, the claim is kept and the caller must complete it with
+ * JINUE_ETIMEDOUT instead.
+ *
+ * @param thread thread blocked on an IPC operation
+ * @return true if the claim was given up, false if the operation timed out
+ *
+ */
+static bool release_message(thread_t *thread) {
+    int waiting = get_waiting_state(thread);
+    int state   = compare_and_swap_atomic(
+        &thread->message_state,
+        waiting | MESSAGE_CLAIMED,
+        waiting
+    );
+
+    return state == (waiting | MESSAGE_CLAIMED);
+}
+
+/**
+ * Prepare a thread to block waiting for an IPC operation to complete
+ *
+ * This clears the error number with which the operation completes and starts a
+ * new operation for the purpose of claim_message().
+ *
+ * @param thread thread about to block
+ *
+ */
+void prepare_message_wait(thread_t *thread) {
+    unsigned int sequence = (unsigned int)get_waiting_state(thread);
+
+    thread->message_errno = 0;
+    thread->message_state = (int)(sequence + MESSAGE_SEQUENCE_INCREMENT);
+}
+
+/**
+ * Dequeue the first thread of a list of blocked threads and claim it
+ *
+ * A thread whose operation is already claimed is being timed out (see
+ * ipc_timeout()), which completes once it is removed from the list, so it is
+ * skipped.
+ *
+ * Must be called with the lock of the list held.
+ *
+ * @param list list of blocked threads
+ * @return claimed thread, NULL if there is none
+ *
+ */
+static thread_t *dequeue_waiting_thread(list_t *list) {
+    while(true) {
+        thread_t *thread = list_dequeue(list, thread_t, thread_list);
+
+        if(thread == NULL || claim_message(thread)) {
+            return thread;
+        }
+    }
+}
+
+/**
+ * Put a claimed thread back at the head of a list of blocked threads
+ *
+ * If the thread's operation timed out since it was dequeued, it fails with
+ * JINUE_ETIMEDOUT instead.
+ *
+ * Must be called with the lock of the list held. The claim is given up before
+ * the thread is queued, but the timeout has to take the lock to remove it.
+ *
+ * @param list list of blocked threads
+ * @param thread claimed thread
+ *
+ */
+static void requeue_waiting_thread(list_t *list, thread_t *thread) {
+    if(release_message(thread)) {
+        list_push(list, &thread->thread_list);
+    }
+    else {
+        abort_message_with_error(thread, JINUE_ETIMEDOUT);
+    }
+}
+
+/**
+ * Claim the operation of the sending thread whose message a thread services
+ *
+ * If the sending thread timed out, the receiving thread no longer has a
+ * current message.
+ *
+ * @param receiver thread servicing the message
+ * @return sending thread, NULL if there is none or if it timed out
+ *
+ */
+static thread_t *claim_sender(thread_t *receiver) {
+    thread_t *sender = receiver->sender;
+
+    if(sender == NULL || ! claim_message_state(sender, receiver->sender_state)) {
+        /* The sending thread timed out, see timeout_send(). */
+        receiver->sender = NULL;
+        return NULL;
+    }
+
+    return sender;
+}
+
+/**
+ * Give up the claim on the sending thread whose message a thread services
+ *
+ * From then on, the sending thread can time out until the receiving thread
+ * claims it again to reply (see claim_sender()). If it timed out while it was
+ * claimed, it is made ready to run and the receiving thread no longer has a
+ * current message.
+ *
+ * @param receiver thread servicing the message, or that received it
+ *
+ */
+static void release_sender(thread_t *receiver) {
+    thread_t *sender = receiver->sender;
+
+    if(sender == NULL) {
+        return;
+    }
+
+    receiver->sender_state = get_waiting_state(sender);
+
+    if(! release_message(sender)) {
+        receiver->sender = NULL;
+        abort_message_with_error(sender, JINUE_ETIMEDOUT);
+    }
+}
+
+/**
+ * Dequeue the first receiving thread that accepts synchronous messages
+ *
+ * Threads that receive a batch of messages only accept asynchronous requests
+ * and notifications (see receive_batch()), so they are skipped. The receiving
+ * thread is claimed like in dequeue_waiting_thread().
+ *
+ * On a LIFO queue, a receiving thread that last ran on the current CPU is
+ * preferred if it is among the first few, since it is the most likely to have
+ * its working set in this CPU's cache. The search is bounded so a long receive
+ * list does not make sending slower.
+ *
+ * Must be called with the queue lock held.
+ *
+ * @param queue the queues of the endpoint or endpoint set
+ * @return receiving thread, NULL if there is none
+ *
+ */
+static thread_t *dequeue_sync_receiver(ipc_queue_t *queue) {
+    list_t *list    = &queue->recv_list;
+    int cpu         = machine_get_current_cpu();
+
+    while(true) {
+        list_cursor_t found = NULL;
+        int searched        = 0;
+
+        for(list_cursor_t cur = list_head(list); *cur != NULL; cur = list_cursor_next(cur)) {
+            thread_t *receiver = list_cursor_entry(cur, thread_t, thread_list);
+
+            if(receiver->recv_requests_only) {
+                continue;
+            }
+
+            if(found == NULL) {
+                found = cur;
+            }
+
+            if(!queue->is_lifo || receiver->cpu == cpu) {
+                found = cur;
+                break;
+            }
+
+            if(++searched >= LIFO_CPU_SEARCH_DEPTH) {
+                break;
+            }
+        }
+
+        if(found == NULL) {
+            return NULL;
+        }
+
+        thread_t *receiver = list_remove(list, found, thread_t, thread_list);
+
+        /* see dequeue_waiting_thread() */
+        if(claim_message(receiver)) {
+            return receiver;
+        }
+    }
+}
+
+/**
+ * Lock the queues on which a message sent to an IPC endpoint is exchanged
+ *
+ * These are the queues of the endpoint itself unless the endpoint is a member
+ * of an endpoint set, in which case they are the queues of the set.
+ *
+ * @param endpoint IPC endpoint to which the message is sent
+ * @return locked queues
+ *
+ */
+static ipc_queue_t *lock_send_queue(ipc_endpoint_t *endpoint) {
+    spin_lock(&endpoint->queue.lock);
+
+    ipc_endpoint_set_t *set = endpoint->set;
+
+    if(set == NULL) {
+        return &endpoint->queue;
+    }
+
+    spin_lock(&set->queue.lock);
+
+    /* Once the set is destroyed, the endpoint is used on its own again. This
+     * is checked under the set lock to synchronize with the set's "destroy"
+     * op, which aborts all queued threads. */
+    if(object_is_destroyed(&set->header)) {
+        spin_unlock(&set->queue.lock);
+        return &endpoint->queue;
+    }
+
+    spin_unlock(&endpoint->queue.lock);
+
+    return &set->queue;
+}
+
+/**
+ * Remove a thread from a list of threads waiting on IPC queues
+ *
+ * Must be called with the queue lock held.
+ *
+ * @param list send or receive list
+ * @param thread thread to remove
+ * @return true if the thread was in the list, false otherwise
+ *
+ */
+static bool remove_waiting_thread(list_t *list, thread_t *thread) {
+    list_cursor_t cur = list_head(list);
+
+    while(*cur != NULL) {
+        if(list_cursor_entry(cur, thread_t, thread_list) == thread) {
+            (void)list_remove(list, cur, thread_t, thread_list);
+            return true;
+        }
+
+        cur = list_cursor_next(cur);
+    }
+
+    return false;
+}
+
+/**
+ * Time out a receive operation
+ *
+ * The receiving thread is removed from the receive list if it is still on it.
+ * It might not be if a sending thread dequeued it but failed to claim it.
+ *
+ * @param receiver claimed thread blocked receiving a message
+ *
+ */
+static void timeout_receive(thread_t *receiver) {
+    ipc_queue_t *queue = receiver->recv_queue;
+
+    spin_lock(&queue->lock);
+
+    (void)remove_waiting_thread(&queue->recv_list, receiver);
+
+    spin_unlock(&queue->lock);
+
+    abort_message_with_error(receiver, JINUE_ETIMEDOUT);
+}
+
+/**
+ * Time out a send operation
+ *
+ * If the message has not been received yet, the sending thread is removed from
+ * the send list. If it has been received but not replied to, the receiving
+ * thread stops servicing it: its reply will fail with JINUE_ENOMSG. The
+ * receiving thread returns the pages lent to it, if any, the next time it
+ * replies or receives, since they are its own to unmap.
+ *
+ * @param sender claimed thread blocked sending a message
+ *
+ */
+static void timeout_send(thread_t *sender) {
+    /* The sender list is looked up again because the endpoint may have been
+     * added to an endpoint set since the sender was queued. */
+    ipc_queue_t *queue = lock_send_queue(sender->message_endpoint);
+
+    (void)remove_waiting_thread(&queue->send_list, sender);
+
+    spin_unlock(&queue->lock);
+
+    thread_t *receiver = sender->servicer;
+
+    if(receiver != NULL) {
+        /* The receiving thread might be done with this message already and
+         * servicing another one, which must be left alone. */
+        (void)compare_and_swap_ptr_atomic(
+            (void **)&receiver->sender,
+            sender,
+            NULL
+        );
+    }
+
+    abort_message_with_error(sender, JINUE_ETIMEDOUT);
+}
+
+/**
+ * Timer function called when a send or receive operation times out
+ *
+ * The operation is timed out only if it can be claimed. If it is already
+ * claimed, it is marked as expired so the thread that claimed it times it out
+ * if it ends up giving up the claim (see release_message()).
+ *
+ * @param timer timeout timer of the blocked thread
+ *
+ */
+static void ipc_timeout(timer_t *timer) {
+    thread_t *thread = (thread_t *)((char *)timer - OFFSET_OF(thread_t, timeout_timer));
+
+    while(true) {
+        int state   = thread->message_state;
+        int waiting = state & ~MESSAGE_STATE_MASK;
+
+        if((state & MESSAGE_STATE_MASK) == MESSAGE_WAITING) {
+            if(claim_message_state(thread, waiting)) {
+                break;
+            }
+        }
+        else if((state & MESSAGE_STATE_MASK) == MESSAGE_CLAIMED) {
+            int expired = waiting | MESSAGE_EXPIRED;
+
+            if(compare_and_swap_atomic(&thread->message_state, state, expired) == state) {
+                return;
+            }
+        }
+        else {
+            return;
+        }
+    }
+
+    if(thread->recv_queue != NULL) {
+        timeout_receive(thread);
+    }
+    else {
+        timeout_send(thread);
+    }
+}
+
+/**
+ * Start the timeout timer of a thread about to block on an IPC operation
+ *
+ * @param thread thread about to block
+ * @param timeout timeout in ticks, zero for no timeout
+ *
+ */
+static void start_ipc_timeout(thread_t *thread, uint32_t timeout) {
+    if(timeout == 0) {
+        return;
+    }
+
+    initialize_timer(&thread->timeout_timer, ipc_timeout);
+    start_timer(&thread->timeout_timer, timeout);
+}
+
+/**
+ * Cancel the timeout timer of a thread that is done with an IPC operation
+ *
+ * @param thread thread that was blocked
+ * @param timeout timeout in ticks passed to start_ipc_timeout()
+ *
+ */
+static void cancel_ipc_timeout(thread_t *thread, uint32_t timeout) {
+    if(timeout != 0) {
+        (void)cancel_timer(&thread->timeout_timer);
+    }
+}
+
+/**
+ * Send a message to an IPC endpoint
+ *
+ * This function contains the logic shared by send_message() and
+ * send_short_message(). The recv_buffer_size and message members of the
+ * sending thread must already be set. For a short message, the message member
+ * is NULL and the message is already in the sending thread's message buffer.
+ *
+ * @param errcode error code set by the receiving thread (output)
+ * @param endpoint IPC endpoint to which the message is sent
+ * @param sender thread sending the message
+ * @param function function number of the message
+ * @param cookie cookie value sent with the message
+ * @param flags IPC flags (JINUE_IPC_...)
+ * @param timeout timeout in ticks, zero for no timeout
+ * @return reply size in bytes on success, negated error number on error
+ *
+ */
+static int do_send_message(
+        uintptr_t               *errcode,
+        ipc_endpoint_t          *endpoint,
+        thread_t                *sender,
+        int                      function,
+        uintptr_t                cookie,
+        int                      flags,
+        uint32_t                 timeout) {
+
+    const jinue_message_t *message  = sender->message;
+
+    sender->message_endpoint        = endpoint;
+    sender->recv_queue              = NULL;
+    sender->servicer                = NULL;
+    sender->message_reply_errcode   = 0;
+    sender->message_function        = function;
+    sender->message_cookie          = cookie;
+
+    prepare_message_wait(sender);
+
+    bool is_gathered = (message == NULL);
+
+    while(true) {
+        ipc_queue_t *queue = lock_send_queue(endpoint);
+
+        thread_t *receiver = dequeue_sync_receiver(queue);
+
+        if(receiver != NULL) {
+            spin_unlock(&queue->lock);
+
+            int transfer_result;
+            bool peer_fault = false;
+
+            bool is_too_big =
+                    get_bulk_size(sender) > get_bulk_window_size(receiver) ||
+                    ! descriptors_fit(receiver, sender);
+
+            if(is_too_big) {
+                transfer_result = -JINUE_E2BIG;
+            }
+            else if(message == NULL) {
+                transfer_result = transfer_short_message(
+                    receiver,
+                    sender->message_buffer,
+                    sender->message_size,
+                    &peer_fault
+                );
+            }
+            else {
+                transfer_result = transfer_message(receiver, message, &peer_fault);
+            }
+
+            if(peer_fault) {
+                /* The receive buffers of the receiver are not accessible. This
+                 * is the receiver's error, not the sender's, so fail its
+                 * receive operation and try the next receiver. */
+                abort_message_with_error(receiver, -transfer_result);
+                continue;
+            }
+
+            if(transfer_result < 0) {
+                /* The receiver never saw the message, so put it back at the
+                 * head of the queue where it was. */
+                spin_lock(&queue->lock);
+                requeue_waiting_thread(&queue->recv_list, receiver);
+                spin_unlock(&queue->lock);
+
+                return transfer_result;
+            }
+
+            sender->message_size    = transfer_result;
+            sender->servicer        = receiver;
+            receiver->sender        = sender;
+
+            /* The receiver completes the reception of the message once it
+             * runs, so it is claimed on its behalf. It gives up the claim once
+             * it is done (see release_sender()). */
+            sender->message_state   = get_waiting_state(sender) | MESSAGE_CLAIMED;
+
+            start_ipc_timeout(sender, timeout);
+
+            /* switch to receiver thread, which will resume inside syscall_receive() */
+            switch_to_thread_and_block(receiver);
+            break;
+        }
+
+        if(flags & JINUE_IPC_NONBLOCK) {
+            /* No thread is waiting to receive this message and the caller
+             * does not want to wait for one. */
+            spin_unlock(&queue->lock);
+            return -JINUE_EAGAIN;
+        }
+
+        if(is_gathered) {
+            /* No thread is waiting to receive this message, so we must wait on the sender list. */
+            enqueue_sender(queue, sender);
+            start_ipc_timeout(sender, timeout);
+            block_current_thread_and_unlock(&queue->lock);
+            break;
+        }
+
+        spin_unlock(&queue->lock);
+
+        /* No thread is waiting to receive this message, so the message has to
+         * be copied to the message buffer until one is. The queue lock is
+         * released while doing this, so check again for a receiving thread
+         * before blocking. */
+        int gather_result = gather_message(sender->message_buffer, message);
+
+        if(gather_result < 0) {
+            return gather_result;
+        }
+
+        sender->message_size    = gather_result;
+        is_gathered             = true;
+    }
+
+    cancel_ipc_timeout(sender, timeout);
+
+    if(sender->message_errno == JINUE_EPROTO) {
+        *errcode = sender->message_reply_errcode;
+        return -JINUE_EPROTO;
+    }
+
+    if(sender->message_errno != 0) {
+        return -sender->message_errno;
+    }
+
+    /* The reply was copied directly to the receive buffers by the replier. */
+    return sender->message_size;
+}
+
+/**
+ * Send a message to an IPC endpoint.
+ *
+ * This function sends a message to an IPC endpoint so it can be received by
+ * another thread, possibly in another process.
+ *
+ * If a receiving thread is blocked on the IPC endpoint waiting for a message,
+ * then the message is copied directly to its receive buffers and processed
+ * immediately. Otherwise, the message is copied to the sending thread's message
+ * buffer and the sending thread blocks until a receiving thread receives the
+ * message. Threads blocked waiting for a receiving thread are enqueued to a
+ * sender queue and processed in order of priority (see enqueue_sender()).
+ *
+ * The send buffers pointed to by the message structure passed as argument
+ * contain the message to be sent. The receive buffers will be used to store the
+ * reply from the receiving thread. Descriptors can be sent with the message and
+ * received with the reply. The number of descriptors received with the reply is
+ * set in the message structure.
+ *
+ * If a timeout is specified and the reply has not been received when it
+ * expires, the call fails with JINUE_ETIMEDOUT whether or not the message was
+ * received.
+ *
+ * @param errcode error code set by the receiving thread (output)
+ * @param endpoint IPC endpoint to which the message is sent
+ * @param sender thread sending the message
+ * @param function function number of the message
+ * @param cookie cookie value sent with the message
+ * @param flags IPC flags (JINUE_IPC_...)
+ * @param timeout timeout in ticks, zero for no timeout
+ * @param message structure describing the message
+ * @return reply size in bytes on success, negated error number on error
+ *
+ */
+int send_message(
+        uintptr_t               *errcode,
+        ipc_endpoint_t          *endpoint,
+        thread_t                *sender,
+        int                      function,
+        uintptr_t                cookie,
+        int                      flags,
+        uint32_t                 timeout,
+        jinue_message_t         *message) {
+
+    int recv_buffer_size = get_receive_buffers_size(message);
+
+    if(recv_buffer_size < 0) {
+        return recv_buffer_size;
+    }
+
+    int status = reserve_descriptor_slots(sender, message);
+
+    if(status < 0) {
+        return status;
+    }
+
+    status = gather_descriptors(sender, message);
+
+    if(status < 0) {
+        free_descriptor_slots(sender);
+        return status;
+    }
+
+    sender->recv_buffer_size    = recv_buffer_size;
+    sender->message             = message;
+
+    int retval = do_send_message(errcode, endpoint, sender, function, cookie, flags, timeout);
+
+    message->recv_descs_count = sender->recv_descs_count;
+
+    drop_descriptors(sender);
+    free_descriptor_slots(sender);
+
+    return retval;
+}
+
+/**
+ * Send a short message to an IPC endpoint
+ *
+ * A short message is made of JINUE_SHORT_MESSAGE_WORDS data words that are
+ * passed in registers, so it never needs to be read from or written to user
+ * space buffers. Its reply is also a short message, i.e. it is at most
+ * JINUE_SHORT_MESSAGE_SIZE bytes long.
+ *
+ * Otherwise, this function behaves like send_message(). The receiving thread
+ * can receive the message either as a short message or as a regular one.
+ *
+ * @param errcode error code set by the receiving thread (output)
+ * @param endpoint IPC endpoint to which the message is sent
+ * @param sender thread sending the message
+ * @param function function number of the message
+ * @param cookie cookie value sent with the message
+ * @param flags IPC flags (JINUE_IPC_...)
+ * @param data message data on input, reply data on output
+ * @return reply size in bytes on success, negated error number on error
+ *
+ */
+int send_short_message(
+        uintptr_t               *errcode,
+        ipc_endpoint_t          *endpoint,
+        thread_t                *sender,
+        int                      function,
+        uintptr_t                cookie,
+        int                      flags,
+        uintptr_t               *data) {
+
+    memcpy(sender->message_buffer, data, JINUE_SHORT_MESSAGE_SIZE);
+
+    sender->message_size        = JINUE_SHORT_MESSAGE_SIZE;
+    sender->recv_buffer_size    = JINUE_SHORT_MESSAGE_SIZE;
+    sender->message             = NULL;
+
+    int retval = do_send_message(errcode, endpoint, sender, function, cookie, flags, 0);
+
+    if(retval >= 0) {
+        copy_short_message_data(data, sender->message_buffer, retval);
+    }
+
+    return retval;
+}
+
+/**
+ * Free an asynchronous request
+ *
+ * This releases the request's slot on its completion queue as well as the
+ * reference on the completion queue.
+ *
+ * @param request request to free
+ *
+ */
+void discard_request(ipc_request_t *request) {
+    completion_queue_t *queue = request->completion_queue;
+
+    (void)add_atomic(&queue->outstanding, -1);
+    object_sub_ref(&queue->header);
+
+    slab_cache_free(request);
+}
+
+/**
+ * Complete an asynchronous request
+ *
+ * The request is posted to its completion queue and a thread waiting on the
+ * completion queue, if any, is made ready to run. If the completion queue has
+ * been destroyed, the request is discarded instead.
+ *
+ * On success, the size member of the request must already be set to the size
+ * of the reply, which is in the request's buffer.
+ *
+ * @param request completed request
+ * @param error error number, zero on success
+ * @param errcode error code set by the receiving thread if error is JINUE_EPROTO
+ *
+ */
+static void complete_request(ipc_request_t *request, int error, uintptr_t errcode) {
+    request->error      = error;
+    request->errcode    = errcode;
+
+    if(request->endpoint != NULL) {
+        object_sub_ref(&request->endpoint->header);
+        request->endpoint = NULL;
+    }
+
+    completion_queue_t *queue = request->completion_queue;
+
+    spin_lock(&queue->lock);
+
+    if(object_is_destroyed(&queue->header)) {
+        spin_unlock(&queue->lock);
+        discard_request(request);
+        return;
+    }
+
+    list_enqueue(&queue->completed, &request->request_list);
+
+    thread_t *waiter = list_dequeue(&queue->wait_list, thread_t, thread_list);
+
+    if(waiter != NULL) {
+        ready_thread(waiter);
+    }
+
+    spin_unlock(&queue->lock);
+}
+
+/**
+ * Abort an asynchronous request
+ *
+ * The request completes with JINUE_EIO.
+ *
+ * Situations that make calling this function necessary:
+ *  - The request is queued on an IPC endpoint and the endpoint is being
+ *    destroyed.
+ *  - The request is being serviced by a receiving thread and that thread exits
+ *    or receives another message without replying.
+ *
+ * @param request request to abort
+ *
+ */
+void abort_request(ipc_request_t *request) {
+    complete_request(request, JINUE_EIO, 0);
+}
+
+/**
+ * Reserve a slot on a completion queue and allocate a request
+ *
+ * @param queue completion queue
+ * @return request on success, NULL if the completion queue is full or on allocation failure
+ *
+ */
+static ipc_request_t *new_request(completion_queue_t *queue) {
+    if(add_atomic(&queue->outstanding, 1) > JINUE_MAX_ASYNC_REQUESTS) {
+        (void)add_atomic(&queue->outstanding, -1);
+        return NULL;
+    }
+
+    ipc_request_t *request = slab_cache_alloc(&ipc_request_cache);
+
+    if(request == NULL) {
+        (void)add_atomic(&queue->outstanding, -1);
+        return NULL;
+    }
+
+    spin_lock(&queue->lock);
+
+    /* The request identifier is returned by the system call, so it must be a
+     * positive int. */
+    if(queue->next_id >= INT_MAX) {
+        queue->next_id = 0;
+    }
+
+    request->id = ++queue->next_id;
+
+    spin_unlock(&queue->lock);
+
+    object_add_ref(&queue->header);
+
+    request->completion_queue   = queue;
+    request->endpoint           = NULL;
+
+    return request;
+}
+
+/**
+ * Send an asynchronous request to an IPC endpoint
+ *
+ * The message is copied to a request that is queued on the IPC endpoint,
+ * unless a receiving thread is already waiting, in which case the message is
+ * copied directly to its receive buffers. Either way, the sending thread does
+ * not block and the call returns a request identifier right away.
+ *
+ * The receiving thread receives and replies to the request like any other
+ * message (see receive_message() and reply_to_message()). The reply, or the
+ * error, is then posted to the completion queue passed as argument, from which
+ * it can be collected by calling collect_completions(). The reply is written to
+ * the receive buffers described in the message structure passed as argument
+ * at that time, so they must remain valid until then. At most
+ * JINUE_MAX_ASYNC_RECV_BUFFERS receive buffers can be specified.
+ *
+ * Requests are received in the order in which they are sent, ahead of waiting
+ * sending threads with a lower priority.
+ *
+ * @param endpoint IPC endpoint to which the message is sent
+ * @param queue completion queue to which the reply is posted
+ * @param sender thread sending the message
+ * @param function function number of the message
+ * @param cookie cookie value sent with the message
+ * @param message structure describing the message
+ * @return request identifier on success, negated error number on error
+ *
+ */
+int send_async_message(
+        ipc_endpoint_t          *endpoint,
+        completion_queue_t      *queue,
+        thread_t                *sender,
+        int                      function,
+        uintptr_t                cookie,
+        const jinue_message_t   *message) {
+
+    if(message->recv_buffers_length > JINUE_MAX_ASYNC_RECV_BUFFERS) {
+        return -JINUE_EINVAL;
+    }
+
+    int recv_buffer_size = get_receive_buffers_size(message);
+
+    if(recv_buffer_size < 0) {
+        return recv_buffer_size;
+    }
+
+    ipc_request_t *request = new_request(queue);
+
+    if(request == NULL) {
+        return -JINUE_EAGAIN;
+    }
+
+    int gather_result = gather_message(request->buffer, message);
+
+    if(gather_result < 0) {
+        discard_request(request);
+        return gather_result;
+    }
+
+    request->size                   = gather_result;
+    request->function               = function;
+    request->cookie                 = cookie;
+    request->priority               = thread_get_priority(sender);
+    request->recv_buffer_size       = recv_buffer_size;
+    request->recv_buffers_length    = message->recv_buffers_length;
+
+    for(int idx = 0; idx < message->recv_buffers_length; ++idx) {
+        request->recv_buffers[idx] = message->recv_buffers[idx];
+    }
+
+    int id = request->id;
+
+    thread_t *receiver;
+
+    while(true) {
+        ipc_queue_t *ipc_queue = lock_send_queue(endpoint);
+
+        receiver = dequeue_waiting_thread(&ipc_queue->recv_list);
+
+        if(receiver == NULL) {
+            /* released by complete_request() */
+            object_add_ref(&endpoint->header);
+            request->endpoint = endpoint;
+
+            list_enqueue(&ipc_queue->async_list, &request->request_list);
+            spin_unlock(&ipc_queue->lock);
+
+            return id;
+        }
+
+        spin_unlock(&ipc_queue->lock);
+
+        bool peer_fault = false;
+        int transfer_result = transfer_short_message(
+            receiver,
+            request->buffer,
+            request->size,
+            &peer_fault
+        );
+
+        if(peer_fault) {
+            /* The receive buffers of the receiver are not accessible, so fail
+             * its receive operation and try the next receiver. */
+            abort_message_with_error(receiver, -transfer_result);
+            continue;
+        }
+
+        if(transfer_result < 0) {
+            /* The receiver never saw the message, so put it back at the head
+             * of the queue where it was. */
+            spin_lock(&ipc_queue->lock);
+            requeue_waiting_thread(&ipc_queue->recv_list, receiver);
+            spin_unlock(&ipc_queue->lock);
+
+            discard_request(request);
+            return transfer_result;
+        }
+
+        break;
+    }
+
+    object_add_ref(&endpoint->header);
+    request->endpoint   = endpoint;
+    receiver->request   = request;
+
+    ready_thread(receiver);
+
+    return id;
+}
+
+/**
+ * Collect the completed asynchronous requests of a completion queue
+ *
+ * If no request has completed yet, the thread blocks until one does, unless
+ * the JINUE_IPC_NONBLOCK flag is set. Then, up to length completed requests
+ * are removed from the completion queue. For each of them, the reply is written
+ * to the receive buffers specified when the request was sent and the result is
+ * set in the completions array.
+ *
+ * The completions array must be in the current address space and have been
+ * checked by the caller.
+ *
+ * @param queue completion queue
+ * @param thread thread collecting the completions
+ * @param flags IPC flags (JINUE_IPC_...)
+ * @param completions completions array (output)
+ * @param length number of elements in the completions array
+ * @return number of completions on success, negated error number on error
+ *
+ */
+int collect_completions(
+        completion_queue_t  *queue,
+        thread_t            *thread,
+        int                  flags,
+        jinue_completion_t  *completions,
+        int                  length) {
+
+    spin_lock(&queue->lock);
+
+    while(list_is_empty(&queue->completed)) {
+        if(object_is_destroyed(&queue->header)) {
+            spin_unlock(&queue->lock);
+            return -JINUE_EIO;
+        }
+
+        if(flags & JINUE_IPC_NONBLOCK) {
+            spin_unlock(&queue->lock);
+            return -JINUE_EAGAIN;
+        }
+
+        prepare_message_wait(thread);
+
+        list_enqueue(&queue->wait_list, &thread->thread_list);
+        block_current_thread_and_unlock(&queue->lock);
+
+        if(thread->message_errno != 0) {
+            return -thread->message_errno;
+        }
+
+        spin_lock(&queue->lock);
+    }
+
+    /* The replies are written to user space once the lock is released. */
+    list_t collected;
+    init_list(&collected);
+
+    int count = 0;
+
+    while(count < length) {
+        ipc_request_t *request = list_dequeue(&queue->completed, ipc_request_t, request_list);
+
+        if(request == NULL) {
+            break;
+        }
+
+        list_enqueue(&collected, &request->request_list);
+        ++count;
+    }
+
+    spin_unlock(&queue->lock);
+
+    for(int idx = 0; idx < count; ++idx) {
+        ipc_request_t *request  = list_dequeue(&collected, ipc_request_t, request_list);
+        int error               = request->error;
+
+        if(error == 0) {
+            int scatter_result = scatter_message(
+                request->buffer,
+                request->size,
+                request->recv_buffers,
+                request->recv_buffers_length
+            );
+
+            if(scatter_result < 0) {
+                error = -scatter_result;
+            }
+        }
+
+        completions[idx].request_id = request->id;
+        completions[idx].result     = (error == 0) ? request->size : -1;
+        completions[idx].error      = error;
+        completions[idx].errcode    = request->errcode;
+
+        discard_request(request);
+    }
+
+    return count;
+}
+
+/**
+ * Atomically fetch and clear the pending bits of a notification
+ *
+ * @param notification notification, may be NULL
+ * @return pending bits, zero if none or if notification is NULL
+ *
+ */
+static uintptr_t take_notification_bits(notification_t *notification) {
+    if(notification == NULL) {
+        return 0;
+    }
+
+    /* Check before swapping to avoid a locked write in the common case. */
+    if(notification->bits == 0) {
+        return 0;
+    }
+
+    return (uintptr_t)swap_atomic((int *)&notification->bits, 0);
+}
+
+/**
+ * Wake up a thread blocked on a list if a notification has pending bits
+ *
+ * The caller must hold the lock that protects the list.
+ *
+ * @param notification notification
+ * @param list list of blocked threads
+ * @return true if a thread was woken up, false otherwise
+ *
+ */
+static bool wake_notified_thread(notification_t *notification, list_t *list) {
+    thread_t *thread = dequeue_waiting_thread(list);
+
+    if(thread == NULL) {
+        return false;
+    }
+
+    uintptr_t bits = take_notification_bits(notification);
+
+    if(bits == 0) {
+        /* Another thread took the bits before we did. */
+        requeue_waiting_thread(list, thread);
+        return true;
+    }
+
+    thread->notification_bits = bits;
+    ready_thread(thread);
+
+    return true;
+}
+
+/**
+ * Signal a notification
+ *
+ * The bits passed as argument are added to the notification's pending bits.
+ * If a thread is waiting on the notification, or is blocked receiving on the
+ * IPC endpoint or endpoint set to which the notification is bound, it is made
+ * ready to run with the pending bits, which are cleared. The calling thread
+ * never blocks.
+ *
+ * Lock order is notification, then IPC queue.
+ *
+ * @param notification notification to signal
+ * @param bits bits to set
+ *
+ */
+void send_notification(notification_t *notification, uintptr_t bits) {
+    if(bits == 0) {
+        return;
+    }
+
+    (void)or_atomic((int *)&notification->bits, bits);
+
+    spin_lock(&notification->lock);
+
+    if(! wake_notified_thread(notification, &notification->wait_list)) {
+        ipc_queue_t *queue = notification->bound_queue;
+
+        if(queue != NULL) {
+            spin_lock(&queue->lock);
+            (void)wake_notified_thread(notification, &queue->recv_list);
+            spin_unlock(&queue->lock);
+        }
+    }
+
+    spin_unlock(&notification->lock);
+}
+
+/**
+ * Wait for a notification
+ *
+ * If the notification has pending bits, they are returned and cleared
+ * immediately. Otherwise, the thread blocks until the notification is
+ * signalled.
+ *
+ * @param notification notification on which to wait
+ * @param thread waiting thread
+ * @param bits pending bits (output)
+ * @return zero on success, negated error number on error
+ *
+ */
+int wait_for_notification(notification_t *notification, thread_t *thread, uintptr_t *bits) {
+    spin_lock(&notification->lock);
+
+    uintptr_t pending = take_notification_bits(notification);
+
+    if(pending != 0) {
+        spin_unlock(&notification->lock);
+        *bits = pending;
+        return 0;
+    }
+
+    prepare_message_wait(thread);
+
+    list_enqueue(&notification->wait_list, &thread->thread_list);
+    block_current_thread_and_unlock(&notification->lock);
+
+    if(thread->message_errno != 0) {
+        return -thread->message_errno;
+    }
+
+    /* set by send_notification() */
+    *bits = thread->notification_bits;
+
+    return 0;
+}
+
+/**
+ * Bind a notification to the queues of an IPC endpoint or endpoint set
+ *
+ * Once bound, a thread receiving from the endpoint or endpoint set receives
+ * the notification's pending bits as a message with function number
+ * JINUE_MSG_NOTIFICATION. The binding holds a reference on the notification
+ * until unbind_notification() is called.
+ *
+ * @param notification notification to bind
+ * @param queue queues of the IPC endpoint or endpoint set
+ * @return zero on success, negated error number on error
+ *
+ */
+int bind_notification_to_queue(notification_t *notification, ipc_queue_t *queue) {
+    spin_lock(&notification->lock);
+    spin_lock(&queue->lock);
+
+    if(notification->bound_queue != NULL || queue->notification != NULL) {
+        spin_unlock(&queue->lock);
+        spin_unlock(&notification->lock);
+        return -JINUE_EBUSY;
+    }
+
+    object_add_ref(&notification->header);
+
+    notification->bound_queue   = queue;
+    queue->notification         = notification;
+
+    spin_unlock(&queue->lock);
+    spin_unlock(&notification->lock);
+
+    return 0;
+}
+
+/**
+ * Unbind the notification bound to the queues of an IPC endpoint or endpoint set
+ *
+ * This function is called when the IPC endpoint or endpoint set is destroyed.
+ * It does nothing if no notification is bound.
+ *
+ * @param queue queues of the IPC endpoint or endpoint set
+ *
+ */
+void unbind_notification(ipc_queue_t *queue) {
+    notification_t *notification = queue->notification;
+
+    if(notification == NULL) {
+        return;
+    }
+
+    spin_lock(&notification->lock);
+    spin_lock(&queue->lock);
+
+    notification->bound_queue   = NULL;
+    queue->notification         = NULL;
+
+    spin_unlock(&queue->lock);
+    spin_unlock(&notification->lock);
+
+    object_sub_ref(&notification->header);
+}
+
+/**
+ * Unmap the pages lent to a thread with the message it received
+ *
+ * This function is called when the thread replies to the message or stops
+ * servicing it. It does nothing if no pages are lent to the thread.
+ *
+ * @param receiver thread to which pages are lent
+ *
+ */
+void return_lent_pages(thread_t *receiver) {
+    if(receiver->lent_size == 0) {
+        return;
+    }
+
+    machine_unmap_userspace(receiver->process, receiver->lent_addr, receiver->lent_size);
+    receiver->lent_size = 0;
+}
+
+/**
+ * Lend the pages of a bulk message to the thread that received it
+ *
+ * The pages of the sender's send_bulk buffer are mapped read only in the
+ * receiver's bulk window, without copying. They remain mapped until the
+ * receiver replies (see return_lent_pages()). The sender is blocked until then
+ * so the pages cannot change under the receiver.
+ *
+ * The caller must have checked the bulk window is large enough.
+ *
+ * @param receiver thread that received the message
+ * @return zero on success, negated error number on error
+ *
+ */
+static int lend_bulk_pages(thread_t *receiver) {
+    const thread_t *sender = receiver->sender;
+    size_t size = get_bulk_size(sender);
+
+    if(size == 0) {
+        return 0;
+    }
+
+    const char *src = sender->message->send_bulk.addr;
+    addr_t dest     = receiver->message->bulk_window.addr;
+
+    receiver->lent_addr = dest;
+
+    for(size_t offset = 0; offset < size; offset += PAGE_SIZE) {
+        paddr_t paddr;
+
+        if(! machine_lookup_userspace_paddr(sender->process, src + offset, JINUE_PROT_READ, &paddr)) {
+            return_lent_pages(receiver);
+            return -JINUE_EINVAL;
+        }
+
+        bool mapped = machine_map_userspace(
+            receiver->process,
+            dest + offset,
+            PAGE_SIZE,
+            paddr,
+            JINUE_PROT_READ,
+            JINUE_MAP_NONE
+        );
+
+        if(! mapped) {
+            return_lent_pages(receiver);
+            return -JINUE_ENOMEM;
+        }
+
+        receiver->lent_size = offset + PAGE_SIZE;
+    }
+
+    return 0;
+}
+
+/**
+ * Dequeue the asynchronous request to receive next, if any
+ *
+ * An asynchronous request is received ahead of the thread at the head of the
+ * send list only if it was sent with a higher priority.
+ *
+ * Must be called with the queue lock held.
+ *
+ * @param queue IPC queues
+ * @param requests_only true if sending threads are not to be received
+ * @return request, NULL if a sending thread is to be received first or if there are no requests
+ *
+ */
+static ipc_request_t *dequeue_request(ipc_queue_t *queue, bool requests_only) {
+    if(list_is_empty(&queue->async_list)) {
+        return NULL;
+    }
+
+    if(! requests_only && ! list_is_empty(&queue->send_list)) {
+        const ipc_request_t *request =
+                list_node_entry(queue->async_list.head, ipc_request_t, request_list);
+        const thread_t *sender =
+                list_node_entry(queue->send_list.head, thread_t, thread_list);
+
+        if(thread_get_priority(sender) >= request->priority) {
+            return NULL;
+        }
+    }
+
+    return list_dequeue(&queue->async_list, ipc_request_t, request_list);
+}
+
+/**
+ * Complete the reception of a message by the receiving thread
+ *
+ * If the message is in bulk mode, its pages are lent to the receiving thread.
+ * If this fails, the message fails to be sent, the sending thread is made
+ * ready to run and the receiving thread no longer has a current message.
+ * Otherwise, the descriptors sent with the message are installed.
+ *
+ * @param receiver thread that received the message
+ * @return true on success, false if the message failed to be sent
+ *
+ */
+static bool complete_receive(thread_t *receiver) {
+    int lend_result = lend_bulk_pages(receiver);
+
+    if(lend_result < 0) {
+        thread_t *sender        = receiver->sender;
+        sender->message_errno   = -lend_result;
+        receiver->sender        = NULL;
+
+        ready_thread(sender);
+        return false;
+    }
+
+    install_descriptors(receiver, receiver->sender);
+
+    return true;
+}
+
+/**
+ * Receive a message from an IPC endpoint, optionally replying first
+ *
+ * This function contains the logic shared by receive_message(),
+ * receive_short_message() and reply_and_receive_message(). The
+ * recv_buffer_size and message members of the receiving thread must already
+ * be set. For a short message, the message member is NULL and the message is
+ * written to the receiving thread's message buffer.
+ *
+ * If replyto is not NULL, it is the sending thread to which the receiving
+ * thread just replied. That thread is switched to directly if the receiving
+ * thread needs to block, or made ready to run otherwise.
+ *
+ * On success, the sender member of the receiving thread is set to the thread
+ * that sent the message. The operation of that thread is still claimed, so the
+ * caller can access its members until it calls release_sender(). If an
+ * asynchronous request is received instead, the
+ * sender member is set to NULL and the request member is set to the request
+ * (see send_async_message()). If a notification is bound to the queues and has
+ * pending bits, these bits are received instead of a message: the sender and
+ * request members are then set to NULL and the bits are set in the
+ * notification_bits member.
+ *
+ * @param queue queues of the IPC endpoint or endpoint set from which to receive
+ * @param receiver thread receiving the message
+ * @param replyto thread that was replied to, NULL if none
+ * @param flags IPC flags (JINUE_IPC_...)
+ * @param timeout timeout in ticks, zero for no timeout
+ * @return received message size in bytes on success, negated error number on error
+ *
+ */
+static int do_receive_message(
+        ipc_queue_t         *queue,
+        thread_t            *receiver,
+        thread_t            *replyto,
+        int                  flags,
+        uint32_t             timeout) {
+
+    bool has_waited = false;
+
+    receiver->recv_queue = queue;
+
+    /* A thread that receives without replying gives up its current message. */
+    abort_current_message(receiver);
+
+    prepare_message_wait(receiver);
+
+    while(true) {
+        spin_lock(&queue->lock);
+
+        uintptr_t bits = take_notification_bits(queue->notification);
+
+        if(bits != 0) {
+            spin_unlock(&queue->lock);
+
+            if(replyto != NULL) {
+                ready_thread(replyto);
+            }
+
+            receiver->sender            = NULL;
+            receiver->notification_bits = bits;
+            return 0;
+        }
+
+        ipc_request_t *request = dequeue_request(queue, receiver->recv_requests_only);
+
+        if(request != NULL) {
+            spin_unlock(&queue->lock);
+
+            if(replyto != NULL) {
+                ready_thread(replyto);
+                replyto = NULL;
+            }
+
+            receiver->sender = NULL;
+
+            if(request->size > receiver->recv_buffer_size) {
+                complete_request(request, JINUE_E2BIG, 0);
+                continue;
+            }
+
+            if(receiver->message == NULL) {
+                memcpy(receiver->message_buffer, request->buffer, request->size);
+            }
+            else {
+                int scatter_result = scatter_message(
+                    request->buffer,
+                    request->size,
+                    receiver->message->recv_buffers,
+                    receiver->message->recv_buffers_length
+                );
+
+                if(scatter_result < 0) {
+                    /* The request was dequeued, so it has to be completed
+                     * even though it could not be received. */
+                    complete_request(request, -scatter_result, 0);
+                    return scatter_result;
+                }
+            }
+
+            receiver->request           = request;
+            receiver->recv_descs_count  = 0;
+
+            return request->size;
+        }
+
+        thread_t *sender = NULL;
+
+        if(! receiver->recv_requests_only) {
+            sender = dequeue_waiting_thread(&queue->send_list);
+        }
+
+        if(sender == NULL && (flags & JINUE_IPC_NONBLOCK)) {
+            /* No thread is waiting to send a message and the caller does not
+             * want to wait for one. */
+            spin_unlock(&queue->lock);
+
+            if(replyto != NULL) {
+                ready_thread(replyto);
+            }
+
+            receiver->sender = NULL;
+            return -JINUE_EAGAIN;
+        }
+
+        if(sender == NULL) {
+            /* No thread is waiting to send a message, so we must wait on the
+             * receive list. The sender member remains NULL if a notification
+             * wakes us up instead of a message. */
+            receiver->sender = NULL;
+
+            /* If we have to wait again, the thread that woke us up the first
+             * time claimed our operation, so the claim is given up. The
+             * timeout may have expired in the meantime. */
+            if(has_waited && ! release_message(receiver)) {
+                spin_unlock(&queue->lock);
+                return -JINUE_ETIMEDOUT;
+            }
+
+            /* Senders always take the receiver at the head of the list. On a
+             * LIFO queue, this is the receiver that waited the least, which
+             * is the most likely to still have its working set in cache. */
+            if(queue->is_lifo) {
+                list_push(&queue->recv_list, &receiver->thread_list);
+            }
+            else {
+                list_enqueue(&queue->recv_list, &receiver->thread_list);
+            }
+
+            /* The timer is started only once so the timeout applies to the
+             * whole call even if we have to wait again. It is cancelled by
+             * the caller. */
+            if(! has_waited) {
+                start_ipc_timeout(receiver, timeout);
+                has_waited = true;
+            }
+
+            if(replyto == NULL) {
+                block_current_thread_and_unlock(&queue->lock);
+            }
+            else {
+                /* switch back to the thread that was replied to so it can
+                 * return from its call immediately */
+                switch_to_thread_block_and_unlock(replyto, &queue->lock);
+                replyto = NULL;
+            }
+
+            if(receiver->message_errno != 0) {
+                receiver->sender = NULL;
+                return -receiver->message_errno;
+            }
+
+            if(receiver->request != NULL) {
+                /* Set by send_async_message(), which also copied the message
+                 * directly to the receive buffers. */
+                receiver->recv_descs_count = 0;
+                return receiver->request->size;
+            }
+
+            if(receiver->sender == NULL) {
+                /* notification bits set by send_notification() */
+                return 0;
+            }
+
+            /* The sending thread claimed itself on our behalf (see
+             * do_send_message()). The claim is given up by the caller. */
+            if(! complete_receive(receiver)) {
+                continue;
+            }
+
+            /* Set by the sending thread, which also copied the message
+             * directly to the receive buffers. */
+            return receiver->sender->message_size;
+        }
+
+        spin_unlock(&queue->lock);
+
+        if(replyto != NULL) {
+            ready_thread(replyto);
+            replyto = NULL;
+        }
+
+        sender->servicer = receiver;
+        receiver->sender = sender;
+
+        bool is_too_big =
+                sender->message_size > receiver->recv_buffer_size ||
+                get_bulk_size(sender) > get_bulk_window_size(receiver) ||
+                ! descriptors_fit(receiver, sender);
+
+        if(is_too_big) {
+            /* message is too big for the receive buffer, the bulk window or
+             * the reserved descriptors */
+            sender->message_errno   = JINUE_E2BIG;
+            receiver->sender        = NULL;
+
+            ready_thread(sender);
+            continue;
+        }
+
+        /* copy message from the sender's message buffer */
+        if(receiver->message == NULL) {
+            memcpy(receiver->message_buffer, sender->message_buffer, sender->message_size);
+        }
+        else {
+            int scatter_result = scatter_message(
+                sender->message_buffer,
+                sender->message_size,
+                receiver->message->recv_buffers,
+                receiver->message->recv_buffers_length
+            );
+
+            if(scatter_result < 0) {
+                /* The sender was dequeued, so it has to be completed even
+                 * though its message could not be received. */
+                sender->message_errno   = -scatter_result;
+                receiver->sender        = NULL;
+
+                ready_thread(sender);
+                return scatter_result;
+            }
+        }
+
+        if(! complete_receive(receiver)) {
+            continue;
+        }
+
+        return sender->message_size;
+    }
+}
+
+/**
+ * Set the information about a received message in the message structure
+ *
+ * If notification bits were received instead of a message, the function
+ * number is set to JINUE_MSG_NOTIFICATION and the bits are set as the cookie.
+ *
+ * @param message structure describing the receive buffers
+ * @param receiver thread that received the message
+ *
+ */
+static void set_received_message_info(jinue_message_t *message, const thread_t *receiver) {
+    const ipc_request_t *request = receiver->request;
+
+    if(request != NULL) {
+        message->recv_function  = request->function;
+        message->recv_cookie    = request->cookie;
+        message->reply_max_size = request->recv_buffer_size;
+        message->recv_bulk_size = 0;
+        message->recv_descs_count = 0;
+        return;
+    }
+
+    const thread_t *sender = receiver->sender;
+
+    if(sender == NULL) {
+        message->recv_function  = JINUE_MSG_NOTIFICATION;
+        message->recv_cookie    = receiver->notification_bits;
+        message->reply_max_size = 0;
+        message->recv_bulk_size = 0;
+        message->recv_descs_count = 0;
+        return;
+    }
+
+    message->recv_function  = sender->message_function;
+    message->recv_cookie    = sender->message_cookie;
+    message->reply_max_size = sender->recv_buffer_size;
+    message->recv_bulk_size = receiver->lent_size;
+    message->recv_descs_count = receiver->recv_descs_count;
+}
+
+/**
+ * Receive a message from an IPC endpoint
+ *
+ * This function receives a message that another thread, probably in another
+ * process, sent to a specific IPC endpoint.
+ *
+ * If a sending thread is blocked on the IPC endpoint waiting for a receiving
+ * thread, then its message is processed immediately. Otherwise, the receiving
+ * thread blocks until a sending thread attempts to send a message, which the
+ * sending thread then copies directly to the receive buffers. Threads blocked
+ * waiting to receive a message are enqueued to a receiving thread queue.
+ *
+ * When receiving from an endpoint set, the sending threads of all member
+ * endpoints share a single queue, so the oldest message with the highest
+ * priority sent to any member is received first.
+ *
+ * Until it replies, the receiving thread inherits the priority of the sending
+ * thread (see thread_get_priority()).
+ *
+ * The receive buffers pointed to by the message structure passed as argument
+ * will be used to receive the message.
+ *
+ * If a timeout is specified and no message is received before it expires, the
+ * call fails with JINUE_ETIMEDOUT.
+ *
+ * @param queue queues of the IPC endpoint or endpoint set from which to receive
+ * @param receiver thread receiving the message
+ * @param flags IPC flags (JINUE_IPC_...)
+ * @param timeout timeout in ticks, zero for no timeout
+ * @param message structure describing the receive buffers
+ * @return received message size in bytes on success, negated error number on error
+ *
+ */
+int receive_message(
+        ipc_queue_t         *queue,
+        thread_t            *receiver,
+        int                  flags,
+        uint32_t             timeout,
+        jinue_message_t     *message) {
+    int recv_buffer_size = get_receive_buffers_size(message);
+
+    if(recv_buffer_size < 0) {
+        return recv_buffer_size;
+    }
+
+    int status = reserve_descriptor_slots(receiver, message);
+
+    if(status < 0) {
+        return status;
+    }
+
+    receiver->recv_buffer_size  = recv_buffer_size;
+    receiver->message           = message;
+
+    int retval = do_receive_message(queue, receiver, NULL, flags, timeout);
+
+    cancel_ipc_timeout(receiver, timeout);
+
+    if(retval >= 0) {
+        set_received_message_info(message, receiver);
+        release_sender(receiver);
+    }
+
+    free_descriptor_slots(receiver);
+
+    return retval;
+}
+
+/**
+ * Receive a short message from an IPC endpoint
+ *
+ * This function behaves like receive_message() except that the message is
+ * returned in the short message structure passed as argument instead of being
+ * written to user space buffers. Any message, short or not, that is at most
+ * JINUE_SHORT_MESSAGE_SIZE bytes long can be received this way. A larger
+ * message fails to be sent with JINUE_E2BIG.
+ *
+ * @param queue queues of the IPC endpoint or endpoint set from which to receive
+ * @param receiver thread receiving the message
+ * @param flags IPC flags (JINUE_IPC_...)
+ * @param short_message received message (output)
+ * @return received message size in bytes on success, negated error number on error
+ *
+ */
+int receive_short_message(
+        ipc_queue_t             *queue,
+        thread_t                *receiver,
+        int                      flags,
+        jinue_short_message_t   *short_message) {
+
+    receiver->recv_buffer_size  = JINUE_SHORT_MESSAGE_SIZE;
+    receiver->message           = NULL;
+
+    int retval = do_receive_message(queue, receiver, NULL, flags, 0);
+
+    if(retval < 0) {
+        return retval;
+    }
+
+    const thread_t *sender = receiver->sender;
+
+    if(receiver->request != NULL) {
+        short_message->function = receiver->request->function;
+        short_message->cookie   = receiver->request->cookie;
+    }
+    else if(sender == NULL) {
+        short_message->function = JINUE_MSG_NOTIFICATION;
+        short_message->cookie   = receiver->notification_bits;
+    }
+    else {
+        short_message->function = sender->message_function;
+        short_message->cookie   = sender->message_cookie;
+    }
+
+    release_sender(receiver);
+
+    copy_short_message_data(short_message->data, receiver->message_buffer, retval);
+
+    return retval;
+}
+
+/**
+ * Get the IPC endpoint to which the current message of a thread was sent
+ *
+ * @param receiver thread that received the message
+ * @return IPC endpoint, NULL if the thread has no current message
+ *
+ */
+ipc_endpoint_t *get_message_endpoint(const thread_t *receiver) {
+    if(receiver->request != NULL) {
+        return receiver->request->endpoint;
+    }
+
+    /* The sending thread might time out and clear the sender member at any
+     * time, see timeout_send(). */
+    const thread_t *sender = receiver->sender;
+
+    if(sender != NULL) {
+        return sender->message_endpoint;
+    }
+
+    return NULL;
+}
+
+/**
+ * Post a reply to the asynchronous request a thread is servicing
+ *
+ * The reply is copied to the request, which is then posted to its completion
+ * queue. Descriptors cannot be sent in reply to an asynchronous request.
+ *
+ * @param replier thread replying to the request
+ * @param message structure describing the reply
+ * @return zero on success, negated error number on error
+ *
+ */
+static int reply_to_request(thread_t *replier, const jinue_message_t *message) {
+    ipc_request_t *request = replier->request;
+
+    if(message->send_descs_length > 0) {
+        return -JINUE_E2BIG;
+    }
+
+    int reply_size = get_send_buffers_size(message);
+
+    if(reply_size < 0) {
+        return reply_size;
+    }
+
+    if(reply_size > request->recv_buffer_size) {
+        return -JINUE_E2BIG;
+    }
+
+    int gather_result = gather_message(request->buffer, message);
+
+    if(gather_result < 0) {
+        return gather_result;
+    }
+
+    request->size       = gather_result;
+    replier->request    = NULL;
+
+    complete_request(request, 0, 0);
+
+    return 0;
+}
+
+/**
+ * Copy a reply and the descriptors sent with it to the thread that was replied to
+ *
+ * @param replier thread replying to the message
+ * @param replyto thread that sent the message
+ * @param message structure describing the reply
+ * @return reply size in bytes on success, negated error number on error
+ *
+ */
+static int transfer_reply(thread_t *replier, thread_t *replyto, const jinue_message_t *message) {
+    int status = gather_descriptors(replier, message);
+
+    if(status < 0) {
+        return status;
+    }
+
+    if(! descriptors_fit(replyto, replier)) {
+        drop_descriptors(replier);
+        return -JINUE_E2BIG;
+    }
+
+    /* the reply must fit in the sender's receive buffer, which is checked by
+     * transfer_message() */
+    int transfer_result = transfer_message(replyto, message, NULL);
+
+    if(transfer_result < 0) {
+        drop_descriptors(replier);
+        return transfer_result;
+    }
+
+    install_descriptors(replyto, replier);
+
+    return transfer_result;
+}
+
+/**
+ * Reply to the current message and then receive the next one
+ *
+ * This function combines reply_to_message() and receive_message() so a server
+ * thread only needs to enter the kernel once per message.
+ *
+ * The send buffers pointed to by the message structure passed as argument
+ * contain the reply and the receive buffers will be used to receive the next
+ * message. If a sending thread is already waiting on the IPC endpoint, its
+ * message is received immediately without blocking. Otherwise, the receiving
+ * thread blocks and switches directly to the thread that was replied to.
+ *
+ * If the reply cannot be sent, this function fails without attempting to
+ * receive. Once the reply is sent, it is not undone if receiving fails.
+ *
+ * @param queue queues of the IPC endpoint or endpoint set from which to receive
+ * @param receiver thread replying to the current message and receiving the next
+ * @param flags IPC flags (JINUE_IPC_...)
+ * @param timeout timeout in ticks for receiving, zero for no timeout
+ * @param message structure describing the reply and the receive buffers
+ * @return received message size in bytes on success, negated error number on error
+ *
+ */
+int reply_and_receive_message(
+        ipc_queue_t         *queue,
+        thread_t            *receiver,
+        int                  flags,
+        uint32_t             timeout,
+        jinue_message_t     *message) {
+
+    if(receiver->sender == NULL && receiver->request == NULL) {
+        return_lent_pages(receiver);
+        return -JINUE_ENOMSG;
+    }
+
+    /* Check the receive buffers before replying: we don't want to send the
+     * reply and only then find out we cannot receive. */
+    int recv_buffer_size = get_receive_buffers_size(message);
+
+    if(recv_buffer_size < 0) {
+        return recv_buffer_size;
+    }
+
+    int status = reserve_descriptor_slots(receiver, message);
+
+    if(status < 0) {
+        return status;
+    }
+
+    thread_t *replyto = NULL;
+
+    if(receiver->request != NULL) {
+        int reply_result = reply_to_request(receiver, message);
+
+        if(reply_result < 0) {
+            free_descriptor_slots(receiver);
+            return reply_result;
+        }
+    }
+    else {
+        replyto = claim_sender(receiver);
+
+        if(replyto == NULL) {
+            free_descriptor_slots(receiver);
+            return_lent_pages(receiver);
+            return -JINUE_ENOMSG;
+        }
+
+        int transfer_result = transfer_reply(receiver, replyto, message);
+
+        if(transfer_result < 0) {
+            release_sender(receiver);
+            free_descriptor_slots(receiver);
+            return transfer_result;
+        }
+
+        replyto->message_size = transfer_result;
+    }
+
+    receiver->sender            = NULL;
+    receiver->recv_buffer_size  = recv_buffer_size;
+    receiver->message           = message;
+
+    int retval = do_receive_message(queue, receiver, replyto, flags, timeout);
+
+    cancel_ipc_timeout(receiver, timeout);
+
+    if(retval >= 0) {
+        set_received_message_info(message, receiver);
+        release_sender(receiver);
+    }
+
+    free_descriptor_slots(receiver);
+
+    return retval;
+}
+
+/**
+ * Complete a reply that was copied to the sending thread's receive buffers
+ *
+ * @param replier thread replying to the message
+ * @param replyto thread that sent the message
+ * @param reply_size size of the reply, in bytes
+ *
+ */
+static void complete_reply(thread_t *replier, thread_t *replyto, size_t reply_size) {
+    return_lent_pages(replier);
+
+    replyto->message_size   = reply_size;
+    replier->sender         = NULL;
+
+    /* switch back to sender thread to return from call immediately */
+    switch_to_thread(replyto);
+}
+
+/**
+ * Reply to a message
+ *
+ * This function is called by a receiving thread to end processing of the
+ * current message and send the reply to the sending thread.
+ *
+ * The send buffers pointed to by the message structure passed as argument
+ * contain the reply. Since the sending thread is blocked waiting for the
+ * reply, the reply is copied directly to its receive buffers. If the message
+ * is an asynchronous request, the reply is posted to the request's completion
+ * queue instead (see send_async_message()).
+ *
+ * @param replier thread replying to the message
+ * @param message structure describing the reply message
+ * @return zero on success, negated error number on error
+ *
+ */
+int reply_to_message(thread_t *replier, const jinue_message_t *message) {
+    if(replier->request != NULL) {
+        return reply_to_request(replier, message);
+    }
+
+    thread_t *replyto = claim_sender(replier);
+
+    if(replyto == NULL) {
+        return_lent_pages(replier);
+        return -JINUE_ENOMSG;
+    }
+
+    int transfer_result = transfer_reply(replier, replyto, message);
+
+    if(transfer_result < 0) {
+        release_sender(replier);
+        return transfer_result;
+    }
+
+    complete_reply(replier, replyto, transfer_result);
+
+    return 0;
+}
+
+/**
+ * Reply to a message with a short reply
+ *
+ * This function behaves like reply_to_message() except that the reply is made
+ * of the JINUE_SHORT_MESSAGE_WORDS data words passed as argument.
+ *
+ * @param replier thread replying to the message
+ * @param data reply data
+ * @return zero on success, negated error number on error
+ *
+ */
+int reply_short_message(thread_t *replier, const uintptr_t *data) {
+    ipc_request_t *request = replier->request;
+
+    if(request != NULL) {
+        if(JINUE_SHORT_MESSAGE_SIZE > request->recv_buffer_size) {
+            return -JINUE_E2BIG;
+        }
+
+        memcpy(request->buffer, data, JINUE_SHORT_MESSAGE_SIZE);
+
+        request->size       = JINUE_SHORT_MESSAGE_SIZE;
+        replier->request    = NULL;
+
+        complete_request(request, 0, 0);
+        return 0;
+    }
+
+    thread_t *replyto = claim_sender(replier);
+
+    if(replyto == NULL) {
+        return_lent_pages(replier);
+        return -JINUE_ENOMSG;
+    }
+
+    int transfer_result = transfer_short_message(replyto, data, JINUE_SHORT_MESSAGE_SIZE, NULL);
+
+    if(transfer_result < 0) {
+        release_sender(replier);
+        return transfer_result;
+    }
+
+    complete_reply(replier, replyto, transfer_result);
+
+    return 0;
+}
+
+
+/**
+ * Reply to a message with an error
+ *
+ * This function is called by a receiving thread to end processing of the
+ * current message and send an error code to the sending thread.
+ *
+ * @param replier thread replying to the message
+ * @param errcode error code
+ * @return zero on success, negated error number on error
+ *
+ */
+int reply_error_to_message(thread_t *replier, uintptr_t errcode) {
+    ipc_request_t *request = replier->request;
+
+    if(request != NULL) {
+        request->size       = 0;
+        replier->request    = NULL;
+
+        complete_request(request, JINUE_EPROTO, errcode);
+        return 0;
+    }
+
+    thread_t *replyto = claim_sender(replier);
+
+    return_lent_pages(replier);
+
+    if(replyto == NULL) {
+        return -JINUE_ENOMSG;
+    }
+
+    replyto->message_errno          = JINUE_EPROTO;
+    replyto->message_reply_errcode  = errcode;
+    replier->sender                 = NULL;
+    
+    /* switch back to sender thread to return from call immediately */
+    switch_to_thread(replyto);
+
+    return 0;
+}
+
+/**
+ * Acknowledge the current asynchronous request with an empty reply
+ *
+ * This completes the request so the receiving thread can go on receiving more
+ * requests when it receives them in batches. It does nothing if the receiving
+ * thread is not servicing a request, e.g. if it received a notification.
+ *
+ * @param receiver thread that received the request
+ *
+ */
+void acknowledge_request(thread_t *receiver) {
+    ipc_request_t *request = receiver->request;
+
+    if(request == NULL) {
+        return;
+    }
+
+    request->size       = 0;
+    receiver->request   = NULL;
+
+    complete_request(request, 0, 0);
+}
+
+/**
+ * Abort a send or receive operation in progress
+ *
+ * The send or receive operation fails with JINUE_EIO.
+ * 
+ * Situations that make calling this function necessary:
+ *  - The thread is queued on an IPC endpoint's send or receive queue and the
+ *    endpoint is being destroyed.
+ *  - The thread is waiting on a notification, completion queue or channel that
+ *    is being destroyed.
+ *
+ * The thread must have been dequeued with the lock of its queue held. If its
+ * operation is being timed out, it is left to the timeout to complete.
+ * 
+ * @param thread thread blocked on an IPC operation
+ *
+ */
+void abort_message(thread_t *thread) {
+    if(claim_message(thread)) {
+        abort_message_with_error(thread, JINUE_EIO);
+    }
+}
+
+/**
+ * Give up the current message of a thread without replying
+ *
+ * The sending thread's operation or the asynchronous request fails with
+ * JINUE_EIO and the pages lent to the thread are returned. This is done when
+ * the thread exits or receives another message without replying.
+ *
+ * @param receiver thread servicing a message, or not
+ *
+ */
+void abort_current_message(thread_t *receiver) {
+    thread_t *sender = claim_sender(receiver);
+
+    return_lent_pages(receiver);
+
+    if(sender != NULL) {
+        receiver->sender = NULL;
+        abort_message_with_error(sender, JINUE_EIO);
+    }
+
+    if(receiver->request != NULL) {
+        abort_request(receiver->request);
+        receiver->request = NULL;
+    }
 }
@@ -153,6 +153,79 @@ void *map_in_kernel(paddr_t paddr, size_t size, int prot, int flags) {
     return start + offset;
 }
 
+/**
+ * Permanently reserve virtual memory in the kernel's mapping area
+ *
+ * The reserved range is not mapped. The caller is responsible for mapping page
+ * frames in it as needed with machine_map_kernel(). This function panics if
+ * sufficient virtual memory cannot be reserved.
+ *
+ * The latest mapping established by map_in_kernel() can no longer be resized
+ * or undone after this function is called.
+ *
+ * This function is not thread safe and is intended to be called only during
+ * kernel initialization.
+ *
+ * @param size size of the range to reserve, cannot be zero
+ * @return start address of the reserved range
+ */
+addr_t reserve_in_kernel(size_t size) {
+    alloc_region_t *region = &normal_region;
+
+    size = (size_t)ALIGN_END(size, PAGE_SIZE);
+
+    if(size > region->size_remaining) {
+        panic("No more space to reserve memory in kernel");
+    }
+
+    addr_t start = region->addr;
+
+    region->addr            += size;
+    region->size_remaining  -= size;
+
+    alloc_state.region          = NULL;
+    alloc_state.latest_addr     = NULL;
+    alloc_state.latest_prot     = JINUE_PROT_NONE;
+    alloc_state.latest_flags    = JINUE_MAP_NONE;
+
+    return start;
+}
+
+/**
+ * Permanently reserve what remains of the kernel's large pages mapping area
+ *
+ * The reserved range is not mapped and is aligned on a large page boundary
+ * (see machine_large_page_size()). Once this function is called, map_in_kernel()
+ * can no longer map memory with large pages.
+ *
+ * This function is not thread safe and is intended to be called only once,
+ * at the end of kernel initialization.
+ *
+ * @param size (out) size of the reserved range, might be zero
+ * @return start address of the reserved range
+ */
+addr_t reserve_large_pages_in_kernel(size_t *size) {
+    alloc_region_t *region  = &large_pages_region;
+    size_t page_size        = machine_large_page_size();
+
+    addr_t start    = ALIGN_END_PTR(region->addr, page_size);
+    addr_t end      = (addr_t)LARGE_PAGES_AREA_ADDR + LARGE_PAGES_AREA_SIZE;
+
+    *size = ALIGN_START(end - start, page_size);
+
+    region->addr            = end;
+    region->size_remaining  = 0;
+
+    if(alloc_state.region == region) {
+        alloc_state.region          = NULL;
+        alloc_state.latest_addr     = NULL;
+        alloc_state.latest_prot     = JINUE_PROT_NONE;
+        alloc_state.latest_flags    = JINUE_MAP_NONE;
+    }
+
+    return start;
+}
+
 /**
  * Resize mapping established by the latest call to map_in_kernel()
  * 
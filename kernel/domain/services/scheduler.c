@@ -29,34 +29,441 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <jinue/shared/asm/thread.h>
 #include <kernel/domain/entities/process.h>
+#include <kernel/domain/entities/thread.h>
+#include <kernel/domain/services/logging.h>
 #include <kernel/domain/services/panic.h>
 #include <kernel/domain/services/scheduler.h>
+#include <kernel/domain/services/timer.h>
+#include <kernel/machine/atomic.h>
+#include <kernel/machine/smp.h>
 #include <kernel/machine/spinlock.h>
 #include <kernel/machine/thread.h>
+#include <kernel/machine/timer.h>
 #include <kernel/utils/list.h>
+#include <kernel/utils/utils.h>
+#include <stdint.h>
 
-/** ready threads queue with lock */
-static struct {
-    list_t          queue;
+/** queues of threads ready to run on a CPU, one per priority level, with lock
+ *
+ * Bit N of the bitmap is set if the queue for priority N is not empty, so the
+ * highest priority ready thread is found in constant time with a bit scan. */
+typedef struct {
+    list_t          queues[JINUE_PRIORITY_LEVELS];
+    uint32_t        bitmap;
+    int             length;
     spinlock_t      lock;
-} ready_queue = {
-    .queue  = LIST_INITIALIZER,
-    .lock   = SPINLOCK_INITIALIZER
+} run_queue_t;
+
+/** time slice, in timer ticks, for each priority level
+ *
+ * Higher priority threads tend to be interactive or latency-critical and to
+ * block before their time slice expires, so they get shorter time slices,
+ * whereas lower priority batch threads get longer ones to reduce the number of
+ * context switches. */
+static const int time_slices[JINUE_PRIORITY_LEVELS] = {
+    8, 8, 8, 8, 8, 8, 8, 8,
+    5, 5, 5, 5, 5, 5, 5, 5,
+    3, 3, 3, 3, 3, 3, 3, 3,
+    2, 2, 2, 2, 2, 2, 2, 2
 };
 
+/** ready threads queue of each CPU
+ *
+ * A thread is added to the queue of the CPU it last ran on if its affinity
+ * allows it, and to the queue of a CPU it may run on otherwise, so a CPU can
+ * run the thread at the head of its own queue without looking any further. An
+ * idle CPU steals threads from the busiest queue, and each CPU periodically
+ * pulls threads from the busiest queue if its own is much shorter. */
+static run_queue_t run_queues[MAX_CPUS];
+
+/** idle thread of each CPU, which runs when no other thread is ready to run */
+static thread_t *idle_threads[MAX_CPUS];
+
+/** scheduling state of a CPU
+ *
+ * The time slice belongs to the CPU rather than to the running thread: when a
+ * thread hands the CPU over to another one directly, e.g. to reply to a
+ * message, that thread runs for the rest of the time slice. */
+typedef struct {
+    /** tick at which the time slice of the running thread expires */
+    uint64_t        slice_end;
+    /** tick for which the timer is set, TIMER_NEVER if it is not set */
+    uint64_t        timer_deadline;
+    /** tick of the next load balancing pass */
+    uint64_t        next_balance;
+    /** effective priority of the running thread, -1 if the CPU is idle */
+    volatile int    priority;
+    /** whether the CPU is idle, must be set with swap_atomic() */
+    int             is_idle;
+    /** whether the time slice of the running thread has expired */
+    bool            slice_expired;
+} cpu_state_t;
+
+/** scheduling state of each CPU */
+static cpu_state_t cpu_states[MAX_CPUS];
+
+/**
+ * Get the idle thread of the current CPU
+ * 
+ * @return idle thread
+ *
+ */
+static thread_t *get_idle_thread(void) {
+    return idle_threads[machine_get_current_cpu()];
+}
+
+/**
+ * Get the ready threads queue of the current CPU
+ * 
+ * @return run queue
+ *
+ */
+static run_queue_t *get_run_queue(void) {
+    return &run_queues[machine_get_current_cpu()];
+}
+
+/**
+ * Get the scheduling state of the current CPU
+ * 
+ * @return scheduling state
+ *
+ */
+static cpu_state_t *get_cpu_state(void) {
+    return &cpu_states[machine_get_current_cpu()];
+}
+
+/**
+ * Check whether the affinity of a thread allows it to run on a CPU
+ * 
+ * @param thread the thread
+ * @param cpu index of the CPU
+ * @return true if the thread may run on the CPU, false otherwise
+ *
+ */
+static bool is_allowed(const thread_t *thread, int cpu) {
+    return (thread->affinity & ((uint32_t)1 << cpu)) != 0;
+}
+
+/**
+ * Make sure the timer of the current CPU interrupts in time
+ * 
+ * There is no periodic tick. Instead, the timer is set to interrupt when the
+ * time slice of the running thread expires or when the next timer expires,
+ * whichever comes first. While threads wait in the ready queue of the CPU,
+ * the timer also interrupts in time for the next load balancing pass. When the
+ * CPU is idle, its ready queue is empty and only timers matter, so the timer
+ * does not interrupt at all if there are none.
+ * 
+ * The timer is only set if it has to interrupt earlier than it already is set
+ * to. This way, switching between threads often, e.g. for IPC, does not require
+ * setting it each time. If the timer interrupts too early as a result, it is
+ * simply set again.
+ * 
+ * @param running thread that is running or about to run on the current CPU
+ *
+ */
+static void arm_timer(const thread_t *running) {
+    cpu_state_t *state  = get_cpu_state();
+    uint64_t deadline   = timer_get_next_expiry();
+
+    if(running != get_idle_thread() && !state->slice_expired && state->slice_end < deadline) {
+        deadline = state->slice_end;
+    }
+
+    if(get_run_queue()->length > 0 && state->next_balance < deadline) {
+        deadline = state->next_balance;
+    }
+
+    if(deadline < state->timer_deadline) {
+        state->timer_deadline = deadline;
+        machine_set_timer(deadline);
+    }
+}
+
+/**
+ * Mark a thread as running on the current CPU
+ * 
+ * @param thread the thread
+ *
+ */
+static void set_running(thread_t *thread) {
+    thread->state   = THREAD_STATE_RUNNING;
+    thread->cpu     = machine_get_current_cpu();
+
+    if(thread == get_idle_thread()) {
+        get_cpu_state()->priority = -1;
+    } else {
+        get_cpu_state()->priority = thread_get_priority(thread);
+    }
+
+    arm_timer(thread);
+}
+
+/**
+ * Get the priority of the highest priority thread in a ready queue
+ * 
+ * This function can be called without the lock held, in which case the result
+ * is only a hint.
+ * 
+ * @param run_queue the ready queue
+ * @return highest priority, -1 if the ready queue is empty
+ *
+ */
+static int get_highest_ready_priority(const run_queue_t *run_queue) {
+    uint32_t bitmap = run_queue->bitmap;
+
+    if(bitmap == 0) {
+        return -1;
+    }
+
+    return bit_scan_reverse(bitmap);
+}
+
+/**
+ * Add a thread to the tail of a ready queue at a given priority (without locking)
+ * 
+ * @param run_queue the ready queue
+ * @param thread the thread
+ * @param priority priority level
+ *
+ */
+static void enqueue_locked(run_queue_t *run_queue, thread_t *thread, int priority) {
+    list_enqueue(&run_queue->queues[priority], &thread->thread_list);
+    run_queue->bitmap |= (uint32_t)1 << priority;
+    ++run_queue->length;
+}
+
+/**
+ * Remove a thread from a ready queue at a given priority (without locking)
+ * 
+ * @param run_queue the ready queue
+ * @param priority priority level of the queue that contains the thread
+ * @param cur cursor that points to the thread
+ * @return the thread
+ *
+ */
+static thread_t *remove_locked(run_queue_t *run_queue, int priority, list_cursor_t cur) {
+    list_t *queue       = &run_queue->queues[priority];
+    thread_t *thread    = list_remove(queue, cur, thread_t, thread_list);
+
+    if(list_is_empty(queue)) {
+        run_queue->bitmap &= ~((uint32_t)1 << priority);
+    }
+
+    --run_queue->length;
+
+    return thread;
+}
+
+/**
+ * Remove the highest priority thread from a ready queue (without locking)
+ * 
+ * @param run_queue the ready queue
+ * @return thread ready to run, NULL if there are none
+ *
+ */
+static thread_t *dequeue_locked(run_queue_t *run_queue) {
+    int priority = get_highest_ready_priority(run_queue);
+
+    if(priority < 0) {
+        return NULL;
+    }
+
+    return remove_locked(run_queue, priority, list_head(&run_queue->queues[priority]));
+}
+
+/**
+ * Remove the highest priority thread that may run on a CPU from another CPU's ready queue (without locking)
+ * 
+ * Only the thread at the head of each priority level is considered, so this
+ * takes at most one step per priority level however long the queues are. A
+ * thread that is passed over because of its affinity still runs on the CPU
+ * that owns the queue.
+ * 
+ * @param run_queue the ready queue
+ * @param cpu index of the CPU on which the thread is to run
+ * @param priority set to the priority level of the thread
+ * @return thread ready to run, NULL if there are none
+ *
+ */
+static thread_t *dequeue_allowed_locked(run_queue_t *run_queue, int cpu, int *priority) {
+    uint32_t bitmap = run_queue->bitmap;
+
+    while(bitmap != 0) {
+        int level           = bit_scan_reverse(bitmap);
+        list_cursor_t cur   = list_head(&run_queue->queues[level]);
+
+        if(is_allowed(list_cursor_entry(cur, thread_t, thread_list), cpu)) {
+            *priority = level;
+            return remove_locked(run_queue, level, cur);
+        }
+
+        bitmap &= ~((uint32_t)1 << level);
+    }
+
+    return NULL;
+}
+
 /**
- * Get the thread at the head of the ready queue
+ * Remove a specific thread from a ready queue (without locking)
  * 
+ * @param run_queue the ready queue
+ * @param thread the thread
+ * @return true if the thread was in the ready queue, false otherwise
+ *
+ */
+static bool remove_thread_locked(run_queue_t *run_queue, const thread_t *thread) {
+    uint32_t bitmap = run_queue->bitmap;
+
+    while(bitmap != 0) {
+        int level       = bit_scan_reverse(bitmap);
+        list_t *queue   = &run_queue->queues[level];
+
+        for(list_cursor_t cur = list_head(queue); *cur != NULL; cur = list_cursor_next(cur)) {
+            if(list_cursor_entry(cur, thread_t, thread_list) == thread) {
+                remove_locked(run_queue, level, cur);
+                return true;
+            }
+        }
+
+        bitmap &= ~((uint32_t)1 << level);
+    }
+
+    return false;
+}
+
+/**
+ * Get the highest priority thread in the ready queue of the current CPU
+ * 
+ * set_thread_affinity() moves a queued thread when its affinity changes, but
+ * it can miss a thread that is being queued at the same time. Such a thread is
+ * moved to a CPU it may run on when it reaches the head of the queue.
+ * 
+ * @param run_queue the ready queue
  * @return thread ready to run, NULL if there are none
  *
  */
-static thread_t *dequeue_ready_thread(void) {
-    spin_lock(&ready_queue.lock);
+static thread_t *dequeue_ready_thread(run_queue_t *run_queue) {
+    while(true) {
+        spin_lock(&run_queue->lock);
+
+        thread_t *thread = dequeue_locked(run_queue);
+
+        spin_unlock(&run_queue->lock);
+
+        if(thread == NULL || is_allowed(thread, machine_get_current_cpu())) {
+            return thread;
+        }
+
+        ready_thread(thread);
+    }
+}
+
+/**
+ * Start a new time slice on the current CPU based on the priority of a thread
+ * 
+ * @param thread the thread that is about to run
+ *
+ */
+static void start_time_slice(const thread_t *thread) {
+    cpu_state_t *state = get_cpu_state();
+
+    state->slice_end        = machine_get_ticks() + time_slices[thread_get_priority(thread)];
+    state->slice_expired    = false;
+}
+
+/**
+ * Choose the CPU on which a thread that becomes ready to run is queued
+ * 
+ * The CPU the thread last ran on is preferred since its working set might
+ * still be cached there, unless that CPU is busy while another one is idle.
+ * The affinity of the thread is always honoured.
+ * 
+ * The idle flags are read without synchronization, so an idle CPU found this
+ * way might already be busy by the time the thread is queued.
+ * 
+ * @param thread the thread
+ * @return index of the CPU
+ *
+ */
+static int select_cpu(const thread_t *thread) {
+    int last = thread->cpu;
+
+    if(is_allowed(thread, last) && cpu_states[last].is_idle) {
+        return last;
+    }
+
+    int first_allowed = -1;
+
+    for(int cpu = 0; cpu < machine_get_cpu_count(); ++cpu) {
+        if(!is_allowed(thread, cpu)) {
+            continue;
+        }
+
+        if(cpu_states[cpu].is_idle) {
+            return cpu;
+        }
+
+        if(first_allowed < 0) {
+            first_allowed = cpu;
+        }
+    }
+
+    if(is_allowed(thread, last) || first_allowed < 0) {
+        return last;
+    }
+
+    return first_allowed;
+}
+
+/**
+ * Find the CPU with the most threads ready to run
+ * 
+ * The queue lengths are read without taking the locks, so the result is only
+ * a hint and the queue might be empty by the time it is locked.
+ * 
+ * @return index of the busiest CPU, -1 if all ready queues are empty
+ *
+ */
+static int find_busiest_cpu(void) {
+    int busiest = -1;
+    int longest = 0;
 
-    thread_t *thread = list_dequeue(&ready_queue.queue, thread_t, thread_list);
+    for(int cpu = 0; cpu < machine_get_cpu_count(); ++cpu) {
+        int length = run_queues[cpu].length;
 
-    spin_unlock(&ready_queue.lock);
+        if(length > longest) {
+            busiest = cpu;
+            longest = length;
+        }
+    }
+
+    return busiest;
+}
+
+/**
+ * Steal a thread ready to run from the busiest CPU
+ * 
+ * @return thread ready to run, NULL if there are none
+ *
+ */
+static thread_t *steal_ready_thread(void) {
+    int busiest = find_busiest_cpu();
+
+    if(busiest < 0) {
+        return NULL;
+    }
+
+    run_queue_t *run_queue = &run_queues[busiest];
+    int priority;
+
+    spin_lock(&run_queue->lock);
+
+    thread_t *thread = dequeue_allowed_locked(run_queue, machine_get_current_cpu(), &priority);
+
+    spin_unlock(&run_queue->lock);
 
     return thread;
 }
@@ -69,95 +476,323 @@ static thread_t *dequeue_ready_thread(void) {
  *
  */
 static thread_t *select_next_ready_thread(bool current_can_run) {
-    thread_t *to = dequeue_ready_thread();
+    thread_t *current       = get_current_thread();
+    run_queue_t *run_queue  = get_run_queue();
+    thread_t *to            = NULL;
+
+    /* Threads of the same priority take turns but a lower priority thread
+     * does not get to run while the current one can. */
+    if(!current_can_run || get_highest_ready_priority(run_queue) >= thread_get_priority(current)) {
+        to = dequeue_ready_thread(run_queue);
+    }
     
     if(to == NULL && current_can_run) {
-        to = get_current_thread();
+        to = current;
     }
 
     if(to == NULL) {
-        /* Currently, scheduling is purely cooperative and only one CPU is
-         * supported (so, there are no threads currently running on other
-         * CPUs). What this means is that, once there are no more threads
-         * running or ready to run, this situation will never change. */
-        panic("No thread to schedule");
+        to = steal_ready_thread();
     }
 
-    to->cpu_credits += SCHEDULER_BASE_CREDITS;
+    if(to == NULL) {
+        /* A thread running on another CPU or a timer can make a thread ready
+         * to run later. In the meantime, this CPU runs its idle thread. */
+        return get_idle_thread();
+    }
+
+    start_time_slice(to);
 
     return to;
 }
 
 /**
- * Add a thread to the ready queue (without locking)
+ * Add a thread to a ready queue (without locking)
  * 
  * This funtion contains the business logic for ready_thread() without the
  * locking. Some functions beside ready_thread() that need to block and then
  * unlock call it, hence why it is a separate function.
  * 
+ * @param run_queue the ready queue
  * @param thread the thread
  *
  */
-static void thread_ready_locked(thread_t *thread) {
+static void thread_ready_locked(run_queue_t *run_queue, thread_t *thread) {
     thread->state = THREAD_STATE_READY;
 
-    /* add thread to the tail of the ready list to give other threads a chance to run */
-    list_enqueue(&ready_queue.queue, &thread->thread_list);
+    /* Add thread to the tail of the ready list for its priority to give other
+     * threads a chance to run. The effective priority is used so a server that
+     * services a message for a high priority client is scheduled accordingly. */
+    enqueue_locked(run_queue, thread, thread_get_priority(thread));
 }
 
 
+/**
+ * Switch to another thread and add the current thread to a ready queue
+ * 
+ * The current thread is added to the ready queue of the current CPU unless its
+ * affinity no longer allows it to run there. In that case, it is added to the
+ * ready queue of another CPU, which is woken up to take it.
+ * 
+ * In either case, the ready queue is unlocked only after the switch so no
+ * other CPU can run the current thread before this one is done with it.
+ * 
+ * @param current the current thread
+ * @param to thread to switch to, already set as running
+ *
+ */
+static void switch_and_ready_current(thread_t *current, thread_t *to) {
+    int cpu         = machine_get_current_cpu();
+    bool migrate    = !is_allowed(current, cpu);
+
+    if(migrate) {
+        cpu = select_cpu(current);
+    }
+
+    run_queue_t *run_queue = &run_queues[cpu];
+
+    spin_lock(&run_queue->lock);
+
+    current->cpu = cpu;
+    thread_ready_locked(run_queue, current);
+
+    if(migrate) {
+        /* That CPU cannot take the thread until the lock is released. */
+        machine_wake_cpu(cpu);
+    }
+
+    machine_switch_thread_and_unlock(current, to, &run_queue->lock);
+}
+
 /**
  * Preempt the current thread if it's time
+ * 
+ * The current thread is preempted once its time slice has expired, or as soon
+ * as a thread with a higher priority becomes ready to run on this CPU.
  */
 void reschedule(void) {
     thread_t *current = get_current_thread();
 
-    if(current->cpu_credits > 0) {
+    /* The idle thread switches to ready threads by itself. */
+    if(current == get_idle_thread()) {
         return;
     }
 
-    thread_t *to = select_next_ready_thread(true);
+    /* The affinity of the current thread might have changed since it started
+     * running, in which case it has to move to another CPU. */
+    bool can_run = is_allowed(current, machine_get_current_cpu());
+
+    if(can_run && !get_cpu_state()->slice_expired &&
+            get_highest_ready_priority(get_run_queue()) <= thread_get_priority(current)) {
+        arm_timer(current);
+        return;
+    }
+
+    thread_t *to = select_next_ready_thread(can_run);
 
     if(to == current) {
+        arm_timer(current);
         return;
     }
 
-    to->state = THREAD_STATE_RUNNING;
+    set_running(to);
 
     if(current->process != to->process) {
         process_switch_to(to->process);
     }
 
-    spin_lock(&ready_queue.lock);
+    switch_and_ready_current(current, to);
+}
+
+/**
+ * Pull threads from the busiest CPU if its ready queue is much longer
+ * 
+ * Threads are moved until the length of the two ready queues differ by at
+ * most one.
+ * 
+ * @param cpu index of the current CPU
+ *
+ */
+static void balance_load(int cpu) {
+    int busiest = find_busiest_cpu();
+
+    if(busiest < 0 || busiest == cpu) {
+        return;
+    }
+
+    run_queue_t *local  = &run_queues[cpu];
+    run_queue_t *remote = &run_queues[busiest];
+
+    /* Always lock the two queues in the same order to prevent deadlocks. */
+    run_queue_t *first  = (cpu < busiest) ? local : remote;
+    run_queue_t *second = (cpu < busiest) ? remote : local;
 
-    thread_ready_locked(current);
+    spin_lock(&first->lock);
+    spin_lock(&second->lock);
 
-    machine_switch_thread_and_unlock(current, to, &ready_queue.lock);
+    while(remote->length - local->length > 1) {
+        int priority;
+        thread_t *thread = dequeue_allowed_locked(remote, cpu, &priority);
+
+        if(thread == NULL) {
+            break;
+        }
+
+        thread->cpu = cpu;
+        enqueue_locked(local, thread, priority);
+    }
+
+    spin_unlock(&second->lock);
+    spin_unlock(&first->lock);
 }
 
 /**
- * Decrement current thread CPU credits due to timer tick
+ * Wake up an idle CPU if threads are waiting in the ready queue of a CPU
+ * 
+ * An idle CPU does not take part in load balancing since its timer does not
+ * interrupt, so busy CPUs wake it up to have it steal a thread.
+ * 
+ * @param cpu index of the CPU
+ *
  */
-void scheduler_tick(void) {
-    thread_t *current = get_current_thread();
+static void wake_idle_cpu(int cpu) {
+    if(run_queues[cpu].length == 0) {
+        return;
+    }
+
+    for(int other = 0; other < machine_get_cpu_count(); ++other) {
+        if(other != cpu && cpu_states[other].is_idle) {
+            machine_wake_cpu(other);
+            return;
+        }
+    }
+}
+
+/**
+ * Handle a timer interrupt on the current CPU
+ * 
+ * This checks whether the time slice of the running thread has expired, in
+ * which case it is preempted by reschedule() on the way out of the interrupt.
+ * This is also where load balancing between CPUs is done periodically.
+ * 
+ * @param now current tick count
+ */
+void scheduler_tick(uint64_t now) {
+    cpu_state_t *state = get_cpu_state();
 
-    if(current->cpu_credits > 0) {
-        --current->cpu_credits;
+    /* The timer interrupts only once each time it is set. */
+    state->timer_deadline = TIMER_NEVER;
+
+    if(now >= state->slice_end) {
+        state->slice_expired = true;
+    }
+
+    if(now >= state->next_balance) {
+        int cpu = machine_get_current_cpu();
+
+        state->next_balance = now + SCHEDULER_BALANCE_TICKS;
+        balance_load(cpu);
+        wake_idle_cpu(cpu);
     }
 }
 
 /**
  * Add a thread to the ready queue
  * 
+ * If the thread is added to the ready queue of another CPU, that CPU is
+ * interrupted if it is idle or if the thread has a higher priority than the
+ * thread running on it. Otherwise, the thread runs on that CPU at the latest
+ * when the current time slice expires.
+ * 
+ * This function must not be called with a ready queue lock held since it may
+ * have to wait for another CPU to finish switching away from the thread.
+ * 
  * @param thread the thread
  *
  */
 void ready_thread(thread_t *thread) {
-    spin_lock(&ready_queue.lock);
+    /* The thread might have been woken up while the CPU it ran on is still
+     * switching away from it. */
+    machine_wait_thread_off_cpu(thread);
+
+    int cpu = select_cpu(thread);
+
+    run_queue_t *run_queue  = &run_queues[cpu];
+    cpu_state_t *state      = &cpu_states[cpu];
+    int priority            = thread_get_priority(thread);
+
+    spin_lock(&run_queue->lock);
+
+    /* set under the lock, see set_thread_affinity() */
+    thread->cpu = cpu;
+    thread_ready_locked(run_queue, thread);
+
+    /* The idle flag is read atomically, which is a full memory barrier, after
+     * adding the thread to the queue (see idle_loop()). */
+    bool wake_up = cpu != machine_get_current_cpu() &&
+        (add_atomic(&state->is_idle, 0) || priority > state->priority);
 
-    thread_ready_locked(thread);
+    spin_unlock(&run_queue->lock);
 
-    spin_unlock(&ready_queue.lock);
+    if(wake_up) {
+        machine_wake_cpu(cpu);
+    }
+}
+
+/**
+ * Set the CPUs on which a thread may run
+ * 
+ * If the thread is waiting in the ready queue of a CPU that is no longer
+ * allowed, it is moved to another one. If it is running on such a CPU, it
+ * moves the next time it is preempted or blocks, which is made to happen soon
+ * by interrupting that CPU.
+ * 
+ * @param thread the thread
+ * @param affinity bit mask of allowed CPUs, must allow at least one CPU
+ *
+ */
+void set_thread_affinity(thread_t *thread, uint32_t affinity) {
+    thread->affinity = affinity;
+
+    /* The thread can move to another CPU at any time, but its cpu member is
+     * only changed with the lock of the ready queue of that CPU held when it
+     * is queued there. The CPU is read again under the lock and this is
+     * retried if the thread moved. */
+    while(true) {
+        int cpu = thread->cpu;
+
+        if(is_allowed(thread, cpu)) {
+            return;
+        }
+
+        run_queue_t *run_queue = &run_queues[cpu];
+
+        spin_lock(&run_queue->lock);
+
+        if(thread->cpu != cpu) {
+            spin_unlock(&run_queue->lock);
+            continue;
+        }
+
+        bool was_queued = remove_thread_locked(run_queue, thread);
+        bool is_running = (thread->state == THREAD_STATE_RUNNING);
+
+        spin_unlock(&run_queue->lock);
+
+        if(was_queued) {
+            ready_thread(thread);
+            return;
+        }
+
+        if(is_running && cpu != machine_get_current_cpu()) {
+            machine_wake_cpu(cpu);
+        }
+
+        /* Another CPU might have taken the thread from the queue just before
+         * it was locked, in which case the thread starts running there. */
+        if(thread->cpu == cpu) {
+            return;
+        }
+    }
 }
 
 /**
@@ -169,8 +804,7 @@ void ready_thread(thread_t *thread) {
 void yield_current_thread(void) {
     /* This defers the thread switch to the next time reschedule() is called,
      * which will happen at the end of the system call. */
-    thread_t *current   = get_current_thread();
-    current->cpu_credits    = 0;
+    get_cpu_state()->slice_expired = true;
 }
 
 /**
@@ -184,29 +818,48 @@ void yield_current_thread(void) {
 void switch_to_thread(thread_t *to) {
     thread_t *current   = get_current_thread();
 
-    to->state           = THREAD_STATE_RUNNING;
+    machine_wait_thread_off_cpu(to);
 
-    if(current->process != to->process) {
-        process_switch_to(to->process);
+    if(!is_allowed(to, machine_get_current_cpu())) {
+        /* The thread cannot run here, so it is handed over to another CPU
+         * and the current thread continues. */
+        ready_thread(to);
+        return;
     }
 
-    spin_lock(&ready_queue.lock);
+    set_running(to);
 
-    thread_ready_locked(current);
+    if(current->process != to->process) {
+        process_switch_to(to->process);
+    }
 
-    machine_switch_thread_and_unlock(current, to, &ready_queue.lock);
+    switch_and_ready_current(current, to);
 }
 
 /**
  * Switch to another thread and block the current thread
  * 
+ * No lock is held across the switch, so the current thread can be woken up
+ * by another CPU before this one is done switching away from it. This is safe
+ * because a thread is only made ready to run or switched to once the CPU it
+ * ran on is done with it (see machine_wait_thread_off_cpu()).
+ * 
  * @param to thread to switch to
  *
  */
 void switch_to_thread_and_block(thread_t *to) {
     thread_t *current   = get_current_thread();
+
+    machine_wait_thread_off_cpu(to);
+
     current->state      = THREAD_STATE_BLOCKED;
-    to->state           = THREAD_STATE_RUNNING;
+
+    if(!is_allowed(to, machine_get_current_cpu())) {
+        ready_thread(to);
+        to = select_next_ready_thread(false);
+    }
+
+    set_running(to);
 
     if(current->process != to->process) {
         process_switch_to(to->process);
@@ -215,6 +868,38 @@ void switch_to_thread_and_block(thread_t *to) {
     machine_switch_thread(current, to);
 }
 
+/**
+ * Switch to another thread, block the current thread and then unlock a lock
+ *
+ * This function does the same thing as block_current_thread_and_unlock()
+ * except that the thread to switch to is specified explicitly instead of
+ * being taken from the ready queue.
+ *
+ * @param to thread to switch to
+ * @param lock the lock to unlock after switching thread
+ *
+ */
+void switch_to_thread_block_and_unlock(thread_t *to, spinlock_t *lock) {
+    thread_t *current   = get_current_thread();
+
+    machine_wait_thread_off_cpu(to);
+
+    current->state      = THREAD_STATE_BLOCKED;
+
+    if(!is_allowed(to, machine_get_current_cpu())) {
+        ready_thread(to);
+        to = select_next_ready_thread(false);
+    }
+
+    set_running(to);
+
+    if(current->process != to->process) {
+        process_switch_to(to->process);
+    }
+
+    machine_switch_thread_and_unlock(current, to, lock);
+}
+
 /**
  * Block the current thread and then unlock a lock
  * 
@@ -235,7 +920,7 @@ void block_current_thread_and_unlock(spinlock_t *lock) {
     current->state      = THREAD_STATE_BLOCKED;
 
     thread_t *to        = select_next_ready_thread(false);
-    to->state           = THREAD_STATE_RUNNING;
+    set_running(to);
 
     if(current->process != to->process) {
         process_switch_to(to->process);
@@ -254,7 +939,7 @@ void switch_from_exiting_thread(void) {
     thread_t *current   = get_current_thread();
     
     thread_t *to        = select_next_ready_thread(false);
-    to->state           = THREAD_STATE_RUNNING;
+    set_running(to);
     
     if(current->process != to->process) {
         process_switch_to(to->process);
@@ -271,3 +956,114 @@ void switch_from_exiting_thread(void) {
      * want to do while it is still running. */
     machine_switch_and_unref_thread(current, to);
 }
+
+/**
+ * Idle thread entry point
+ * 
+ * Each CPU has an idle thread that runs when no other thread is ready to run
+ * on it. The idle thread waits for a thread to become ready and switches to
+ * it. It does not belong to any process and runs in the initial address space.
+ */
+static void idle_loop(void) {
+    thread_t *idle          = get_current_thread();
+    cpu_state_t *state      = get_cpu_state();
+    run_queue_t *run_queue  = get_run_queue();
+
+    while(true) {
+        /* The idle flag is set atomically, which is a full memory barrier,
+         * before checking the ready queue. This way, if another CPU makes a
+         * thread ready to run on this one, either this CPU finds the thread in
+         * its queue or the other CPU sees the flag and wakes this one up. */
+        swap_atomic(&state->is_idle, true);
+
+        thread_t *to = dequeue_ready_thread(run_queue);
+
+        if(to == NULL) {
+            to = steal_ready_thread();
+        }
+
+        if(to == NULL) {
+            arm_timer(idle);
+
+            /* Threads that another CPU makes ready to run on this one are
+             * added to its ready queue, so watch the length of that queue. */
+            machine_idle(&run_queue->length);
+            continue;
+        }
+
+        swap_atomic(&state->is_idle, false);
+
+        start_time_slice(to);
+
+        set_running(to);
+
+        process_switch_to(to->process);
+
+        machine_switch_thread(idle, to);
+    }
+}
+
+/**
+ * Initialize the ready queues, create the idle threads and start the other CPUs
+ * 
+ * This function is called once on the bootstrap processor during kernel
+ * initialization. The other CPUs run their idle thread until threads become
+ * ready to run.
+ */
+void scheduler_start_cpus(void) {
+    const int count = machine_get_cpu_count();
+
+    for(int cpu = 0; cpu < count; ++cpu) {
+        run_queue_t *run_queue = &run_queues[cpu];
+
+        for(int priority = 0; priority < JINUE_PRIORITY_LEVELS; ++priority) {
+            init_list(&run_queue->queues[priority]);
+        }
+
+        init_spinlock(&run_queue->lock);
+        run_queue->bitmap = 0;
+        run_queue->length = 0;
+
+        cpu_state_t *state      = &cpu_states[cpu];
+        state->slice_end        = 0;
+        state->slice_expired    = false;
+        state->timer_deadline   = TIMER_NEVER;
+        state->next_balance     = SCHEDULER_BALANCE_TICKS;
+        state->priority         = -1;
+        state->is_idle          = false;
+    }
+
+    /* A CPU that fails to start is dropped by machine_start_cpu() and the next
+     * CPU takes its index, so the CPU count is checked on each iteration. */
+    thread_t *idle  = NULL;
+    int cpu         = 0;
+
+    while(cpu < machine_get_cpu_count()) {
+        if(idle == NULL) {
+            idle = thread_new(NULL);
+
+            if(idle == NULL) {
+                panic("Could not create idle thread");
+            }
+        }
+
+        idle->state         = THREAD_STATE_RUNNING;
+        idle->cpu           = cpu;
+
+        machine_prepare_idle_thread(idle, idle_loop);
+
+        if(cpu > 0 && !machine_start_cpu(cpu, idle)) {
+            /* Retry with the next CPU, which now has this index. */
+            continue;
+        }
+
+        idle_threads[cpu++] = idle;
+        idle                = NULL;
+    }
+
+    if(idle != NULL) {
+        machine_free_thread(idle);
+    }
+
+    info("%d CPU(s) online.", machine_get_cpu_count());
+}
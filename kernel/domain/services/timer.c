@@ -0,0 +1,435 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <kernel/domain/services/timer.h>
+#include <kernel/machine/spinlock.h>
+#include <kernel/machine/timer.h>
+#include <stddef.h>
+
+/* Timers are kept in a hierarchical timer wheel. Level 0 has one slot per tick
+ * for the next TIMER_WHEEL_SLOTS ticks. Each slot of the next level covers as
+ * many ticks as the whole previous level. Every time level 0 wraps around, the
+ * timers in the next slot of level 1 are redistributed ("cascaded") to the
+ * lower levels, and so on. Starting and cancelling a timer are both O(1).
+ *
+ * There is no periodic tick. The wheel is advanced to the current tick count
+ * whenever a timer interrupt occurs, and the CPUs set their timer for the next
+ * tick at which the wheel has something to do, i.e. a timer expires or a slot
+ * has to be cascaded. */
+
+/** number of bits of the expiry tick used to index a slot at each level */
+#define TIMER_WHEEL_BITS    6
+
+/** number of slots per level */
+#define TIMER_WHEEL_SLOTS   (1 << TIMER_WHEEL_BITS)
+
+/** mask for the slot index */
+#define TIMER_WHEEL_MASK    (TIMER_WHEEL_SLOTS - 1)
+
+/** number of levels */
+#define TIMER_WHEEL_LEVELS  4
+
+/** longest delay the wheel can represent, longer delays are cascaded again */
+#define TIMER_MAX_DELAY     ((UINT32_C(1) << (TIMER_WHEEL_LEVELS * TIMER_WHEEL_BITS)) - 1)
+
+/** timer wheel with lock */
+static struct {
+    timer_t     *slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+    uint64_t     next_tick;
+    uint64_t     next_expiry;
+    int          count;
+    spinlock_t   lock;
+} wheel = {
+    .next_tick      = 0,
+    .next_expiry    = TIMER_NEVER,
+    .count          = 0,
+    .lock           = SPINLOCK_INITIALIZER
+};
+
+/**
+ * Initialize a timer
+ *
+ * @param timer the timer
+ * @param func function called when the timer expires
+ *
+ */
+void initialize_timer(timer_t *timer, timer_func_t func) {
+    timer->next         = NULL;
+    timer->pprev        = NULL;
+    timer->expires      = 0;
+    timer->func         = func;
+    timer->is_running   = false;
+}
+
+/**
+ * Check whether a timer is pending
+ *
+ * Must be called with the wheel lock held.
+ *
+ * @param timer the timer
+ * @return true if the timer is pending, false otherwise
+ *
+ */
+static bool is_pending(const timer_t *timer) {
+    return timer->pprev != NULL;
+}
+
+/**
+ * Insert a timer at the head of a list
+ *
+ * @param head head of the list
+ * @param timer the timer
+ *
+ */
+static void link_timer(timer_t **head, timer_t *timer) {
+    timer->next     = *head;
+    timer->pprev    = head;
+
+    if(*head != NULL) {
+        (*head)->pprev = &timer->next;
+    }
+
+    *head = timer;
+}
+
+/**
+ * Remove a timer from the list it is in
+ *
+ * @param timer the timer
+ *
+ */
+static void unlink_timer(timer_t *timer) {
+    *timer->pprev = timer->next;
+
+    if(timer->next != NULL) {
+        timer->next->pprev = timer->pprev;
+    }
+
+    timer->next     = NULL;
+    timer->pprev    = NULL;
+
+    --wheel.count;
+}
+
+/**
+ * Add a timer to the slot of the wheel that matches its expiry tick
+ *
+ * Must be called with the wheel lock held.
+ *
+ * @param timer the timer
+ *
+ */
+static void add_timer_locked(timer_t *timer) {
+    uint64_t delay = 0;
+
+    if(timer->expires > wheel.next_tick) {
+        delay = timer->expires - wheel.next_tick;
+    }
+
+    if(delay > TIMER_MAX_DELAY) {
+        delay = TIMER_MAX_DELAY;
+    }
+
+    int level = 0;
+
+    while(delay >= (UINT64_C(1) << ((level + 1) * TIMER_WHEEL_BITS))) {
+        ++level;
+    }
+
+    uint64_t when   = wheel.next_tick + delay;
+    int index       = (when >> (level * TIMER_WHEEL_BITS)) & TIMER_WHEEL_MASK;
+
+    link_timer(&wheel.slots[level][index], timer);
+}
+
+/**
+ * Start a timer
+ *
+ * If the timer is already pending, it is restarted with the new delay. The
+ * timer function is called from the timer interrupt handler once the tick
+ * count has advanced by the specified number of ticks.
+ *
+ * The timer of the current CPU is not set here. This is done by the scheduler
+ * on the way back to user space (see timer_get_next_expiry()).
+ *
+ * @param timer the timer
+ * @param ticks delay in ticks
+ *
+ */
+void start_timer(timer_t *timer, uint32_t ticks) {
+    uint64_t now = machine_get_ticks();
+
+    spin_lock(&wheel.lock);
+
+    if(is_pending(timer)) {
+        unlink_timer(timer);
+    }
+
+    /* The wheel is not advanced while it is empty, so it might be lagging
+     * behind. Since there is nothing to cascade, it can skip ahead. */
+    if(wheel.count == 0 && wheel.next_tick < now) {
+        wheel.next_tick = now;
+    }
+
+    /* The current tick is already partly elapsed. */
+    timer->expires = now + 1 + ticks;
+    add_timer_locked(timer);
+    ++wheel.count;
+
+    if(timer->expires < wheel.next_expiry) {
+        wheel.next_expiry = timer->expires;
+    }
+
+    spin_unlock(&wheel.lock);
+}
+
+/**
+ * Cancel a timer
+ *
+ * It is safe to call this function on a timer that already expired or that
+ * was never started. If the timer expired and its function is being called on
+ * another CPU, this function waits for it to return, so the caller can reuse
+ * or free the timer once this function returns. For this reason, it must not
+ * be called by the timer function itself.
+ *
+ * @param timer the timer
+ * @return true if the timer was pending, false otherwise
+ *
+ */
+bool cancel_timer(timer_t *timer) {
+    spin_lock(&wheel.lock);
+
+    bool was_pending = is_pending(timer);
+
+    if(was_pending) {
+        unlink_timer(timer);
+    }
+
+    /* The lock is a ticket lock, so the CPU calling the timer function gets
+     * its turn to take it and clear the flag. */
+    while(timer->is_running) {
+        spin_unlock(&wheel.lock);
+        spin_lock(&wheel.lock);
+    }
+
+    spin_unlock(&wheel.lock);
+
+    return was_pending;
+}
+
+/**
+ * Redistribute the timers of a slot to the lower levels of the wheel
+ *
+ * Must be called with the wheel lock held.
+ *
+ * @param level level of the slot
+ * @param index index of the slot
+ *
+ */
+static void cascade(int level, int index) {
+    timer_t *timer = wheel.slots[level][index];
+
+    wheel.slots[level][index] = NULL;
+
+    while(timer != NULL) {
+        timer_t *next = timer->next;
+        add_timer_locked(timer);
+        timer = next;
+    }
+}
+
+/**
+ * Find the first tick at which a slot has to be cascaded
+ *
+ * Must be called with the wheel lock held.
+ *
+ * @param level level of the slots, at least one
+ * @return tick, TIMER_NEVER if all slots of the level are empty
+ *
+ */
+static uint64_t find_next_cascade(int level) {
+    int shift       = level * TIMER_WHEEL_BITS;
+    uint64_t period = UINT64_C(1) << shift;
+
+    /* Slots of this level are cascaded when the lower levels wrap around. */
+    uint64_t tick   = (wheel.next_tick + period - 1) & ~(period - 1);
+
+    for(int n = 0; n < TIMER_WHEEL_SLOTS; ++n, tick += period) {
+        if(wheel.slots[level][(tick >> shift) & TIMER_WHEEL_MASK] != NULL) {
+            return tick;
+        }
+    }
+
+    return TIMER_NEVER;
+}
+
+/**
+ * Find the next tick at which the wheel has something to do
+ *
+ * Must be called with the wheel lock held.
+ *
+ * @return tick, TIMER_NEVER if there are no pending timers
+ *
+ */
+static uint64_t find_next_expiry(void) {
+    if(wheel.count == 0) {
+        return TIMER_NEVER;
+    }
+
+    uint64_t next = TIMER_NEVER;
+
+    for(int n = 0; n < TIMER_WHEEL_SLOTS; ++n) {
+        uint64_t tick = wheel.next_tick + n;
+
+        if(wheel.slots[0][tick & TIMER_WHEEL_MASK] != NULL) {
+            next = tick;
+            break;
+        }
+    }
+
+    for(int level = 1; level < TIMER_WHEEL_LEVELS; ++level) {
+        uint64_t tick = find_next_cascade(level);
+
+        if(tick < next) {
+            next = tick;
+        }
+    }
+
+    /* Timers that expired but whose function has not been called yet are
+     * not in the wheel. Their function is about to be called anyway. */
+    if(next == TIMER_NEVER) {
+        next = wheel.next_tick;
+    }
+
+    return next;
+}
+
+/**
+ * Process the timers of the current tick of the wheel and advance it
+ *
+ * Must be called with the wheel lock held. The lock is released while timer
+ * functions are called, so they can start and cancel other timers.
+ *
+ */
+static void advance_wheel_locked(void) {
+    for(int level = 1; level < TIMER_WHEEL_LEVELS; ++level) {
+        int shift = (level - 1) * TIMER_WHEEL_BITS;
+
+        if(((wheel.next_tick >> shift) & TIMER_WHEEL_MASK) != 0) {
+            break;
+        }
+
+        cascade(level, (wheel.next_tick >> (shift + TIMER_WHEEL_BITS)) & TIMER_WHEEL_MASK);
+    }
+
+    int index           = wheel.next_tick & TIMER_WHEEL_MASK;
+    timer_t *expired    = wheel.slots[0][index];
+
+    wheel.slots[0][index] = NULL;
+
+    if(expired != NULL) {
+        /* Move the expired timers to a local list. Cancelling one of them while
+         * the lock is released below then removes it from that list. */
+        expired->pprev = &expired;
+    }
+
+    ++wheel.next_tick;
+
+    while(expired != NULL) {
+        timer_t *timer = expired;
+        unlink_timer(timer);
+
+        /* cancel_timer() waits while this is set */
+        timer->is_running = true;
+
+        spin_unlock(&wheel.lock);
+        timer->func(timer);
+        spin_lock(&wheel.lock);
+
+        timer->is_running = false;
+    }
+}
+
+/**
+ * Process the timers that expired up to the current tick
+ *
+ * This function is called by the timer interrupt handler on any CPU. Ticks at
+ * which the wheel has nothing to do are skipped.
+ *
+ * @param now current tick count
+ *
+ */
+void timer_update(uint64_t now) {
+    spin_lock(&wheel.lock);
+
+    while(wheel.next_tick <= now) {
+        uint64_t next = find_next_expiry();
+
+        if(next > now) {
+            /* Nothing to do until after the current tick. */
+            wheel.next_tick = now + 1;
+            break;
+        }
+
+        if(next > wheel.next_tick) {
+            wheel.next_tick = next;
+        }
+
+        advance_wheel_locked();
+    }
+
+    wheel.next_expiry = find_next_expiry();
+
+    spin_unlock(&wheel.lock);
+}
+
+/**
+ * Get the next tick at which timer_update() has something to do
+ *
+ * This is used to set the timer of each CPU. The value is read without the
+ * wheel lock, so it might be slightly out of date, which only means a CPU
+ * might be interrupted needlessly.
+ *
+ * @return tick, TIMER_NEVER if there are no pending timers
+ *
+ */
+uint64_t timer_get_next_expiry(void) {
+    volatile uint64_t *next_expiry = &wheel.next_expiry;
+    uint64_t value;
+
+    /* A 64-bit value cannot be read atomically, so read it until two reads
+     * agree. */
+    do {
+        value = *next_expiry;
+    } while(value != *next_expiry);
+
+    return value;
+}
@@ -67,3 +67,56 @@ or_atomic:
 
     ret
 .end:
+
+; -----------------------------------------------------------------------------
+; FUNCTION: swap_atomic
+; C PROTOTYPE: int swap_atomic(int *value, int new_value);
+; -----------------------------------------------------------------------------
+    global swap_atomic:function (swap_atomic.end - swap_atomic)
+swap_atomic:
+    mov edx, [esp+4]            ; first argument: pointer to value
+    mov eax, [esp+8]            ; second argument: new value
+
+    xchg dword [edx], eax       ; Exchange (implicitly locked), old value in eax.
+
+    ret
+.end:
+
+; -----------------------------------------------------------------------------
+; FUNCTION: compare_and_swap_atomic
+; C PROTOTYPE: int compare_and_swap_atomic(int *value, int expected, int new_value);
+; DESCRIPTION:
+;   Set the value to new_value, but only if it is equal to expected. Return the
+;   value before the operation, which is equal to expected on success.
+; -----------------------------------------------------------------------------
+    global compare_and_swap_atomic:function (compare_and_swap_atomic.end - compare_and_swap_atomic)
+compare_and_swap_atomic:
+    mov edx, [esp+4]                ; first argument: pointer to value
+    mov eax, [esp+8]                ; second argument: expected value
+    mov ecx, [esp+12]               ; third argument: new value
+
+    ; Copy new value (ecx) into value ([edx]) if the current value is the one
+    ; we are expecting (eax). Either way, the value before the operation ends
+    ; up in eax.
+    lock cmpxchg dword [edx], ecx
+
+    ret
+.end:
+
+; -----------------------------------------------------------------------------
+; FUNCTION: compare_and_swap_ptr_atomic
+; C PROTOTYPE: void *compare_and_swap_ptr_atomic(void **value, void *expected, void *new_value);
+; DESCRIPTION:
+;   Same as compare_and_swap_atomic() for a pointer. Pointers are 32 bits wide
+;   on this architecture, like int.
+; -----------------------------------------------------------------------------
+    global compare_and_swap_ptr_atomic:function (compare_and_swap_ptr_atomic.end - compare_and_swap_ptr_atomic)
+compare_and_swap_ptr_atomic:
+    mov edx, [esp+4]                ; first argument: pointer to value
+    mov eax, [esp+8]                ; second argument: expected value
+    mov ecx, [esp+12]               ; third argument: new value
+
+    lock cmpxchg dword [edx], ecx
+
+    ret
+.end:
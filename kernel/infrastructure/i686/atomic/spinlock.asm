@@ -29,6 +29,9 @@
 
     bits 32
 
+    extern service_tlb_shootdown
+    extern tlb_shootdown_remaining
+
 ; -----------------------------------------------------------------------------
 ; FUNCTION: init_spinlock
 ; C PROTOTYPE: void init_spinlock(spinlock_t *lock);
@@ -50,7 +53,9 @@ init_spinlock:
 ;   high word being the ticket number.
 ;   
 ;   For now, the assumption is that interrupts are disabled whenever we are in
-;   the kernel, so there is no need to disable interrupts here.
+;   the kernel, so there is no need to disable interrupts here. For the same
+;   reason, TLB shootdown requests are serviced while spinning: the CPU that
+;   sent the request might hold the lock and be waiting for this one.
 ; -----------------------------------------------------------------------------
     global spin_lock:function (spin_lock.end - spin_lock)
 spin_lock:
@@ -66,9 +71,20 @@ spin_lock:
     cmp edx, ecx                ; Compare with our ticket number.
     jz .done                    ; If it matches, we are done.
 
+    cmp dword [tlb_shootdown_remaining], 0
+    jnz .shootdown              ; Service TLB shootdown request.
+
     pause                       ; Yes, this is a spinlock.
     jmp .loop                   ; Loop one more time.
 
+.shootdown:
+    push eax                    ; Save lock address and ticket number, which
+    push ecx                    ; the C function may clobber.
+    call service_tlb_shootdown
+    pop ecx
+    pop eax
+    jmp .loop
+
 .done:
     ret
 .end:
@@ -56,9 +56,11 @@ typedef struct {
     x86_cpuid_regs_t    ext2;
     x86_cpuid_regs_t    ext3;
     x86_cpuid_regs_t    ext4;
+    x86_cpuid_regs_t    ext7;
     x86_cpuid_regs_t    ext8;
     x86_cpuid_regs_t    soft0;
     bool                ext4_valid;
+    bool                ext7_valid;
     bool                ext8_valid;
     bool                soft0_valid;
 } cpuid_leafs_set;
@@ -148,6 +150,15 @@ static void get_cpuid_leafs(cpuid_leafs_set *leafs) {
         (void)cpuid(&leafs->ext4);
     }
 
+    /* leaf 0x80000007 */
+
+    leafs->ext7_valid = ext_max >= ext_base + 7;
+
+    if(leafs->ext7_valid) {
+        leafs->ext7.eax = ext_base + 7;
+        (void)cpuid(&leafs->ext7);
+    }
+
     /* leaf 0x80000008 */
 
     leafs->ext8_valid = ext_max >= ext_base + 8;
@@ -320,6 +331,26 @@ static void enumerate_features(cpuinfo_t *cpuinfo, const cpuid_leafs_set *leafs)
         cpuinfo->features |= CPU_FEATURE_SSE;
     }
 
+    /* Time Stamp Counter (TSC) */
+    if(flags & CPUID_FEATURE_TSC) {
+        cpuinfo->features |= CPU_FEATURE_TSC;
+    }
+
+    /* TSC-deadline mode of the local APIC timer */
+    if((flags & CPUID_FEATURE_TSC) && (leafs->basic1.ecx & CPUID_FEATURE_ECX_TSC_DEADLINE)) {
+        cpuinfo->features |= CPU_FEATURE_TSC_DEADLINE;
+    }
+
+    /* TSC that runs at a constant rate in all ACPI P-, C- and T-states */
+    if((flags & CPUID_FEATURE_TSC) && leafs->ext7_valid && (leafs->ext7.edx & CPUID_EXT7_INVARIANT_TSC)) {
+        cpuinfo->features |= CPU_FEATURE_INVARIANT_TSC;
+    }
+
+    /* MONITOR/MWAIT instructions */
+    if(leafs->basic1.ecx & CPUID_FEATURE_ECX_MONITOR) {
+        cpuinfo->features |= CPU_FEATURE_MWAIT;
+    }
+
     detect_sysenter_instruction(cpuinfo, leafs);
 
     detect_syscall_instruction(cpuinfo, leafs);
@@ -561,12 +592,14 @@ static void identify_workarounds(cpuinfo_t *cpuinfo) {
  */
 static void dump_features(const cpuinfo_t *cpuinfo) {
     info(
-        "  Features:%s%s%s%s%s%s%s%s%s%s%s%s%s",
+        "  Features:%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s",
         (cpuinfo->features == 0) ? " (none)" : "",
         (cpuinfo->features & CPU_FEATURE_APIC) ? " apic" : "",
         (cpuinfo->features & CPU_FEATURE_CPUID) ? " cpuid" : "",
         (cpuinfo->features & CPU_FEATURE_FPU) ? " fpu" : "",
         (cpuinfo->features & CPU_FEATURE_FXSR) ? " fxsr" : "",
+        (cpuinfo->features & CPU_FEATURE_INVARIANT_TSC) ? " invariant_tsc" : "",
+        (cpuinfo->features & CPU_FEATURE_MWAIT) ? " mwait" : "",
         (cpuinfo->features & CPU_FEATURE_NX) ? " nx" : "",
         (cpuinfo->features & CPU_FEATURE_PAE) ? " pae" : "",
         (cpuinfo->features & CPU_FEATURE_PAT) ? " pat" : "",
@@ -574,7 +607,9 @@ static void dump_features(const cpuinfo_t *cpuinfo) {
         (cpuinfo->features & CPU_FEATURE_PSE) ? " pse" : "",
         (cpuinfo->features & CPU_FEATURE_SSE) ? " sse" : "",
         (cpuinfo->features & CPU_FEATURE_SYSCALL) ? " syscall" : "",
-        (cpuinfo->features & CPU_FEATURE_SYSENTER) ? " sysenter" : ""
+        (cpuinfo->features & CPU_FEATURE_SYSENTER) ? " sysenter" : "",
+        (cpuinfo->features & CPU_FEATURE_TSC) ? " tsc" : "",
+        (cpuinfo->features & CPU_FEATURE_TSC_DEADLINE) ? " tsc_deadline" : ""
     );
 }
 
@@ -696,6 +731,11 @@ static void check_cpu_minimum_requirements(void) {
         too_old = true;
     }
 
+    if(!cpu_has_feature(CPU_FEATURE_TSC)) {
+        error("no Time Stamp Counter (TSC)");
+        too_old = true;
+    }
+
     if(too_old) {
         panic(pentium_or_later);
     }
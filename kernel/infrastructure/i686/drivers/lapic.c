@@ -30,12 +30,13 @@
  */
 
 #include <jinue/shared/asm/mman.h>
-#include <kernel/application/asm/ticks.h>
 #include <kernel/domain/services/logging.h>
 #include <kernel/domain/services/mman.h>
 #include <kernel/domain/services/panic.h>
 #include <kernel/infrastructure/i686/drivers/lapic.h>
+#include <kernel/infrastructure/i686/asm/msr.h>
 #include <kernel/infrastructure/i686/cpuinfo.h>
+#include <kernel/infrastructure/i686/isa/instrs.h>
 #include <kernel/infrastructure/i686/platform.h>
 #include <kernel/interface/i686/asm/idt.h>
 #include <kernel/machine/memory.h>
@@ -155,31 +156,55 @@ static void set_divider(int divider) {
 }
 
 /**
- * Initialize the local APIC timer
+ * Initialize the local APIC timer of the current CPU
+ * 
+ * The timer is left stopped. Call local_apic_start_timer() (one-shot mode) or
+ * local_apic_set_timer_deadline() (TSC-deadline mode) to arm it.
+ * 
+ * @param flags timer mode, optionally with APIC_LVT_MASKED
  */
-void init_timer(void) {
+void local_apic_init_timer(uint32_t flags) {
     set_divider(1);
 
-    write_register(APIC_REG_LVT_TIMER, APIC_LVT_TIMER_PERIODIC | IDT_APIC_TIMER);
-    
-    /* TODO get frequency from CPUID and/or MSRs and/or calibrate
-     *
-     * This is QEMU's hardcoded frequency */
-    const uint32_t clock_freq_hz = 1000000000;
-    const uint32_t initial_count = (clock_freq_hz / TICKS_PER_SECOND) - 1;
+    write_register(APIC_REG_INITIAL_COUNT, 0);
+
+    write_register(APIC_REG_LVT_TIMER, flags | IDT_APIC_TIMER);
+}
 
+/**
+ * Arm the local APIC timer in one-shot mode
+ * 
+ * @param count number of timer counts until the timer interrupt, zero to stop
+ *  the timer
+ */
+void local_apic_start_timer(uint32_t count) {
     /* Writing the initial count starts the timer. */
-    write_register(APIC_REG_INITIAL_COUNT, initial_count);
+    write_register(APIC_REG_INITIAL_COUNT, count);
 }
 
 /**
- * Initialize the local APIC, including the local APIC timer
+ * Get the current count of the local APIC timer
+ * 
+ * @return number of timer counts remaining, zero if the timer is stopped
  */
-void local_apic_init(void) {
-    map_registers();
+uint32_t local_apic_get_timer_count(void) {
+    return read_register(APIC_REG_CURRENT_COUNT);
+}
 
-    check_version();
+/**
+ * Arm the local APIC timer in TSC-deadline mode
+ * 
+ * @param tsc value of the time stamp counter at which the timer interrupt is
+ *  triggered, immediately if it has already passed, zero to stop the timer
+ */
+void local_apic_set_timer_deadline(uint64_t tsc) {
+    wrmsr(MSR_IA32_TSC_DEADLINE, tsc);
+}
 
+/**
+ * Enable the local APIC of the current CPU
+ */
+static void enable_local_apic(void) {
     /* Setting the mask flag to unmasked/enabled in the spurious vector enables
      * the local APIC. Here, we toggle this flag to reset the local APIC to a
      * known state (i.e. all LVTs masked), and then enable it.
@@ -202,8 +227,97 @@ void local_apic_init(void) {
 
     /* Clear pending APIC errors, if any. */
     write_register(APIC_REG_ERROR_STATUS, 0);
+}
+
+/**
+ * Initialize the local APIC
+ */
+void local_apic_init(void) {
+    map_registers();
+
+    check_version();
+
+    enable_local_apic();
+}
+
+/**
+ * Initialize the local APIC of an application processor
+ * 
+ * The local APIC registers are at the same address for all CPUs, so they were
+ * already mapped by local_apic_init() on the bootstrap processor.
+ */
+void local_apic_init_ap(void) {
+    enable_local_apic();
+}
 
-    init_timer();
+/**
+ * Get the local APIC ID of the current CPU
+ * 
+ * @return local APIC ID
+ */
+int local_apic_get_id(void) {
+    return read_register(APIC_REG_ID) >> 24;
+}
+
+/**
+ * Send an Inter-Processor Interrupt (IPI)
+ * 
+ * This function waits for the local APIC to accept the IPI before returning.
+ * 
+ * @param apic_id local APIC ID of the destination CPU
+ * @param command low 32 bits of the interrupt command register
+ */
+static void send_ipi(int apic_id, uint32_t command) {
+    write_register(APIC_REG_ICR_HIGH, (uint32_t)apic_id << APIC_ICR_DEST_SHIFT);
+
+    /* Writing the low half of the interrupt command register sends the IPI. */
+    write_register(APIC_REG_ICR_LOW, command);
+
+    while(read_register(APIC_REG_ICR_LOW) & APIC_ICR_PENDING) {
+        /* wait */
+    }
+}
+
+/**
+ * Send an INIT IPI to another CPU
+ * 
+ * See section 11.6.1 of the Intel 64 and IA-32 Architectures Software
+ * Developer’s Manual Volume 3 (3A, 3B, 3C, & 3D): System Programming Guide.
+ * 
+ * @param apic_id local APIC ID of the destination CPU
+ */
+void local_apic_send_init(int apic_id) {
+    send_ipi(
+        apic_id,
+        APIC_ICR_DELIVERY_INIT | APIC_ICR_LEVEL_ASSERT | APIC_ICR_TRIGGER_LEVEL
+    );
+
+    send_ipi(
+        apic_id,
+        APIC_ICR_DELIVERY_INIT | APIC_ICR_LEVEL_DEASSERT | APIC_ICR_TRIGGER_LEVEL
+    );
+}
+
+/**
+ * Send a fixed interrupt to another CPU
+ * 
+ * @param apic_id local APIC ID of the destination CPU
+ * @param vector interrupt vector
+ */
+void local_apic_send_interrupt(int apic_id, int vector) {
+    send_ipi(apic_id, APIC_ICR_DELIVERY_FIXED | APIC_ICR_TRIGGER_EDGE | (vector & 0xff));
+}
+
+/**
+ * Send a Startup IPI (SIPI) to another CPU
+ * 
+ * The destination CPU starts executing in real mode at address vector * 4096.
+ * 
+ * @param apic_id local APIC ID of the destination CPU
+ * @param vector startup vector
+ */
+void local_apic_send_startup(int apic_id, int vector) {
+    send_ipi(apic_id, APIC_ICR_DELIVERY_STARTUP | (vector & 0xff));
 }
 
 /**
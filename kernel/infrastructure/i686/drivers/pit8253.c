@@ -46,3 +46,36 @@ void pit8253_init(void) {
     outb(PIT8253_IO_COUNTER0, divider >> 8);
     iodelay();
 }
+
+/**
+ * Start a countdown on counter 2
+ *
+ * Counter 2 is not connected to an interrupt, so it can be used to measure a
+ * known interval by polling pit8253_countdown_done(). The PC speaker is left
+ * disconnected.
+ *
+ * @param count number of input clock cycles, see PIT8253_FREQ_N
+ */
+void pit8253_start_countdown(uint16_t count) {
+    uint8_t port_b = inb(PIT8253_IO_PORT_B);
+    outb(PIT8253_IO_PORT_B, (port_b & ~PIT8253_PORT_B_SPEAKER) | PIT8253_PORT_B_GATE2);
+    iodelay();
+
+    outb(PIT8253_IO_CW_REG, PIT8253_CW_COUNTER2 | PIT8253_CW_MODE0 | PIT8253_CW_LOAD_LSB_MSB);
+    iodelay();
+
+    outb(PIT8253_IO_COUNTER2, count & 0xff);
+    iodelay();
+
+    /* Counting starts once the most significant byte is written. */
+    outb(PIT8253_IO_COUNTER2, count >> 8);
+}
+
+/**
+ * Check whether the countdown started by pit8253_start_countdown() is done
+ *
+ * @return true if the count reached zero, false otherwise
+ */
+bool pit8253_countdown_done(void) {
+    return !!(inb(PIT8253_IO_PORT_B) & PIT8253_PORT_B_OUT2);
+}
@@ -205,3 +205,41 @@ paddr_t acpi_get_local_apic_address(void) {
 
     return acpi_tables.madt->local_intr_controller_addr;
 }
+
+/**
+ * Get the local APIC IDs of the enabled processors
+ * 
+ * If there are more than max processors, only the first max local APIC IDs
+ * are stored but the total number of processors is still returned.
+ * 
+ * @param apic_ids array where the local APIC IDs are stored (OUT)
+ * @param max maximum number of local APIC IDs to store
+ * @return number of enabled processors, zero if the information is unavailable
+ */
+int acpi_get_cpu_apic_ids(int *apic_ids, int max) {
+    const acpi_madt_t *madt = acpi_tables.madt;
+
+    if(madt == NULL) {
+        return 0;
+    }
+
+    int count = 0;
+
+    const madt_entry_header_t *entry =
+        get_acpi_madt_first_by_type(madt, ACPI_MADT_ENTRY_LOCAL_APIC);
+
+    while(entry != NULL) {
+        const acpi_madt_lapic_t *lapic = (const acpi_madt_lapic_t *)entry;
+
+        if(entry->type == ACPI_MADT_ENTRY_LOCAL_APIC && (lapic->flags & ACPI_MADT_LOCAL_APIC_FLAG_ENABLED)) {
+            if(count < max) {
+                apic_ids[count] = lapic->apic_id;
+            }
+            ++count;
+        }
+
+        entry = get_acpi_madt_next(madt, entry);
+    }
+
+    return count;
+}
@@ -276,3 +276,44 @@ paddr_t mp_get_local_apic_addr(void) {
 
     return mp.table->lapic_addr;
 }
+
+/**
+ * Get the local APIC IDs of the enabled processors
+ * 
+ * If there are more than max processors, only the first max local APIC IDs
+ * are stored but the total number of processors is still returned.
+ * 
+ * @param apic_ids array where the local APIC IDs are stored (OUT)
+ * @param max maximum number of local APIC IDs to store
+ * @return number of enabled processors, zero if the information is unavailable
+ */
+int mp_get_cpu_apic_ids(int *apic_ids, int max) {
+    if(mp.table == NULL) {
+        return 0;
+    }
+
+    int count           = 0;
+    const char *entry   = mp.table->entries;
+    const char *end     = (const char *)mp.table + mp.table->base_length;
+
+    for(int idx = 0; idx < mp.table->entry_count && entry < end; ++idx) {
+        /* Processor entries are the only ones that are not 8 bytes long. */
+        if(*entry != MP_ENTRY_TYPE_PROCESSOR) {
+            entry += 8;
+            continue;
+        }
+
+        const mp_entry_processor_t *processor = (const mp_entry_processor_t *)entry;
+
+        if(processor->cpu_flags & MP_CPU_FLAG_EN) {
+            if(count < max) {
+                apic_ids[count] = processor->apic_id;
+            }
+            ++count;
+        }
+
+        entry += sizeof(mp_entry_processor_t);
+    }
+
+    return count;
+}
@@ -29,9 +29,11 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <kernel/infrastructure/i686/cpuinfo.h>
 #include <kernel/infrastructure/i686/isa/instrs.h>
 #include <kernel/infrastructure/i686/isa/io.h>
 #include <kernel/machine/halt.h>
+#include <kernel/machine/smp.h>
 #include <stdbool.h>
 
 void machine_halt(void) {
@@ -41,6 +43,37 @@ void machine_halt(void) {
     }
 }
 
+/**
+ * Put the current CPU in a low power state until there might be work to do
+ *
+ * The CPU wakes up on the next interrupt, e.g. the timer tick. If the CPU
+ * supports the MONITOR/MWAIT instructions, it also wakes up as soon as another
+ * CPU writes to the watched variable, e.g. when it makes a thread ready to run
+ * on this CPU. This function returns immediately if the watched variable is
+ * not zero.
+ *
+ * The kernel runs with interrupts disabled. They are enabled only while the
+ * CPU waits, which is when pending interrupts are handled.
+ *
+ * @param watch variable to watch, typically a count of things to do
+ *
+ */
+void machine_idle(const volatile int *watch) {
+    if(cpu_has_feature(CPU_FEATURE_MWAIT)) {
+        monitor(watch);
+
+        /* Check after arming the monitor so a write that happens in between
+         * is not missed. */
+        if(*watch == 0) {
+            sti_mwait();
+        }
+    } else if(*watch == 0) {
+        sti_hlt();
+    }
+
+    cli();
+}
+
 void machine_reboot(void) {
     outb(0x64, 0xfe);
 }
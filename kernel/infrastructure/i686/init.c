@@ -57,6 +57,8 @@
 #include <kernel/infrastructure/i686/descriptors.h>
 #include <kernel/infrastructure/i686/fpu.h>
 #include <kernel/infrastructure/i686/percpu.h>
+#include <kernel/infrastructure/i686/smp.h>
+#include <kernel/infrastructure/i686/timer.h>
 #include <kernel/infrastructure/i686/video.h>
 #include <kernel/infrastructure/elf.h>
 #include <kernel/interface/i686/asm/idt.h>
@@ -172,9 +174,19 @@ static void initialize_page_allocator(boot_alloc_t *boot_alloc) {
 
 static void select_syscall_implementation(void) {
     if(cpu_has_feature(CPU_FEATURE_SYSCALL)) {
-        uint64_t msrval;
-
         syscall_implementation = JINUE_I686_HOWSYSCALL_FAST_AMD;
+    }
+    else if(cpu_has_feature(CPU_FEATURE_SYSENTER)) {
+        syscall_implementation = JINUE_I686_HOWSYSCALL_FAST_INTEL;
+    }
+    else {
+        syscall_implementation = JINUE_I686_HOWSYSCALL_INTERRUPT;
+    }
+}
+
+static void init_syscall_msrs(void) {
+    if(syscall_implementation == JINUE_I686_HOWSYSCALL_FAST_AMD) {
+        uint64_t msrval;
 
         msrval  = rdmsr(MSR_EFER);
         msrval |= MSR_FLAG_EFER_SCE;
@@ -186,18 +198,13 @@ static void select_syscall_implementation(void) {
 
         wrmsr(MSR_STAR, msrval);
     }
-    else if(cpu_has_feature(CPU_FEATURE_SYSENTER)) {
-        syscall_implementation = JINUE_I686_HOWSYSCALL_FAST_INTEL;
-
+    else if(syscall_implementation == JINUE_I686_HOWSYSCALL_FAST_INTEL) {
         wrmsr(MSR_IA32_SYSENTER_CS,  SEG_SELECTOR(GDT_KERNEL_CODE, RPL_KERNEL));
         wrmsr(MSR_IA32_SYSENTER_EIP, (uint64_t)(uintptr_t)fast_intel_entry);
 
         /* kernel stack address is set when switching thread context */
         wrmsr(MSR_IA32_SYSENTER_ESP, (uint64_t)(uintptr_t)NULL);
     }
-    else {
-        syscall_implementation = JINUE_I686_HOWSYSCALL_INTERRUPT;
-    }
 }
 
 static void get_kernel_exec_file(exec_file_t *kernel, const bootinfo_t *bootinfo) {
@@ -378,9 +385,39 @@ void machine_init(const config_t *config) {
     /* Initialize programmable interval timer and enable timer interrupt. */
     pit8253_init();
 
-    /* Initialize local APIC, including local APIC timer. */
+    /* Initialize local APIC. */
     local_apic_init();
 
+    /* Calibrate the time stamp counter and set up the local APIC timer. */
+    init_timer();
+
     /* choose a system call implementation */
     select_syscall_implementation();
+
+    init_syscall_msrs();
+
+    /* Enumerate the other CPUs and prepare to start them. */
+    init_smp();
+}
+
+/**
+ * Machine-specific initialization of an application processor
+ *
+ * This is called on the application processor itself, once the startup
+ * trampoline has enabled paging. Everything that was initialized once for all
+ * CPUs in machine_init() is already done, so only what is specific to each CPU
+ * needs to be initialized here.
+ *
+ * @param cpu_data per-CPU data of the application processor
+ */
+void init_application_processor(percpu_t *cpu_data) {
+    load_selectors(cpu_data);
+
+    pmap_init_ap();
+
+    init_syscall_msrs();
+
+    local_apic_init_ap();
+
+    init_timer_ap();
 }
@@ -59,6 +59,57 @@ hlt:
     ret
 .end:
 
+; ------------------------------------------------------------------------------
+; FUNCTION: pause
+; C PROTOTYPE: void pause(void);
+; ------------------------------------------------------------------------------
+    global pause:function (pause.end - pause)
+pause:
+    pause
+    ret
+.end:
+
+; ------------------------------------------------------------------------------
+; FUNCTION: sti_hlt
+; C PROTOTYPE: void sti_hlt(void);
+; ------------------------------------------------------------------------------
+    global sti_hlt:function (sti_hlt.end - sti_hlt)
+sti_hlt:
+    ; Interrupts are only recognized after the instruction that follows STI,
+    ; so an interrupt cannot be handled between STI and HLT and then leave the
+    ; CPU halted.
+    sti
+    hlt
+    ret
+.end:
+
+; ------------------------------------------------------------------------------
+; FUNCTION: monitor
+; C PROTOTYPE: void monitor(const volatile void *addr);
+; ------------------------------------------------------------------------------
+    global monitor:function (monitor.end - monitor)
+monitor:
+    mov eax, [esp+4]    ; First param: addr
+    xor ecx, ecx        ; no extensions
+    xor edx, edx        ; no hints
+    monitor
+    ret
+.end:
+
+; ------------------------------------------------------------------------------
+; FUNCTION: sti_mwait
+; C PROTOTYPE: void sti_mwait(void);
+; ------------------------------------------------------------------------------
+    global sti_mwait:function (sti_mwait.end - sti_mwait)
+sti_mwait:
+    xor eax, eax        ; no hints
+    xor ecx, ecx        ; no extensions
+    ; same as sti_hlt: no interrupt is handled between STI and MWAIT
+    sti
+    mwait
+    ret
+.end:
+
 ; ------------------------------------------------------------------------------
 ; FUNCTION: invlpg
 ; C PROTOTYPE: void invlpg(void *vaddr)
@@ -119,6 +170,16 @@ rdmsr:
     ret
 .end:
 
+; ------------------------------------------------------------------------------
+; FUNCTION: rdtsc
+; C PROTOTYPE: uint64_t rdtsc(void)
+; ------------------------------------------------------------------------------
+    global rdtsc:function (rdtsc.end - rdtsc)
+rdtsc:
+    rdtsc
+    ret
+.end:
+
 ; ------------------------------------------------------------------------------
 ; FUNCTION: wrmsr
 ; C PROTOTYPE: void wrmsr(uint32_t addr, uint64_t val)
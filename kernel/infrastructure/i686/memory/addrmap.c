@@ -116,6 +116,23 @@ static bool range_is_in_available_memory(
     return retval;
 }
 
+/**
+ * Check whether a memory range is in available memory
+ * 
+ * @param bootinfo boot information structure (for the address map)
+ * @param addr start address of the range
+ * @param size size of the range in bytes
+ * @return true if range is in available memory, false otherwise
+ */
+bool is_available_memory(const bootinfo_t *bootinfo, uint64_t addr, uint64_t size) {
+    const memory_range_t range = {
+            .start  = addr,
+            .end    = addr + size
+    };
+
+    return range_is_in_available_memory(&range, bootinfo);
+}
+
 /**
  * Check the system has sufficient memory to complete kernel initialization.
  *
@@ -67,6 +67,26 @@ paddr_t platform_get_local_apic_address(void) {
     return APIC_INIT_ADDR;
 }
 
+/**
+ * Get the local APIC IDs of the enabled processors
+ * 
+ * If there are more than max processors, only the first max local APIC IDs
+ * are stored but the total number of processors is still returned.
+ * 
+ * @param apic_ids array where the local APIC IDs are stored (OUT)
+ * @param max maximum number of local APIC IDs to store
+ * @return number of enabled processors, zero if unknown
+ */
+int platform_get_cpu_apic_ids(int *apic_ids, int max) {
+    int count = acpi_get_cpu_apic_ids(apic_ids, max);
+
+    if(count > 0) {
+        return count;
+    }
+
+    return mp_get_cpu_apic_ids(apic_ids, max);
+}
+
 /**
  * Determine the current video type (text, framebuffer)
  * 
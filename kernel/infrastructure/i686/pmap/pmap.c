@@ -48,6 +48,7 @@
 #include <kernel/infrastructure/i686/caches.h>
 #include <kernel/infrastructure/i686/cpuinfo.h>
 #include <kernel/infrastructure/i686/percpu.h>
+#include <kernel/infrastructure/i686/smp.h>
 #include <kernel/infrastructure/elf.h>
 #include <kernel/interface/i686/bootinfo.h>
 #include <kernel/machine/pmap.h>
@@ -68,6 +69,10 @@
  * directory entries should only be manipulated through the PAE or non-PAE
  * functions, as appropriate depending on whether PAE is enabled or not. */
 
+/** Above this number of pages, all user space TLB entries are flushed at once
+ * instead of being invalidated one by one */
+#define INVLPG_MAX_PAGES    32
+
 /** Kernel page tables
  *
  * During kernel initialization, kernel page tables are pre-allocated
@@ -466,10 +471,36 @@ void pmap_destroy_addr_space(addr_space_t *addr_space) {
 }
 
 void pmap_switch_addr_space(addr_space_t *addr_space) {
-    set_cr3(addr_space->cr3);
-
+    /* The current address space is set before CR3 is loaded so a CPU that
+     * changes mappings in this address space either sees it and sends a TLB
+     * shootdown or changes them before CR3 is loaded (see tlb_shootdown()). */
     percpu_t *cpu_data = get_percpu_data();
     cpu_data->current_addr_space = addr_space;
+
+    set_cr3(addr_space->cr3);
+}
+
+/**
+ * Switch to the initial address space
+ * 
+ * The initial address space only has the kernel mappings. It is used by the
+ * idle threads, which do not belong to any process.
+ */
+void pmap_switch_to_initial_addr_space(void) {
+    pmap_switch_addr_space(&initial_addr_space);
+}
+
+/**
+ * Initialize virtual memory management on an application processor
+ * 
+ * This is called on the application processor once paging has been enabled
+ * by the startup trampoline with the bootstrap processor's CR4 value, so
+ * global pages are already enabled.
+ */
+void pmap_init_ap(void) {
+    initialize_pat();
+
+    pmap_switch_to_initial_addr_space();
 }
 
 /**
@@ -704,31 +735,28 @@ void machine_map_kernel(addr_t addr, size_t size, paddr_t paddr, int prot, int f
 }
 
 /**
- * Establish a userspace virtual memory mapping.
+ * Establish a virtual memory mapping below the kernel limit.
  *
  * Page tables are allocated as needed. If an allocation fails, this function
  * returns false to indicate failure.
  *
- * @param process process in which to map
+ * @param addr_space address space in which to map
  * @param vaddr start virtual address of mapping
  * @param paddr start address in physical memory
  * @param length length of mapping
- * @param prot protection flags
- * @param flags mapping flags
+ * @param pte_flags architecture-dependent page table entry flags
  * @return true on success, false on page table allocation error
  */
-bool machine_map_userspace(
-        process_t       *process,
+static bool map_in_addr_space(
+        addr_space_t    *addr_space,
         addr_t           addr,
         size_t           size,
         paddr_t          paddr,
-        int              prot,
-        int              flags) {
+        uint64_t         pte_flags) {
 
     /** ASSERTION: we assume vaddr is aligned on a page boundary */
     assert( page_offset_of(addr) == 0 );
 
-    addr_space_t *addr_space = &process->addr_space;
     bool needs_invalidation = (get_cr3() == addr_space->cr3);
 
     int pte_index   = page_table_offset_of(addr);
@@ -740,6 +768,8 @@ bool machine_map_userspace(
         return false;
     }
 
+    bool is_remapped = false;
+
     for(size_t offset = 0; offset < size; offset += PAGE_SIZE) {
         if(pte_index >= entries_per_page_table) {
             pte = lookup_userspace_page_table(
@@ -756,11 +786,13 @@ bool machine_map_userspace(
             pte_index = 0;
         }
 
-        set_pte(
-            get_pte_with_offset(pte, pte_index),
-            paddr + offset,
-            map_arch_page_flags(prot, flags) | X86_PTE_USER
-        );
+        pte_t *entry = get_pte_with_offset(pte, pte_index);
+
+        if(pte_is_present(entry)) {
+            is_remapped = true;
+        }
+
+        set_pte(entry, paddr + offset, pte_flags);
 
         if(needs_invalidation && !must_reload_cr3) {
             invlpg(addr + offset);
@@ -773,9 +805,102 @@ bool machine_map_userspace(
         reload_cr3();
     }
 
+    /* Other CPUs running in this address space have to reload CR3 if a page
+     * directory was added and invalidate the entries of existing mappings that
+     * were replaced. */
+    if(must_reload_cr3) {
+        tlb_shootdown(addr_space, addr, 0);
+    }
+    else if(is_remapped) {
+        tlb_shootdown(addr_space, addr, size);
+    }
+
     return true;
 }
 
+/**
+ * Establish a userspace virtual memory mapping.
+ *
+ * Page tables are allocated as needed. If an allocation fails, this function
+ * returns false to indicate failure.
+ *
+ * @param process process in which to map
+ * @param vaddr start virtual address of mapping
+ * @param paddr start address in physical memory
+ * @param length length of mapping
+ * @param prot protection flags
+ * @param flags mapping flags
+ * @return true on success, false on page table allocation error
+ */
+bool machine_map_userspace(
+        process_t       *process,
+        addr_t           addr,
+        size_t           size,
+        paddr_t          paddr,
+        int              prot,
+        int              flags) {
+
+    return map_in_addr_space(
+        &process->addr_space,
+        addr,
+        size,
+        paddr,
+        map_arch_page_flags(prot, flags) | X86_PTE_USER
+    );
+}
+
+/**
+ * Map memory at a virtual address equal to its physical address
+ * 
+ * This is used for the application processors startup trampoline, which
+ * enables paging while running from low memory. The mapping is readable,
+ * writable, executable and only accessible by the kernel.
+ *
+ * @param addr_space address space in which to map
+ * @param paddr start address in physical memory
+ * @param size size of the mapping
+ * @return true on success, false on page table allocation error
+ */
+bool pmap_map_identity(addr_space_t *addr_space, paddr_t paddr, size_t size) {
+    return map_in_addr_space(
+        addr_space,
+        (addr_t)(uintptr_t)paddr,
+        size,
+        paddr,
+        X86_PTE_READ_WRITE | X86_PTE_PRESENT
+    );
+}
+
+/**
+ * Remove a userspace virtual memory mapping.
+ *
+ * Pages in the range that are not mapped are skipped. Page tables are not
+ * freed, even if they become empty.
+ *
+ * @param process process in which to unmap
+ * @param addr start virtual address of mapping
+ * @param size length of mapping
+ */
+void machine_unmap_userspace(process_t *process, addr_t addr, size_t size) {
+    /** ASSERTION: we assume vaddr is aligned on a page boundary */
+    assert( page_offset_of(addr) == 0 );
+
+    addr_space_t *addr_space = &process->addr_space;
+
+    for(size_t offset = 0; offset < size; offset += PAGE_SIZE) {
+        pte_t *page_table = lookup_userspace_page_table(addr_space, addr + offset, false, NULL);
+
+        if(page_table == NULL) {
+            continue;
+        }
+
+        clear_pte(get_pte_with_offset(page_table, page_table_offset_of(addr + offset)));
+    }
+
+    pmap_invalidate_local(addr_space, addr, size);
+    tlb_shootdown(addr_space, addr, size);
+}
+
 /**
  * Unmap a kernel page from virtual memory.
  *
@@ -796,8 +921,6 @@ void machine_unmap_kernel(addr_t addr, size_t size) {
         
         for(size_t offset = 0, index = 0; offset < size; offset += large_page_size, ++index) {
             clear_pte( get_pte_with_offset(pte, index) );
-
-            invlpg(addr + offset);
         }
     }
     else {
@@ -808,10 +931,46 @@ void machine_unmap_kernel(addr_t addr, size_t size) {
 
         for(size_t offset = 0; offset < size; offset += PAGE_SIZE) {
             clear_pte( get_pte_with_offset(pte, PAGE_NUMBER(offset)) );
+        }
+    }
 
-            invlpg(addr + offset);
+    pmap_invalidate_local(NULL, addr, size);
+    tlb_shootdown(NULL, addr, size);
+}
+
+/**
+ * Invalidate the TLB entries for a range of addresses on the current CPU
+ *
+ * For a user space address space, nothing is done unless it is the current
+ * one, and all its TLB entries are flushed at once if the range is large or
+ * if its size is zero. Reloading CR3 to do this also reloads the PAE page
+ * directory pointers.
+ *
+ * @param addr_space address space, NULL for kernel mappings
+ * @param addr start address of the range
+ * @param size size of the range, zero to flush all user space entries
+ */
+void pmap_invalidate_local(const addr_space_t *addr_space, addr_t addr, size_t size) {
+    size_t step = PAGE_SIZE;
+
+    if(addr_space != NULL) {
+        if(get_cr3() != addr_space->cr3) {
+            return;
+        }
+
+        if(size == 0 || size > INVLPG_MAX_PAGES * PAGE_SIZE) {
+            reload_cr3();
+            return;
         }
     }
+    else if((uintptr_t)addr >= LARGE_PAGES_AREA_ADDR) {
+        /* large_page_size is the page size if large pages are not supported */
+        step = large_page_size;
+    }
+
+    for(size_t offset = 0; offset < size; offset += step) {
+        invlpg(addr + offset);
+    }
 }
 
 /**
@@ -831,6 +990,47 @@ paddr_t machine_lookup_kernel_paddr(const void *addr) {
     return get_pte_paddr(pte);
 }
 
+/**
+ * Look up the physical address of a page frame mapped in user space.
+ *
+ * This function does not allocate page tables. It fails if the page is not
+ * mapped, if it is not accessible from user space or, if JINUE_PROT_WRITE is
+ * set in the prot argument, if it is not writable.
+ *
+ * @param process process in which to look up the address
+ * @param addr userspace address to look up, does not need to be page aligned
+ * @param prot required access, JINUE_PROT_READ and/or JINUE_PROT_WRITE
+ * @param paddr (out) physical address of the page frame
+ * @return true on success, false if the page is not accessible
+ */
+bool machine_lookup_userspace_paddr(
+        process_t       *process,
+        const void      *addr,
+        int              prot,
+        paddr_t         *paddr) {
+
+    /** ASSERTION: addr is a userspace pointer */
+    assert( is_userspace_pointer(addr) );
+
+    const void *page = (const void *)page_address_of(addr);
+
+    pte_t *page_table = lookup_userspace_page_table(&process->addr_space, page, false, NULL);
+
+    if(page_table == NULL) {
+        return false;
+    }
+
+    const pte_t *pte = get_pte_with_offset(page_table, page_table_offset_of(page));
+
+    if(! pte_is_user_accessible(pte, !!(prot & JINUE_PROT_WRITE))) {
+        return false;
+    }
+
+    *paddr = get_pte_paddr(pte);
+
+    return true;
+}
+
 /** Get large page size in bytes
  * 
  * @return large page size in bytes
@@ -34,6 +34,11 @@
 #include <kernel/machine/process.h>
 
 void machine_switch_to_process(process_t *process) {
+    if(process == NULL) {
+        pmap_switch_to_initial_addr_space();
+        return;
+    }
+
     pmap_switch_addr_space(&process->addr_space);
 }
 
@@ -0,0 +1,402 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jinue/shared/asm/mman.h>
+#include <kernel/domain/alloc/page_alloc.h>
+#include <kernel/domain/services/logging.h>
+#include <kernel/domain/services/mman.h>
+#include <kernel/domain/services/panic.h>
+#include <kernel/infrastructure/i686/drivers/iodelay.h>
+#include <kernel/infrastructure/i686/drivers/lapic.h>
+#include <kernel/infrastructure/i686/isa/instrs.h>
+#include <kernel/infrastructure/i686/isa/regs.h>
+#include <kernel/infrastructure/i686/memory/addrmap.h>
+#include <kernel/infrastructure/i686/pmap/pmap.h>
+#include <kernel/infrastructure/i686/cpuinfo.h>
+#include <kernel/infrastructure/i686/percpu.h>
+#include <kernel/infrastructure/i686/platform.h>
+#include <kernel/infrastructure/i686/smp.h>
+#include <kernel/interface/i686/asm/idt.h>
+#include <kernel/interface/i686/bootinfo.h>
+#include <kernel/machine/atomic.h>
+#include <kernel/machine/memory.h>
+#include <kernel/machine/smp.h>
+#include <kernel/machine/spinlock.h>
+#include <kernel/machine/thread.h>
+#include <assert.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* Delays of the INIT-SIPI-SIPI startup sequence, in microseconds. See section
+ * 11.6.4 "MP Initialization Protocol Algorithm for MP Systems" of the Intel 64
+ * and IA-32 Architectures Software Developer’s Manual Volume 3. */
+
+/** delay after the INIT IPI */
+#define INIT_DELAY_US       10000
+
+/** delay after each startup IPI */
+#define STARTUP_DELAY_US    200
+
+/** how long to wait for an application processor to come online */
+#define ONLINE_TIMEOUT_US   100000
+
+/** CPUs present in the system, the bootstrap processor is always CPU 0 */
+static struct {
+    int          count;
+    int          online;
+    int          apic_ids[MAX_CPUS];
+    percpu_t    *percpu[MAX_CPUS];
+    void        *ap_percpu_data;
+    void        *trampoline;
+} cpus;
+
+/** TLB shootdown request being serviced, see tlb_shootdown() */
+static struct {
+    spinlock_t           lock;
+    const addr_space_t  *addr_space;
+    addr_t               addr;
+    size_t               size;
+    int                  is_pending[MAX_CPUS];
+} shootdown = {.lock = SPINLOCK_INITIALIZER};
+
+/** number of CPUs that have yet to service the current TLB shootdown request
+ *
+ * spin_lock() checks this while spinning so a CPU that waits for a lock with
+ * interrupts disabled still services the request. */
+int tlb_shootdown_remaining;
+
+/** state shared with the application processor that is being started */
+static struct {
+    thread_t        *idle_thread;
+    volatile bool    online;
+} startup;
+
+/**
+ * Wait for approximately the specified number of microseconds
+ * 
+ * This relies on an I/O port write taking about one microsecond, which is
+ * precise enough for the delays of the startup sequence.
+ * 
+ * @param us delay in microseconds
+ */
+static void udelay(int us) {
+    for(int idx = 0; idx < us; ++idx) {
+        iodelay();
+    }
+}
+
+/**
+ * Enumerate the CPUs and prepare for starting the application processors
+ * 
+ * Must be called on the bootstrap processor after the local APIC and the page
+ * allocator have been initialized.
+ */
+void init_smp(void) {
+    cpus.count          = 1;
+    cpus.online         = 1;
+    cpus.apic_ids[0]    = local_apic_get_id();
+    cpus.percpu[0]      = get_percpu_data();
+
+    int apic_ids[MAX_CPUS];
+    int count = platform_get_cpu_apic_ids(apic_ids, MAX_CPUS);
+
+    if(count > MAX_CPUS) {
+        warn(WARNING "Found %d CPUs but only %d are supported.", count, MAX_CPUS);
+        count = MAX_CPUS;
+    }
+
+    for(int idx = 0; idx < count && cpus.count < MAX_CPUS; ++idx) {
+        if(apic_ids[idx] != cpus.apic_ids[0]) {
+            cpus.apic_ids[cpus.count++] = apic_ids[idx];
+        }
+    }
+
+    if(cpus.count > 1 && !is_available_memory(get_bootinfo(), AP_STARTUP_ADDR, PAGE_SIZE)) {
+        warn(WARNING "Only using one CPU because the startup code memory is unavailable.");
+        cpus.count = 1;
+    }
+
+    info("Found %d CPU(s).", cpus.count);
+
+    if(cpus.count == 1) {
+        return;
+    }
+
+    /* The per-CPU data of each application processor is in a slot of this
+     * page. The slot of CPU 0 is unused since the bootstrap processor already
+     * has its per-CPU data. */
+    assert(MAX_CPUS * PERCPU_DATA_ALIGNMENT <= PAGE_SIZE);
+
+    cpus.ap_percpu_data = page_alloc();
+
+    if(cpus.ap_percpu_data == NULL) {
+        panic("Could not allocate per-CPU data for application processors");
+    }
+
+    machine_add_reserved_to_address_map(AP_STARTUP_ADDR, PAGE_SIZE);
+
+    cpus.trampoline = map_in_kernel(
+        AP_STARTUP_ADDR,
+        PAGE_SIZE,
+        JINUE_PROT_READ | JINUE_PROT_WRITE,
+        JINUE_MAP_NONE
+    );
+
+    memcpy(cpus.trampoline, ap_trampoline_start, ap_trampoline_end - ap_trampoline_start);
+}
+
+/**
+ * Entry point of an application processor
+ * 
+ * The startup trampoline jumps here on the stack of the idle thread, just
+ * below its initial context. This function does not return: it switches to
+ * the idle thread, which reuses the same stack.
+ * 
+ * @param cpu_data per-CPU data of the application processor
+ */
+static void ap_main(percpu_t *cpu_data) {
+    init_application_processor(cpu_data);
+
+    /* Read this before reporting the CPU as online since the bootstrap
+     * processor then moves on to the next CPU. */
+    thread_t *idle_thread = startup.idle_thread;
+
+    startup.online = true;
+
+    machine_switch_thread(NULL, idle_thread);
+}
+
+/**
+ * Get the number of CPUs
+ * 
+ * CPUs that fail to start are dropped (see machine_start_cpu()), so once the
+ * application processors have been started, this is the number of CPUs that
+ * are online.
+ * 
+ * @return number of CPUs
+ */
+int machine_get_cpu_count(void) {
+    return cpus.count;
+}
+
+/**
+ * Get the index of the current CPU
+ * 
+ * @return CPU index, zero for the bootstrap processor
+ */
+int machine_get_current_cpu(void) {
+    return get_percpu_data()->cpu;
+}
+
+/**
+ * Interrupt another CPU so it reconsiders what to run
+ * 
+ * This wakes up the CPU if it is idle.
+ * 
+ * @param cpu index of the CPU
+ */
+void machine_wake_cpu(int cpu) {
+    local_apic_send_interrupt(cpus.apic_ids[cpu], IDT_APIC_WAKEUP);
+}
+
+/**
+ * Start an application processor
+ * 
+ * The application processor starts running the specified idle thread, which
+ * must have been prepared with machine_prepare_idle_thread(). This function
+ * waits for the application processor to be online before returning.
+ * 
+ * If the application processor does not come online, it is dropped from the
+ * CPUs and the CPUs that follow it are renumbered, which means the next CPU
+ * to start now has the same index.
+ * 
+ * @param cpu index of the CPU, in range 1..machine_get_cpu_count()-1
+ * @param idle_thread idle thread of the CPU
+ * @return true on success, false on failure
+ */
+bool machine_start_cpu(int cpu, thread_t *idle_thread) {
+    assert(cpu > 0 && cpu < cpus.count);
+
+    percpu_t *cpu_data = (percpu_t *)((char *)cpus.ap_percpu_data + cpu * PERCPU_DATA_ALIGNMENT);
+    init_percpu_data(cpu_data);
+    cpu_data->cpu = cpu;
+
+    /* The trampoline enables paging while running from low memory, so it
+     * needs an address space where it is identity mapped. This temporary
+     * address space is destroyed once the application processor has switched
+     * to the initial address space. */
+    addr_space_t addr_space;
+
+    if(!pmap_create_addr_space(&addr_space)) {
+        return false;
+    }
+
+    if(!pmap_map_identity(&addr_space, AP_STARTUP_ADDR, PAGE_SIZE)) {
+        pmap_destroy_addr_space(&addr_space);
+        return false;
+    }
+
+    ap_startup_params_t *params = (ap_startup_params_t *)(
+        (char *)cpus.trampoline + (ap_trampoline_params - ap_trampoline_start)
+    );
+
+    params->cr0     = get_cr0();
+    params->cr3     = addr_space.cr3;
+    params->cr4     = get_cr4();
+    params->nx      = cpu_has_feature(CPU_FEATURE_NX);
+    params->stack   = (uintptr_t)idle_thread->machine_thread.saved_stack_pointer;
+    params->entry   = (uintptr_t)ap_main;
+    params->arg     = (uintptr_t)cpu_data;
+
+    startup.idle_thread = idle_thread;
+    startup.online      = false;
+
+    const int apic_id = cpus.apic_ids[cpu];
+
+    local_apic_send_init(apic_id);
+
+    udelay(INIT_DELAY_US);
+
+    /* The second startup IPI is only needed if the first one was missed. */
+    for(int attempt = 0; attempt < 2 && !startup.online; ++attempt) {
+        local_apic_send_startup(apic_id, AP_STARTUP_VECTOR);
+        udelay(STARTUP_DELAY_US);
+    }
+
+    for(int us = 0; us < ONLINE_TIMEOUT_US && !startup.online; ++us) {
+        iodelay();
+    }
+
+    if(!startup.online) {
+        /* Put the processor back in the wait-for-SIPI state before destroying
+         * the address space it might be running in. */
+        local_apic_send_init(apic_id);
+        warn(WARNING "CPU %d (local APIC ID %d) did not come online.", cpu, apic_id);
+
+        --cpus.count;
+
+        for(int idx = cpu; idx < cpus.count; ++idx) {
+            cpus.apic_ids[idx] = cpus.apic_ids[idx + 1];
+        }
+    }
+
+    pmap_destroy_addr_space(&addr_space);
+
+    if(startup.online) {
+        cpus.percpu[cpu] = cpu_data;
+        ++cpus.online;
+    }
+
+    return startup.online;
+}
+
+/**
+ * Invalidate TLB entries on the other CPUs
+ * 
+ * This function must be called after changing or removing page table entries
+ * that other CPUs might have cached. The caller is responsible for invalidating
+ * the TLB entries of the current CPU (see pmap_invalidate_local()). For user
+ * space mappings, only the CPUs that run in the address space are interrupted.
+ * 
+ * This function returns once all interrupted CPUs have invalidated their TLB
+ * entries, so the page frames that were mapped can then be reused safely.
+ * 
+ * @param addr_space address space, NULL for kernel mappings
+ * @param addr start address of the range
+ * @param size size of the range, zero to flush all user space entries
+ */
+void tlb_shootdown(const addr_space_t *addr_space, addr_t addr, size_t size) {
+    /* This is also called before init_smp() during initialization. */
+    if(cpus.online <= 1) {
+        return;
+    }
+
+    /* Taking the lock is a full memory barrier, so the page table entries are
+     * updated before the current address space of the other CPUs is checked
+     * (see pmap_switch_addr_space()). */
+    spin_lock(&shootdown.lock);
+
+    shootdown.addr_space    = addr_space;
+    shootdown.addr          = addr;
+    shootdown.size          = size;
+
+    const int self  = machine_get_current_cpu();
+    int count       = 0;
+
+    for(int cpu = 0; cpu < cpus.online; ++cpu) {
+        if(cpu == self) {
+            continue;
+        }
+
+        if(addr_space != NULL && cpus.percpu[cpu]->current_addr_space != addr_space) {
+            continue;
+        }
+
+        shootdown.is_pending[cpu] = true;
+        ++count;
+    }
+
+    if(count > 0) {
+        swap_atomic(&tlb_shootdown_remaining, count);
+
+        for(int cpu = 0; cpu < cpus.online; ++cpu) {
+            if(shootdown.is_pending[cpu]) {
+                local_apic_send_interrupt(cpus.apic_ids[cpu], IDT_APIC_TLB_SHOOTDOWN);
+            }
+        }
+
+        const volatile int *remaining = &tlb_shootdown_remaining;
+
+        while(*remaining > 0) {
+            pause();
+        }
+    }
+
+    spin_unlock(&shootdown.lock);
+}
+
+/**
+ * Service the current TLB shootdown request if it targets the current CPU
+ * 
+ * This function is called by the TLB shootdown interrupt handler and by
+ * code that busy waits with interrupts disabled.
+ */
+void service_tlb_shootdown(void) {
+    const int cpu = machine_get_current_cpu();
+
+    if(!swap_atomic(&shootdown.is_pending[cpu], false)) {
+        return;
+    }
+
+    pmap_invalidate_local(shootdown.addr_space, shootdown.addr, shootdown.size);
+
+    add_atomic(&tlb_shootdown_remaining, -1);
+}
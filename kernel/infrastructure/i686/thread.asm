@@ -87,6 +87,17 @@ switch_thread_stack:
     ; switching (to thread). This is where we actually switch thread.
     mov esp, [esi]      ; saved stack pointer is the first member
 
+    ; The stack of the from thread is no longer in use, so another CPU can now
+    ; switch to it (see machine_wait_thread_off_cpu()). This is done before
+    ; calling the cleanup handler, which may release the lock of a ready queue
+    ; the from thread is on.
+    or ecx, ecx
+    jz .from_done
+
+    mov dword [ecx + MACHINE_THREAD_OFFSET_IS_ON_CPU], 0
+
+.from_done:
+
     ; Call the cleanup handler, if any
     pop eax
     or eax, eax
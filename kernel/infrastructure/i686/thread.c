@@ -40,6 +40,7 @@
 #include <kernel/infrastructure/i686/fpu.h>
 #include <kernel/infrastructure/i686/descriptors.h>
 #include <kernel/infrastructure/i686/percpu.h>
+#include <kernel/infrastructure/i686/smp.h>
 #include <kernel/infrastructure/i686/thread.h>
 #include <kernel/infrastructure/i686/types.h>
 #include <kernel/interface/i686/trap.h>
@@ -105,6 +106,10 @@ void *get_thread_fpu_area(thread_t *thread) {
 }
 
 void machine_prepare_thread(thread_t *thread, const thread_params_t *params) {
+    /* A thread that is reused after it exited might still be running on the
+     * CPU that is switching away from it. */
+    machine_wait_thread_off_cpu(thread);
+
     /* setup stack for initial return to user space */
     void *kernel_stack_base = get_kernel_stack_base(thread);
 
@@ -137,8 +142,34 @@ void machine_prepare_thread(thread_t *thread, const thread_params_t *params) {
     prepare_fpu_area(thread);
 }
 
+void machine_prepare_idle_thread(thread_t *thread, void (*entry)(void)) {
+    /* The idle thread never returns to user space, so there is no trap frame.
+     * Its stack only contains a return address for the entry function, which
+     * never returns, and the context switch_thread_stack() restores. */
+    uint32_t *return_address = (uint32_t *)get_kernel_stack_base(thread) - 1;
+    *return_address = 0;
+
+    kernel_context_t *kernel_context = (kernel_context_t *)return_address - 1;
+
+    memset(kernel_context, 0, sizeof(kernel_context_t));
+
+    kernel_context->eip = (uint32_t)entry;
+
+    machine_thread_t *machine_thread = &thread->machine_thread;
+    machine_thread->saved_stack_pointer = (addr_t)kernel_context;
+    machine_thread->flags               = THREAD_FLAG_NONE;
+
+    prepare_fpu_area(thread);
+}
+
 thread_t *machine_alloc_thread(void) {
-    return page_alloc();
+    thread_t *thread = page_alloc();
+
+    if(thread != NULL) {
+        thread->machine_thread.is_on_cpu = false;
+    }
+
+    return thread;
 }
 
 void machine_free_thread(thread_t *thread) {
@@ -173,10 +204,36 @@ void machine_switch_thread(thread_t *from, thread_t *to) {
 
     machine_thread_t *machine_from  = (from == NULL) ? NULL : &from->machine_thread;
     machine_thread_t *machine_to    = &to->machine_thread;
+
+    /* Cleared by switch_thread_stack() once this CPU switches away from the
+     * thread. */
+    machine_to->is_on_cpu = true;
     
     switch_thread_stack(machine_from, machine_to);
 }
 
+/**
+ * Wait until no CPU is running a thread
+ *
+ * A thread that blocks can be woken up by another CPU before the CPU it runs
+ * on is done switching away from it, i.e. while its kernel stack is still in
+ * use. The scheduler calls this function before making such a thread ready to
+ * run or switching to it.
+ *
+ * @param thread the thread
+ *
+ */
+void machine_wait_thread_off_cpu(const thread_t *thread) {
+    const volatile int *is_on_cpu = &thread->machine_thread.is_on_cpu;
+
+    while(*is_on_cpu) {
+        /* The other CPU might be waiting for this one to service a TLB
+         * shootdown request before it can switch. */
+        service_tlb_shootdown();
+        pause();
+    }
+}
+
 static void unref_cleanup_handler(void *arg) {
     thread_t *thread = arg;
     object_sub_ref(&thread->header);
@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <kernel/application/asm/ticks.h>
+#include <kernel/domain/services/logging.h>
+#include <kernel/infrastructure/i686/drivers/lapic.h>
+#include <kernel/infrastructure/i686/drivers/pit8253.h>
+#include <kernel/infrastructure/i686/cpuinfo.h>
+#include <kernel/infrastructure/i686/isa/instrs.h>
+#include <kernel/infrastructure/i686/timer.h>
+#include <kernel/machine/timer.h>
+#include <kernel/utils/utils.h>
+#include <stdbool.h>
+
+/* Time is kept with the time stamp counter (TSC). The rates of the TSC and of
+ * the local APIC timer are both measured against the programmable interval
+ * timer (PIT) during initialization. Instead of interrupting each CPU
+ * periodically, the local APIC timer is armed as needed for a specific
+ * deadline. TSC-deadline mode is used if it is supported and the TSC is
+ * invariant, i.e. it runs at a constant rate whatever the power state of the
+ * CPU. Otherwise, one-shot mode is used so timer interrupts are driven by the
+ * local APIC timer's own clock, although time keeping still assumes the TSC
+ * rate does not change. */
+
+/** duration of the calibration, in milliseconds */
+#define CALIBRATION_MS      50
+
+/** number of PIT input clock cycles for the calibration */
+#define CALIBRATION_COUNT   ROUND_DIVIDE(PIT8253_FREQ_N * 1000 * CALIBRATION_MS, PIT8253_FREQ_D)
+
+static struct {
+    /** value of the TSC at tick zero */
+    uint64_t    boot_tsc;
+    /** number of TSC cycles per tick */
+    uint64_t    tsc_per_tick;
+    /** number of local APIC timer counts per tick */
+    uint32_t    counts_per_tick;
+    /** latest deadline that does not overflow once converted to TSC cycles */
+    uint64_t    max_deadline;
+    /** whether the local APIC timer is used in TSC-deadline mode */
+    bool        tsc_deadline;
+} clock;
+
+/**
+ * Convert a count measured during calibration to a count per tick
+ *
+ * @param count count measured over CALIBRATION_COUNT PIT input clock cycles
+ * @return count per tick
+ */
+static uint64_t per_tick(uint64_t count) {
+    const uint64_t numerator    = count * PIT8253_FREQ_N * 1000000;
+    const uint64_t denominator  = (uint64_t)CALIBRATION_COUNT * PIT8253_FREQ_D * TICKS_PER_SECOND;
+
+    return (numerator + denominator / 2) / denominator;
+}
+
+/**
+ * Measure the number of TSC cycles and local APIC timer counts per tick
+ * 
+ * This is done by running the local APIC timer with its interrupt masked for
+ * CALIBRATION_MS milliseconds, as measured with counter 2 of the PIT.
+ */
+static void calibrate(void) {
+    const uint32_t initial_count = 0xffffffff;
+
+    local_apic_init_timer(APIC_LVT_TIMER_ONE_SHOT | APIC_LVT_MASKED);
+
+    pit8253_start_countdown(CALIBRATION_COUNT);
+
+    local_apic_start_timer(initial_count);
+
+    const uint64_t start = rdtsc();
+
+    while(! pit8253_countdown_done()) {
+        /* wait */
+    }
+
+    const uint64_t end      = rdtsc();
+    const uint32_t count    = local_apic_get_timer_count();
+
+    clock.boot_tsc          = end;
+    clock.tsc_per_tick      = per_tick(end - start);
+    clock.counts_per_tick   = (uint32_t)per_tick(initial_count - count);
+    clock.max_deadline      = (~UINT64_C(0) - clock.boot_tsc) / clock.tsc_per_tick;
+}
+
+/**
+ * Set the mode of the local APIC timer of the current CPU
+ */
+static void set_timer_mode(void) {
+    if(clock.tsc_deadline) {
+        local_apic_init_timer(APIC_LVT_TIMER_TSC_DEADLINE);
+    } else {
+        local_apic_init_timer(APIC_LVT_TIMER_ONE_SHOT);
+    }
+}
+
+/**
+ * Initialize time keeping and the timer of the bootstrap processor
+ * 
+ * This must be called after the local APIC has been initialized.
+ */
+void init_timer(void) {
+    clock.tsc_deadline =
+           cpu_has_feature(CPU_FEATURE_TSC_DEADLINE)
+        && cpu_has_feature(CPU_FEATURE_INVARIANT_TSC);
+
+    calibrate();
+
+    info(
+        "TSC frequency is %u kHz, using %s timer.",
+        (unsigned int)(clock.tsc_per_tick * TICKS_PER_SECOND / 1000),
+        clock.tsc_deadline ? "TSC-deadline" : "one-shot"
+    );
+
+    info(
+        "Local APIC timer frequency is %u kHz, TSC is %sinvariant.",
+        (unsigned int)(clock.counts_per_tick * TICKS_PER_SECOND / 1000),
+        cpu_has_feature(CPU_FEATURE_INVARIANT_TSC) ? "" : "not "
+    );
+
+    set_timer_mode();
+}
+
+/**
+ * Initialize the timer of an application processor
+ * 
+ * The calibration done on the bootstrap processor applies to all CPUs.
+ */
+void init_timer_ap(void) {
+    set_timer_mode();
+}
+
+/**
+ * Get the number of ticks since boot
+ * 
+ * The TSCs of all CPUs are assumed to be synchronized, so this is the same
+ * value on all CPUs.
+ * 
+ * @return number of ticks
+ */
+uint64_t machine_get_ticks(void) {
+    return (rdtsc() - clock.boot_tsc) / clock.tsc_per_tick;
+}
+
+/**
+ * Arm the timer of the current CPU
+ * 
+ * The timer interrupt occurs once, when the tick count reaches the deadline or
+ * immediately if it already has. In one-shot mode, the interrupt might occur
+ * earlier if the deadline is too far in the future for the local APIC timer.
+ * 
+ * @param deadline tick count at which the timer interrupt occurs
+ */
+void machine_set_timer(uint64_t deadline) {
+    if(deadline > clock.max_deadline) {
+        deadline = clock.max_deadline;
+    }
+
+    const uint64_t target = clock.boot_tsc + deadline * clock.tsc_per_tick;
+
+    if(clock.tsc_deadline) {
+        local_apic_set_timer_deadline(target);
+        return;
+    }
+
+    const uint64_t now  = rdtsc();
+    uint32_t count      = 1;
+
+    if(target > now) {
+        const uint64_t remaining    = target - now;
+        const uint64_t max_ticks    = UINT32_C(0xffffffff) / clock.counts_per_tick;
+
+        if(remaining >= max_ticks * clock.tsc_per_tick) {
+            count = max_ticks * clock.counts_per_tick;
+        } else {
+            /* Round up so the interrupt does not occur just before the
+             * deadline. */
+            count = (remaining * clock.counts_per_tick + clock.tsc_per_tick - 1) / clock.tsc_per_tick;
+        }
+    }
+
+    local_apic_start_timer(count);
+}
@@ -0,0 +1,149 @@
+; Copyright (C) 2026 Philippe Aubertin.
+; All rights reserved.
+;
+; Redistribution and use in source and binary forms, with or without
+; modification, are permitted provided that the following conditions
+; are met:
+; 
+; 1. Redistributions of source code must retain the above copyright
+;    notice, this list of conditions and the following disclaimer.
+; 
+; 2. Redistributions in binary form must reproduce the above copyright
+;    notice, this list of conditions and the following disclaimer in the
+;    documentation and/or other materials provided with the distribution.
+; 
+; 3. Neither the name of the author nor the names of other contributors
+;    may be used to endorse or promote products derived from this software
+;    without specific prior written permission.
+; 
+; THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+; ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+; WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+; DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+; DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+; (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+; ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+; (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+; SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <kernel/infrastructure/i686/asm/descriptors.h>
+#include <kernel/infrastructure/i686/asm/msr.h>
+#include <kernel/infrastructure/i686/asm/smp.h>
+#include <kernel/infrastructure/i686/asm/x86.h>
+
+; Segment selectors in the trampoline's temporary GDT
+#define AP_CODE_SEG 1
+#define AP_DATA_SEG 2
+
+; Physical address of a label once the trampoline has been copied
+#define AP_ADDR(label) (AP_STARTUP_ADDR + (label - ap_trampoline_start))
+
+; ------------------------------------------------------------------------------
+; Application processor startup trampoline
+; ------------------------------------------------------------------------------
+; This code is not called directly. The bootstrap processor copies everything
+; between ap_trampoline_start and ap_trampoline_end to AP_STARTUP_ADDR, fills
+; the parameters block (see ap_startup_params_t) and then sends the startup
+; IPI. The application processor starts executing here in real mode with CS
+; set to AP_STARTUP_ADDR >> 4 and IP set to zero.
+;
+; The trampoline enters protected mode, loads the control registers provided
+; by the bootstrap processor (which enables paging), switches to the stack of
+; the idle thread and jumps to the entry point with the argument on the stack.
+; The page table pointed to by the CR3 value maps the trampoline at its
+; physical address as well as the kernel.
+; ------------------------------------------------------------------------------
+    align 16
+
+    global ap_trampoline_start
+ap_trampoline_start:
+    bits 16
+
+    cli
+    cld
+
+    mov ax, cs
+    mov ds, ax
+
+    ; Load the temporary GDT (address is relative to ds)
+    lgdt [gdt_info - ap_trampoline_start]
+
+    ; Enter protected mode
+    mov eax, cr0
+    or eax, 1
+    mov cr0, eax
+
+    ; Jump far to set CS
+    jmp dword SEG_SELECTOR(AP_CODE_SEG, RPL_KERNEL):AP_ADDR(code_32)
+
+code_32:
+    bits 32
+
+    mov ax, SEG_SELECTOR(AP_DATA_SEG, RPL_KERNEL)
+    mov ds, ax
+    mov es, ax
+    mov fs, ax
+    mov gs, ax
+    mov ss, ax
+
+    mov ebx, AP_ADDR(ap_trampoline_params)
+
+    ; Set CR4 first since it enables PAE, if needed, before paging is enabled
+    mov eax, [ebx + AP_PARAMS_OFFSET_CR4]
+    mov cr4, eax
+
+    mov eax, [ebx + AP_PARAMS_OFFSET_CR3]
+    mov cr3, eax
+
+    ; Enable support for NX/XD bit if the bootstrap processor uses it
+    cmp dword [ebx + AP_PARAMS_OFFSET_NX], 0
+    jz .skip_nx
+
+    mov ecx, MSR_EFER
+    rdmsr
+    or eax, MSR_FLAG_EFER_NXE
+    wrmsr
+
+.skip_nx:
+    ; Enable paging, along with everything else the bootstrap processor has
+    ; enabled in CR0 (write protection, caches, FPU settings)
+    mov eax, [ebx + AP_PARAMS_OFFSET_CR0]
+    mov cr0, eax
+
+    ; Switch to the kernel stack and call the entry point, which never returns
+    mov esp, [ebx + AP_PARAMS_OFFSET_STACK]
+    mov eax, [ebx + AP_PARAMS_OFFSET_ENTRY]
+    push dword [ebx + AP_PARAMS_OFFSET_ARG]
+    push dword 0                ; return address
+    xor ebp, ebp                ; terminate call stack dumps here
+    jmp eax
+
+    ; --------------------------------------------------------------------------
+    ; Temporary Global Descriptor Table
+    ; --------------------------------------------------------------------------
+    align 16
+gdt:
+.null:  dd 0, 0
+.code:  dw 0xffff, 0, 0x9a00, 0x00cf
+.data:  dw 0xffff, 0, 0x9200, 0x00cf
+.end:
+
+    align 4
+    dw 0
+
+gdt_info:
+.limit: dw gdt.end - gdt - 1
+.addr:  dd AP_ADDR(gdt)
+
+    ; --------------------------------------------------------------------------
+    ; Parameters filled by the bootstrap processor
+    ; --------------------------------------------------------------------------
+    align 4
+
+    global ap_trampoline_params
+ap_trampoline_params:
+    times AP_PARAMS_SIZE db 0
+
+    global ap_trampoline_end
+ap_trampoline_end:
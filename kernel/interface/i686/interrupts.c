@@ -36,6 +36,7 @@
 #include <kernel/infrastructure/i686/drivers/pic8259.h>
 #include <kernel/infrastructure/i686/isa/regs.h>
 #include <kernel/infrastructure/i686/fpu.h>
+#include <kernel/infrastructure/i686/smp.h>
 #include <kernel/interface/i686/asm/exceptions.h>
 #include <kernel/interface/i686/asm/idt.h>
 #include <kernel/interface/i686/asm/irq.h>
@@ -104,6 +105,13 @@ void handle_interrupt(trapframe_t *trapframe) {
     } else if(trapno == IDT_APIC_TIMER) {
         tick_interrupt();
         local_apic_eoi();
+    } else if(trapno == IDT_APIC_TLB_SHOOTDOWN) {
+        service_tlb_shootdown();
+        local_apic_eoi();
+    } else if(trapno == IDT_APIC_WAKEUP) {
+        /* Nothing else to do here: the scheduler runs before returning from
+         * the trap. */
+        local_apic_eoi();
     } else if(trapno == IDT_APIC_SPURIOUS) {
         spurious_interrupt();
     } else if(trapno >= IDT_PIC8259_BASE && trapno < IDT_PIC8259_BASE + PIC8259_IRQ_COUNT) {
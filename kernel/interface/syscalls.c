@@ -30,6 +30,7 @@
  */
 
 #include <jinue/shared/asm/errno.h>
+#include <jinue/shared/asm/ipc.h>
 #include <jinue/shared/asm/signal.h>
 #include <jinue/shared/asm/syscalls.h>
 #include <jinue/shared/asm/mman.h>
@@ -46,6 +47,7 @@
 #include <kernel/utils/utils.h>
 #include <kernel/utils/pmap.h>
 #include <limits.h>
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -91,6 +93,22 @@ static int get_descriptor(uintptr_t value) {
     return (int)value;
 }
 
+static int get_message_flags(uintptr_t value) {
+    return value & (JINUE_IPC_BULK | JINUE_IPC_DESCS | JINUE_IPC_NONBLOCK);
+}
+
+static int get_send_flags(uintptr_t value) {
+    return get_message_flags(value) | (value & JINUE_IPC_ASYNC);
+}
+
+static int get_channel_side(uintptr_t value) {
+    if(value != JINUE_CHANNEL_CONSUMER && value != JINUE_CHANNEL_PRODUCER) {
+        return -JINUE_EINVAL;
+    }
+
+    return value;
+}
+
 static void sys_nosys(trapframe_t *trapframe) {
     set_error(trapframe, JINUE_ENOSYS);
 }
@@ -165,21 +183,249 @@ static void sys_get_address_map(trapframe_t *trapframe) {
     set_return_value_or_error(trapframe, retval);
 }
 
+static void sys_get_kmalloc_stats(trapframe_t *trapframe) {
+    jinue_buffer_t buffer;
+
+    buffer.addr     = (void *)msg_arg1(trapframe);
+    buffer.size     = msg_arg2(trapframe);
+
+    if(! check_userspace_buffer(buffer.addr, buffer.size)) {
+        set_error(trapframe, JINUE_EINVAL);
+        return;
+    }
+
+    int retval = get_kmalloc_stats(&buffer);
+    set_return_value_or_error(trapframe, retval);
+}
+
 static void sys_create_endpoint(trapframe_t *trapframe) {
-    int fd = get_descriptor(msg_arg1(trapframe));
+    int fd      = get_descriptor(msg_arg1(trapframe));
+    int flags   = msg_arg2(trapframe);
 
     if(fd < 0) {
         set_return_value_or_error(trapframe, fd);
         return;  
     }
 
-    int retval = create_endpoint(fd);
+    if((flags & ~JINUE_ENDPOINT_LIFO) != 0) {
+        set_error(trapframe, JINUE_EINVAL);
+        return;
+    }
+
+    int retval = create_endpoint(fd, flags);
+    set_return_value_or_error(trapframe, retval);
+}
+
+static void sys_create_endpoint_set(trapframe_t *trapframe) {
+    int fd = get_descriptor(msg_arg1(trapframe));
+
+    if(fd < 0) {
+        set_return_value_or_error(trapframe, fd);
+        return;
+    }
+
+    int retval = create_endpoint_set(fd);
+    set_return_value_or_error(trapframe, retval);
+}
+
+static void sys_add_to_endpoint_set(trapframe_t *trapframe) {
+    int set_fd      = get_descriptor(msg_arg1(trapframe));
+    int endpoint_fd = get_descriptor(msg_arg2(trapframe));
+
+    if(set_fd < 0) {
+        set_return_value_or_error(trapframe, set_fd);
+        return;
+    }
+
+    if(endpoint_fd < 0) {
+        set_return_value_or_error(trapframe, endpoint_fd);
+        return;
+    }
+
+    int retval = add_to_endpoint_set(set_fd, endpoint_fd);
+    set_return_value_or_error(trapframe, retval);
+}
+
+static void sys_create_notification(trapframe_t *trapframe) {
+    int fd = get_descriptor(msg_arg1(trapframe));
+
+    if(fd < 0) {
+        set_return_value_or_error(trapframe, fd);
+        return;
+    }
+
+    int retval = create_notification(fd);
+    set_return_value_or_error(trapframe, retval);
+}
+
+static void sys_notify(trapframe_t *trapframe) {
+    int fd = get_descriptor(msg_arg1(trapframe));
+
+    if(fd < 0) {
+        set_return_value_or_error(trapframe, fd);
+        return;
+    }
+
+    int retval = notify(fd, msg_arg2(trapframe));
+    set_return_value_or_error(trapframe, retval);
+}
+
+static void sys_wait_notification(trapframe_t *trapframe) {
+    int fd = get_descriptor(msg_arg1(trapframe));
+
+    if(fd < 0) {
+        set_return_value_or_error(trapframe, fd);
+        return;
+    }
+
+    uintptr_t bits;
+    int retval = wait_notification(fd, &bits);
+
+    if(retval < 0) {
+        set_error(trapframe, -retval);
+        return;
+    }
+
+    set_return_value(trapframe, 0);
+    msg_arg1(trapframe) = bits;
+}
+
+static void sys_bind_notification(trapframe_t *trapframe) {
+    int fd          = get_descriptor(msg_arg1(trapframe));
+    int target_fd   = get_descriptor(msg_arg2(trapframe));
+
+    if(fd < 0) {
+        set_return_value_or_error(trapframe, fd);
+        return;
+    }
+
+    if(target_fd < 0) {
+        set_return_value_or_error(trapframe, target_fd);
+        return;
+    }
+
+    int retval = bind_notification(fd, target_fd);
+    set_return_value_or_error(trapframe, retval);
+}
+
+static void sys_create_completion_queue(trapframe_t *trapframe) {
+    int fd = get_descriptor(msg_arg1(trapframe));
+
+    if(fd < 0) {
+        set_return_value_or_error(trapframe, fd);
+        return;
+    }
+
+    int retval = create_completion_queue(fd);
+    set_return_value_or_error(trapframe, retval);
+}
+
+static void sys_wait_completions(trapframe_t *trapframe) {
+    int flags                       = msg_arg1(trapframe) & JINUE_IPC_NONBLOCK;
+    int fd                          = get_descriptor(msg_arg1(trapframe) & ~flags);
+    jinue_completion_t *completions = (jinue_completion_t *)msg_arg2(trapframe);
+    size_t length                   = msg_arg3(trapframe);
+
+    if(fd < 0) {
+        set_return_value_or_error(trapframe, fd);
+        return;
+    }
+
+    if(length == 0) {
+        set_error(trapframe, JINUE_EINVAL);
+        return;
+    }
+
+    /* There are never more completions than this to collect. */
+    if(length > JINUE_MAX_ASYNC_REQUESTS) {
+        length = JINUE_MAX_ASYNC_REQUESTS;
+    }
+
+    if(! check_userspace_buffer(completions, length * sizeof(jinue_completion_t))) {
+        set_error(trapframe, JINUE_EINVAL);
+        return;
+    }
+
+    int retval = wait_completions(fd, flags, completions, length);
+    set_return_value_or_error(trapframe, retval);
+}
+
+static void sys_create_channel(trapframe_t *trapframe) {
+    int fd = get_descriptor(msg_arg1(trapframe));
+
+    if(fd < 0) {
+        set_return_value_or_error(trapframe, fd);
+        return;
+    }
+
+    int retval = create_channel(fd, msg_arg2(trapframe), msg_arg3(trapframe));
+    set_return_value_or_error(trapframe, retval);
+}
+
+static void sys_map_channel(trapframe_t *trapframe) {
+    int process_fd  = get_descriptor(msg_arg1(trapframe));
+    int channel_fd  = get_descriptor(msg_arg2(trapframe));
+    void *addr      = (void *)msg_arg3(trapframe);
+
+    if(process_fd < 0) {
+        set_return_value_or_error(trapframe, process_fd);
+        return;
+    }
+
+    if(channel_fd < 0) {
+        set_return_value_or_error(trapframe, channel_fd);
+        return;
+    }
+
+    if(OFFSET_OF_PTR(addr, PAGE_SIZE) != 0) {
+        set_error(trapframe, JINUE_EINVAL);
+        return;
+    }
+
+    int retval = map_channel(process_fd, channel_fd, addr);
+    set_return_value_or_error(trapframe, retval);
+}
+
+static void sys_wait_channel(trapframe_t *trapframe) {
+    int fd      = get_descriptor(msg_arg1(trapframe));
+    int side    = get_channel_side(msg_arg2(trapframe));
+
+    if(fd < 0) {
+        set_return_value_or_error(trapframe, fd);
+        return;
+    }
+
+    if(side < 0) {
+        set_return_value_or_error(trapframe, side);
+        return;
+    }
+
+    int retval = wait_channel(fd, side);
+    set_return_value_or_error(trapframe, retval);
+}
+
+static void sys_signal_channel(trapframe_t *trapframe) {
+    int fd      = get_descriptor(msg_arg1(trapframe));
+    int side    = get_channel_side(msg_arg2(trapframe));
+
+    if(fd < 0) {
+        set_return_value_or_error(trapframe, fd);
+        return;
+    }
+
+    if(side < 0) {
+        set_return_value_or_error(trapframe, side);
+        return;
+    }
+
+    int retval = signal_channel(fd, side);
     set_return_value_or_error(trapframe, retval);
 }
 
 static int copy_message_struct_from_userspace(
         jinue_message_t         *message,
-        const jinue_message_t   *userspace_message) {
+        const jinue_message_t   *userspace_message,
+        int                      flags) {
 
     if(! check_userspace_buffer(userspace_message, sizeof(jinue_message_t))) {
         return -JINUE_EINVAL;
@@ -190,6 +436,59 @@ static int copy_message_struct_from_userspace(
     message->recv_buffers           = userspace_message->recv_buffers;
     message->recv_buffers_length    = userspace_message->recv_buffers_length;
 
+    /* The bulk and descriptor members are only read if the caller asked for
+     * them so callers that don't know about them don't need to initialize
+     * them. */
+    if(flags & JINUE_IPC_BULK) {
+        message->send_bulk          = userspace_message->send_bulk;
+        message->bulk_window        = userspace_message->bulk_window;
+    }
+    else {
+        message->send_bulk.addr     = NULL;
+        message->send_bulk.size     = 0;
+        message->bulk_window.addr   = NULL;
+        message->bulk_window.size   = 0;
+    }
+
+    if(flags & JINUE_IPC_DESCS) {
+        message->send_descs         = userspace_message->send_descs;
+        message->send_descs_length  = userspace_message->send_descs_length;
+        message->recv_descs         = userspace_message->recv_descs;
+        message->recv_descs_length  = userspace_message->recv_descs_length;
+    }
+    else {
+        message->send_descs         = NULL;
+        message->send_descs_length  = 0;
+        message->recv_descs         = NULL;
+        message->recv_descs_length  = 0;
+    }
+
+    message->recv_descs_count       = 0;
+
+    return 0;
+}
+
+static bool check_bulk_buffer(const void *addr, size_t size) {
+    if(OFFSET_OF_PTR(addr, PAGE_SIZE) != 0 || OFFSET_OF_PTR(size, PAGE_SIZE) != 0) {
+        return false;
+    }
+
+    if(size > JINUE_MAX_BULK_SIZE) {
+        return false;
+    }
+
+    return check_userspace_buffer(addr, size);
+}
+
+static int check_bulk_buffers(const jinue_message_t *message) {
+    if(! check_bulk_buffer(message->send_bulk.addr, message->send_bulk.size)) {
+        return -JINUE_EINVAL;
+    }
+
+    if(! check_bulk_buffer(message->bulk_window.addr, message->bulk_window.size)) {
+        return -JINUE_EINVAL;
+    }
+
     return 0;
 }
 
@@ -200,6 +499,16 @@ static int check_send_buffers(const jinue_message_t *message) {
         return -JINUE_EINVAL;
     }
 
+    if(message->send_descs_length > JINUE_MAX_DESCS_IN_MESSAGE) {
+        return -JINUE_EINVAL;
+    }
+
+    size_t send_descs_size = message->send_descs_length * sizeof(jinue_send_desc_t);
+
+    if(! check_userspace_buffer(message->send_descs, send_descs_size)) {
+        return -JINUE_EINVAL;
+    }
+
     return 0;
 }
 
@@ -210,51 +519,100 @@ static int check_recv_buffers(const jinue_message_t *message) {
         return -JINUE_EINVAL;
     }
 
+    if(message->recv_descs_length > JINUE_MAX_DESCS_IN_MESSAGE) {
+        return -JINUE_EINVAL;
+    }
+
+    size_t recv_descs_size = message->recv_descs_length * sizeof(int);
+
+    if(! check_userspace_buffer(message->recv_descs, recv_descs_size)) {
+        return -JINUE_EINVAL;
+    }
+
     return 0;
 }
 
-static void sys_send(trapframe_t *trapframe) {
-    int function            = msg_arg0(trapframe);
-    int fd                  = get_descriptor(msg_arg1(trapframe));
-    void *userspace_message = (void *)msg_arg2(trapframe);
+static int send_from_userspace(
+        uintptr_t           *errcode,
+        int                  function,
+        uintptr_t            fd_and_flags,
+        jinue_message_t     *userspace_message,
+        uintptr_t            arg3) {
+
+    int flags   = get_send_flags(fd_and_flags);
+    int fd      = get_descriptor(fd_and_flags & ~flags);
 
     if(fd < 0) {
-        set_return_value_or_error(trapframe, fd);
-        return;
+        return fd;
+    }
+
+    /* Lending pages and transferring descriptors both require the sending
+     * thread to wait for the reply. */
+    if((flags & JINUE_IPC_ASYNC) && (flags & (JINUE_IPC_BULK | JINUE_IPC_DESCS))) {
+        return -JINUE_EINVAL;
     }
 
     /* Let's be careful here: we need to first copy the message structure and
      * then check it to protect against the user application modifying the
      * content after the check. */
     jinue_message_t message;
-    int copy_retval = copy_message_struct_from_userspace(&message, userspace_message);
+    int copy_retval = copy_message_struct_from_userspace(&message, userspace_message, flags);
 
     if(copy_retval < 0) {
-        set_return_value_or_error(trapframe, copy_retval);
-        return;
+        return copy_retval;
     }
 
     int send_checkval = check_send_buffers(&message);
 
     if(send_checkval < 0) {
-        set_return_value_or_error(trapframe, send_checkval);
-        return;
+        return send_checkval;
+    }
+
+    int bulk_checkval = check_bulk_buffers(&message);
+
+    if(bulk_checkval < 0) {
+        return bulk_checkval;
     }
 
     int recv_checkval = check_recv_buffers(&message);
 
     if(recv_checkval < 0) {
-        set_return_value_or_error(trapframe, recv_checkval);
-        return;
+        return recv_checkval;
     }
 
-    uintptr_t *errcode = &msg_arg2(trapframe);
-    int retval = send(errcode, fd, function, &message);
+    if(flags & JINUE_IPC_ASYNC) {
+        int cq_fd = get_descriptor(arg3);
+
+        if(cq_fd < 0) {
+            return cq_fd;
+        }
+
+        return send_async(fd, function, cq_fd, &message);
+    }
+
+    int retval = send(errcode, fd, function, flags, arg3, &message);
+
+    if(retval >= 0 && (flags & JINUE_IPC_DESCS)) {
+        userspace_message->recv_descs_count = message.recv_descs_count;
+    }
+
+    return retval;
+}
+
+static void sys_send(trapframe_t *trapframe) {
+    uintptr_t errcode;
+
+    int retval = send_from_userspace(
+            &errcode,
+            msg_arg0(trapframe),
+            msg_arg1(trapframe),
+            (jinue_message_t *)msg_arg2(trapframe),
+            msg_arg3(trapframe));
 
     if(retval == -JINUE_EPROTO) {
         msg_arg0(trapframe) = -1;
         msg_arg1(trapframe) = JINUE_EPROTO;
-        /* The error code has already been set in arg2. */
+        msg_arg2(trapframe) = errcode;
         msg_arg3(trapframe) = 0;
         return;
     }
@@ -262,8 +620,59 @@ static void sys_send(trapframe_t *trapframe) {
     set_return_value_or_error(trapframe, retval);
 }
 
+static void sys_send_batch(trapframe_t *trapframe) {
+    jinue_send_entry_t *entries = (jinue_send_entry_t *)msg_arg1(trapframe);
+    size_t length               = msg_arg2(trapframe);
+
+    if(length == 0 || length > JINUE_MAX_BATCH_SIZE) {
+        set_error(trapframe, JINUE_EINVAL);
+        return;
+    }
+
+    if(! check_userspace_buffer(entries, length * sizeof(jinue_send_entry_t))) {
+        set_error(trapframe, JINUE_EINVAL);
+        return;
+    }
+
+    /* Each message is sent as if by a separate call to sys_send() and fails
+     * independently of the others. */
+    for(size_t idx = 0; idx < length; ++idx) {
+        jinue_send_entry_t *entry = &entries[idx];
+
+        /* Copy the arguments before they are checked. */
+        intptr_t function           = entry->function;
+        uintptr_t fd_and_flags      = (uintptr_t)entry->fd;
+        jinue_message_t *message    = entry->message;
+        uintptr_t arg3              = entry->arg3;
+
+        uintptr_t errcode = 0;
+        int retval;
+
+        if(function < JINUE_SYS_USER_BASE) {
+            retval = -JINUE_EINVAL;
+        }
+        else {
+            retval = send_from_userspace(&errcode, function, fd_and_flags, message, arg3);
+        }
+
+        if(retval < 0) {
+            entry->result   = -1;
+            entry->error    = -retval;
+            entry->errcode  = (retval == -JINUE_EPROTO) ? errcode : 0;
+        }
+        else {
+            entry->result   = retval;
+            entry->error    = 0;
+            entry->errcode  = 0;
+        }
+    }
+
+    set_return_value(trapframe, length);
+}
+
 static void sys_receive(trapframe_t *trapframe) {
-    int fd                              = get_descriptor(msg_arg1(trapframe));
+    int flags                           = get_message_flags(msg_arg1(trapframe));
+    int fd                              = get_descriptor(msg_arg1(trapframe) & ~flags);
     jinue_message_t *userspace_message  = (jinue_message_t *)msg_arg2(trapframe);
 
     if(fd < 0) {
@@ -275,13 +684,20 @@ static void sys_receive(trapframe_t *trapframe) {
      * then check it to protect against the user application modifying the
      * content after the check. */
     jinue_message_t message;
-    int copy_retval = copy_message_struct_from_userspace(&message, userspace_message);
+    int copy_retval = copy_message_struct_from_userspace(&message, userspace_message, flags);
 
     if(copy_retval < 0) {
         set_return_value_or_error(trapframe, copy_retval);
         return;
     }
 
+    int bulk_checkval = check_bulk_buffers(&message);
+
+    if(bulk_checkval < 0) {
+        set_return_value_or_error(trapframe, bulk_checkval);
+        return;
+    }
+
     int recv_checkval = check_recv_buffers(&message);
 
     if(recv_checkval < 0) {
@@ -289,24 +705,59 @@ static void sys_receive(trapframe_t *trapframe) {
         return;
     }
 
-    int retval = receive(fd, &message);
+    int retval = receive(fd, flags, msg_arg3(trapframe), &message);
     set_return_value_or_error(trapframe, retval);
 
     if(retval >= 0) {
         userspace_message->recv_function    = message.recv_function;
         userspace_message->recv_cookie      = message.recv_cookie;
         userspace_message->reply_max_size   = message.reply_max_size;
+        userspace_message->recv_endpoint    = message.recv_endpoint;
+
+        if(flags & JINUE_IPC_BULK) {
+            userspace_message->recv_bulk_size = message.recv_bulk_size;
+        }
+
+        if(flags & JINUE_IPC_DESCS) {
+            userspace_message->recv_descs_count = message.recv_descs_count;
+        }
     }
 }
 
+static void sys_receive_batch(trapframe_t *trapframe) {
+    int flags                       = msg_arg1(trapframe) & JINUE_IPC_NONBLOCK;
+    int fd                          = get_descriptor(msg_arg1(trapframe) & ~flags);
+    jinue_recv_entry_t *entries     = (jinue_recv_entry_t *)msg_arg2(trapframe);
+    size_t length                   = msg_arg3(trapframe);
+
+    if(fd < 0) {
+        set_return_value_or_error(trapframe, fd);
+        return;
+    }
+
+    if(length == 0 || length > JINUE_MAX_BATCH_SIZE) {
+        set_error(trapframe, JINUE_EINVAL);
+        return;
+    }
+
+    if(! check_userspace_buffer(entries, length * sizeof(jinue_recv_entry_t))) {
+        set_error(trapframe, JINUE_EINVAL);
+        return;
+    }
+
+    int retval = receive_batch(fd, flags, entries, length);
+    set_return_value_or_error(trapframe, retval);
+}
+
 static void sys_reply(trapframe_t *trapframe) {
+    int flags               = msg_arg1(trapframe) & JINUE_IPC_DESCS;
     void *userspace_message = (void *)msg_arg2(trapframe);
 
     /* Let's be careful here: we need to first copy the message structure and
      * then check it to protect against the user application modifying the
      * content after the check. */
     jinue_message_t message;
-    int copy_retval = copy_message_struct_from_userspace(&message, userspace_message);
+    int copy_retval = copy_message_struct_from_userspace(&message, userspace_message, flags);
 
     if(copy_retval < 0) {
         set_return_value_or_error(trapframe, copy_retval);
@@ -576,6 +1027,54 @@ static void sys_signal_thread(trapframe_t *trapframe) {
     set_return_value_or_error(trapframe, retval);
 }
 
+static void sys_set_thread_priority(trapframe_t *trapframe) {
+    uintptr_t arg1  = msg_arg1(trapframe);
+    int priority    = msg_arg2(trapframe);
+
+    int fd;
+
+    if((int)arg1 == -1) {
+        fd = -1;
+    }
+    else {
+        fd = get_descriptor(arg1);
+
+        if(fd < 0) {
+            set_return_value_or_error(trapframe, fd);
+            return;
+        }
+    }
+
+    int retval = set_thread_priority(fd, priority);
+    set_return_value_or_error(trapframe, retval);
+}
+
+static void sys_get_set_thread_affinity(trapframe_t *trapframe) {
+    uintptr_t arg1      = msg_arg1(trapframe);
+    uint32_t affinity   = msg_arg2(trapframe);
+
+    int fd;
+
+    if((int)arg1 == -1) {
+        fd = -1;
+    }
+    else {
+        fd = get_descriptor(arg1);
+
+        if(fd < 0) {
+            set_return_value_or_error(trapframe, fd);
+            return;
+        }
+    }
+
+    int retval = get_set_thread_affinity(fd, affinity);
+    set_return_value_or_error(trapframe, retval);
+}
+
+static void sys_get_cpu(trapframe_t *trapframe) {
+    set_return_value(trapframe, get_cpu());
+}
+
 static void sys_return_from_signal(trapframe_t *trapframe) {
     const jinue_ucontext_t *ucontext = (const jinue_ucontext_t *)msg_arg1(trapframe);
 
@@ -621,6 +1120,164 @@ static void sys_set_signal_handler(trapframe_t *trapframe) {
     set_signal_handler(handler);
 }
 
+static void sys_reply_receive(trapframe_t *trapframe) {
+    int flags                           = get_message_flags(msg_arg1(trapframe));
+    int fd                              = get_descriptor(msg_arg1(trapframe) & ~flags);
+    jinue_message_t *userspace_message  = (jinue_message_t *)msg_arg2(trapframe);
+
+    if(fd < 0) {
+        set_return_value_or_error(trapframe, fd);
+        return;
+    }
+
+    /* Let's be careful here: we need to first copy the message structure and
+     * then check it to protect against the user application modifying the
+     * content after the check. */
+    jinue_message_t message;
+    int copy_retval = copy_message_struct_from_userspace(&message, userspace_message, flags);
+
+    if(copy_retval < 0) {
+        set_return_value_or_error(trapframe, copy_retval);
+        return;
+    }
+
+    int send_checkval = check_send_buffers(&message);
+
+    if(send_checkval < 0) {
+        set_return_value_or_error(trapframe, send_checkval);
+        return;
+    }
+
+    int bulk_checkval = check_bulk_buffers(&message);
+
+    if(bulk_checkval < 0) {
+        set_return_value_or_error(trapframe, bulk_checkval);
+        return;
+    }
+
+    int recv_checkval = check_recv_buffers(&message);
+
+    if(recv_checkval < 0) {
+        set_return_value_or_error(trapframe, recv_checkval);
+        return;
+    }
+
+    int retval = reply_receive(fd, flags, msg_arg3(trapframe), &message);
+    set_return_value_or_error(trapframe, retval);
+
+    if(retval >= 0) {
+        userspace_message->recv_function    = message.recv_function;
+        userspace_message->recv_cookie      = message.recv_cookie;
+        userspace_message->reply_max_size   = message.reply_max_size;
+        userspace_message->recv_endpoint    = message.recv_endpoint;
+
+        if(flags & JINUE_IPC_BULK) {
+            userspace_message->recv_bulk_size = message.recv_bulk_size;
+        }
+
+        if(flags & JINUE_IPC_DESCS) {
+            userspace_message->recv_descs_count = message.recv_descs_count;
+        }
+    }
+}
+
+static void sys_send_short(trapframe_t *trapframe) {
+    int function    = msg_arg0(trapframe);
+    int flags       = msg_arg1(trapframe) & JINUE_IPC_NONBLOCK;
+    int fd          = get_descriptor(msg_arg1(trapframe) & ~(JINUE_IPC_SHORT | flags));
+
+    if(fd < 0) {
+        set_return_value_or_error(trapframe, fd);
+        return;
+    }
+
+    uintptr_t data[JINUE_SHORT_MESSAGE_WORDS];
+    data[0] = msg_arg2(trapframe);
+    data[1] = msg_arg3(trapframe);
+
+    uintptr_t errcode;
+    int retval = send_short(&errcode, fd, function, flags, data);
+
+    if(retval == -JINUE_EPROTO) {
+        msg_arg0(trapframe) = -1;
+        msg_arg1(trapframe) = JINUE_EPROTO;
+        msg_arg2(trapframe) = errcode;
+        msg_arg3(trapframe) = 0;
+        return;
+    }
+
+    if(retval < 0) {
+        set_error(trapframe, -retval);
+        return;
+    }
+
+    msg_arg0(trapframe) = retval;
+    msg_arg1(trapframe) = 0;
+    msg_arg2(trapframe) = data[0];
+    msg_arg3(trapframe) = data[1];
+}
+
+static void sys_receive_short(trapframe_t *trapframe) {
+    int flags   = msg_arg1(trapframe) & JINUE_IPC_NONBLOCK;
+    int fd      = get_descriptor(msg_arg1(trapframe) & ~(JINUE_IPC_SHORT | flags));
+
+    if(fd < 0) {
+        set_return_value_or_error(trapframe, fd);
+        return;
+    }
+
+    jinue_short_message_t message;
+    int retval = receive_short(fd, flags, &message);
+
+    if(retval < 0) {
+        set_error(trapframe, -retval);
+        return;
+    }
+
+    msg_arg0(trapframe) = message.function;
+    msg_arg1(trapframe) = message.cookie;
+    msg_arg2(trapframe) = message.data[0];
+    msg_arg3(trapframe) = message.data[1];
+}
+
+static void sys_reply_short(trapframe_t *trapframe) {
+    uintptr_t data[JINUE_SHORT_MESSAGE_WORDS];
+    data[0] = msg_arg2(trapframe);
+    data[1] = msg_arg3(trapframe);
+
+    int retval = reply_short(data);
+    set_return_value_or_error(trapframe, retval);
+}
+
+/**
+ * Dispatch a short message system call
+ *
+ * Short messages are passed in registers only and are identified by the
+ * JINUE_IPC_SHORT flag in arg1. This is checked before the regular dispatch
+ * so these calls, which are the most latency-sensitive, take the shortest
+ * path through the kernel.
+ *
+ * @param trapframe trap frame for current system call
+ * @param function function number
+ * @return true if the system call was handled, false otherwise
+ */
+static bool handle_short_ipc(trapframe_t *trapframe, intptr_t function) {
+    if(function >= JINUE_SYS_USER_BASE) {
+        sys_send_short(trapframe);
+    }
+    else if(function == JINUE_SYS_RECEIVE) {
+        sys_receive_short(trapframe);
+    }
+    else if(function == JINUE_SYS_REPLY) {
+        sys_reply_short(trapframe);
+    }
+    else {
+        return false;
+    }
+
+    return true;
+}
+
 /**
  * System call dispatching function
  *
@@ -631,6 +1288,10 @@ static void sys_set_signal_handler(trapframe_t *trapframe) {
  */
 void handle_syscall(trapframe_t *trapframe) {
     intptr_t function = msg_arg0(trapframe);
+
+    if((msg_arg1(trapframe) & JINUE_IPC_SHORT) && handle_short_ipc(trapframe, function)) {
+        return;
+    }
     
     if(function < 0) {
         set_error(trapframe, JINUE_EINVAL);
@@ -710,6 +1371,63 @@ void handle_syscall(trapframe_t *trapframe) {
         case JINUE_SYS_SET_SIGNAL_HANDLER:
             sys_set_signal_handler(trapframe);
             break;
+        case JINUE_SYS_REPLY_RECEIVE:
+            sys_reply_receive(trapframe);
+            break;
+        case JINUE_SYS_CREATE_ENDPOINT_SET:
+            sys_create_endpoint_set(trapframe);
+            break;
+        case JINUE_SYS_ADD_TO_ENDPOINT_SET:
+            sys_add_to_endpoint_set(trapframe);
+            break;
+        case JINUE_SYS_CREATE_NOTIFICATION:
+            sys_create_notification(trapframe);
+            break;
+        case JINUE_SYS_NOTIFY:
+            sys_notify(trapframe);
+            break;
+        case JINUE_SYS_WAIT_NOTIFICATION:
+            sys_wait_notification(trapframe);
+            break;
+        case JINUE_SYS_BIND_NOTIFICATION:
+            sys_bind_notification(trapframe);
+            break;
+        case JINUE_SYS_CREATE_CHANNEL:
+            sys_create_channel(trapframe);
+            break;
+        case JINUE_SYS_MAP_CHANNEL:
+            sys_map_channel(trapframe);
+            break;
+        case JINUE_SYS_WAIT_CHANNEL:
+            sys_wait_channel(trapframe);
+            break;
+        case JINUE_SYS_SIGNAL_CHANNEL:
+            sys_signal_channel(trapframe);
+            break;
+        case JINUE_SYS_SET_THREAD_PRIORITY:
+            sys_set_thread_priority(trapframe);
+            break;
+        case JINUE_SYS_CREATE_COMPLETION_QUEUE:
+            sys_create_completion_queue(trapframe);
+            break;
+        case JINUE_SYS_WAIT_COMPLETIONS:
+            sys_wait_completions(trapframe);
+            break;
+        case JINUE_SYS_SEND_BATCH:
+            sys_send_batch(trapframe);
+            break;
+        case JINUE_SYS_RECEIVE_BATCH:
+            sys_receive_batch(trapframe);
+            break;
+        case JINUE_SYS_GET_SET_THREAD_AFFINITY:
+            sys_get_set_thread_affinity(trapframe);
+            break;
+        case JINUE_SYS_GET_CPU:
+            sys_get_cpu(trapframe);
+            break;
+        case JINUE_SYS_GET_KMALLOC_STATS:
+            sys_get_kmalloc_stats(trapframe);
+            break;
         default:
             sys_nosys(trapframe);
         }
@@ -31,6 +31,7 @@
 # Default test setup parameters
 CPU=core2duo
 MEM=128
+SMP=1
 CMDLINE=""
 OPTIONS=""
 
@@ -80,7 +81,7 @@ run () {
                 -append "${BASE_CMDLINE} ${CMDLINE}" \
                 -serial stdio \
                 -display none \
-                -smp 1 \
+                -smp ${SMP} \
                 -usb \
                 -vga std | tee $LOG
                 ;;
@@ -93,7 +94,7 @@ run () {
                 -drive format=raw,media=cdrom,file="${ISO}" \
                 -serial stdio \
                 -display none \
-                -smp 1 \
+                -smp ${SMP} \
                 -usb \
                 -vga std | tee $LOG
                 ;;
@@ -94,6 +94,11 @@ grep -F "Client thread is exiting." $LOG || fail
 echo "* Check main thread joined the client thread and retrieved its exit value"
 grep -F "Client thread exit value is 0xdeadbeef." $LOG || fail
 
-echo "* Check the main thread initiated the reboot"
+echo "* Check the main thread continued after joining the client thread"
 grep -F "Main thread is running." $LOG || fail
+
+echo "* Check all IPC tests passed"
+grep -F "IPC test result: PASS" $LOG || fail
+
+echo "* Check the main thread initiated the reboot"
 grep -F "Rebooting." $LOG || fail
@@ -0,0 +1,56 @@
+#!/bin/bash
+# Copyright (C) 2026 Philippe Aubertin.
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+# 
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+# 
+# 3. Neither the name of the author nor the names of other contributors
+#    may be used to endorse or promote products derived from this software
+#    without specific prior written permission.
+# 
+# THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+# ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+# WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+# DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+# (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+# LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+# ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+# SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+CMDLINE="RUN_TEST_IPC_BENCHMARK=1"
+
+run
+
+echo "* Check the IPC benchmark ran"
+grep -F "Running IPC benchmark" $LOG || fail
+
+check_no_error
+
+check_no_warning
+
+echo "* Check the staged pass completed"
+RESULT=`grep -F -A 4 "IPC benchmark (staged):" $LOG`
+echo "$RESULT" | grep -E 'bytes per cycle:[ ]+[0-9]+\.[0-9]{2}$' || fail
+
+echo "* Check the direct pass completed"
+RESULT=`grep -F -A 4 "IPC benchmark (direct):" $LOG`
+echo "$RESULT" | grep -E 'bytes per cycle:[ ]+[0-9]+\.[0-9]{2}$' || fail
+
+echo "* Check the null IPC round trips were measured"
+grep -E 'Null IPC round trip \(regular\): [0-9]+ cycles$' $LOG || fail
+grep -E 'Null IPC round trip \(short\): [0-9]+ cycles$' $LOG || fail
+
+echo "* Check the benchmark completed"
+grep -F "IPC benchmark complete." $LOG || fail
+grep -F "Rebooting." $LOG || fail
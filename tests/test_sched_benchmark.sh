@@ -0,0 +1,58 @@
+#!/bin/bash
+# Copyright (C) 2026 Philippe Aubertin.
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+# 
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+# 
+# 3. Neither the name of the author nor the names of other contributors
+#    may be used to endorse or promote products derived from this software
+#    without specific prior written permission.
+# 
+# THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+# ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+# WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+# DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+# (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+# LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+# ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+# SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+SMP=4
+CMDLINE="RUN_TEST_SCHED_BENCHMARK=1"
+
+run
+
+echo "* Check the scheduler benchmark ran"
+grep -F "Running scheduler benchmark..." $LOG || fail
+
+check_no_panic
+
+check_no_error
+
+check_no_warning
+
+echo "* Check all CPUs came online"
+grep -F "4 CPU(s) online." $LOG || fail
+
+echo "* Check the TSC was calibrated"
+grep -E 'TSC runs at [0-9]+ cycles per millisecond\.$' $LOG || fail
+
+echo "* Check each pass completed"
+for N in 1 2 3 4; do
+    grep -E "Scheduler benchmark \($N CPU\(s\)\): [0-9]+ switches/ms$" $LOG || fail
+done
+
+echo "* Check the benchmark completed"
+grep -F "Scheduler benchmark complete." $LOG || fail
+grep -F "Rebooting." $LOG || fail
@@ -0,0 +1,73 @@
+#!/bin/bash
+# Copyright (C) 2026 Philippe Aubertin.
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+# 
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+# 
+# 3. Neither the name of the author nor the names of other contributors
+#    may be used to endorse or promote products derived from this software
+#    without specific prior written permission.
+# 
+# THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+# ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+# WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+# DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+# (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+# LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+# ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+# SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+SMP=4
+CMDLINE="RUN_TEST_SMP=1"
+
+run
+
+check_kernel_start
+
+# If check_no_panic, check_no_error would also fail, but check_no_panic provides
+# more relevant context in the log.
+check_no_panic
+
+check_no_error
+
+check_no_warning
+
+echo "* Check all CPUs were found"
+grep -F "Found 4 CPU(s)." $LOG || fail
+
+echo "* Check all CPUs came online"
+grep -F "4 CPU(s) online." $LOG || fail
+
+echo "* Check the SMP test ran"
+grep -F "Running SMP test..." $LOG || fail
+
+echo "* Check all SMP tests passed"
+grep -F "SMP test result: PASS" $LOG || fail
+
+echo "* Check the TSC and local APIC timer were calibrated"
+grep -E "TSC frequency is [0-9]+ kHz, using (TSC-deadline|one-shot) timer." $LOG || fail
+grep -E "Local APIC timer frequency is [0-9]+ kHz, TSC is (not )?invariant." $LOG || fail
+
+# The test application does not know the TSC frequency, so it can only check
+# the sleep durations relative to each other.
+echo "* Check the long sleep lasted at least as long as requested"
+KHZ=`grep -oE "TSC frequency is [0-9]+ kHz" $LOG | grep -oE "[0-9]+"`
+CYCLES=`grep -oE "Slept for 200 ms in [0-9]+ TSC cycles" $LOG | grep -oE "[0-9]+ TSC" | grep -oE "[0-9]+"`
+MS=$(( CYCLES / KHZ ))
+echo "Slept for $MS ms"
+[ $MS -ge 200 ] || fail
+[ $MS -le 400 ] || fail
+
+check_reboot
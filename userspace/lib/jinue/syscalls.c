@@ -165,12 +165,23 @@ intptr_t jinue_send(
         int                     *perrno,
         uintptr_t               *perrcode) {
 
+    return jinue_send_timeout(fd, function, message, 0, perrno, perrcode);
+}
+
+intptr_t jinue_send_timeout(
+        int                      fd,
+        intptr_t                 function,
+        const jinue_message_t   *message,
+        uint32_t                 timeout_ms,
+        int                     *perrno,
+        uintptr_t               *perrcode) {
+
     jinue_syscall_args_t args;
 
     args.arg0 = (uintptr_t)function;
     args.arg1 = (uintptr_t)fd;
     args.arg2 = (uintptr_t)message;
-    args.arg3 = 0;
+    args.arg3 = timeout_ms;
 
     const intptr_t retval = (intptr_t)jinue_syscall(&args);
 
@@ -187,13 +198,61 @@ intptr_t jinue_send(
     return retval;
 }
 
+intptr_t jinue_send_async(
+        int                      fd,
+        intptr_t                 function,
+        const jinue_message_t   *message,
+        int                      cq_fd,
+        int                     *perrno) {
+
+    jinue_syscall_args_t args;
+
+    args.arg0 = (uintptr_t)function;
+    args.arg1 = (uintptr_t)fd | JINUE_IPC_ASYNC;
+    args.arg2 = (uintptr_t)message;
+    args.arg3 = (uintptr_t)cq_fd;
+
+    return call_with_usual_convention(&args, perrno);
+}
+
+int jinue_send_batch(jinue_send_entry_t *entries, size_t length, int *perrno) {
+    jinue_syscall_args_t args;
+
+    args.arg0 = JINUE_SYS_SEND_BATCH;
+    args.arg1 = (uintptr_t)entries;
+    args.arg2 = length;
+    args.arg3 = 0;
+
+    return call_with_usual_convention(&args, perrno);
+}
+
 intptr_t jinue_receive(int fd, const jinue_message_t *message, int *perrno){
+    return jinue_receive_timeout(fd, message, 0, perrno);
+}
+
+intptr_t jinue_receive_timeout(
+        int                      fd,
+        const jinue_message_t   *message,
+        uint32_t                 timeout_ms,
+        int                     *perrno) {
+
     jinue_syscall_args_t args;
 
     args.arg0 = JINUE_SYS_RECEIVE;
     args.arg1 = (uintptr_t)fd;
     args.arg2 = (uintptr_t)message;
-    args.arg3 = 0;
+    args.arg3 = timeout_ms;
+
+    return call_with_usual_convention(&args, perrno);
+}
+
+int jinue_receive_batch(int fd, jinue_recv_entry_t *entries, size_t length, int *perrno) {
+    jinue_syscall_args_t args;
+
+    args.arg0 = JINUE_SYS_RECEIVE_BATCH;
+    args.arg1 = (uintptr_t)fd;
+    args.arg2 = (uintptr_t)entries;
+    args.arg3 = length;
 
     return call_with_usual_convention(&args, perrno);
 }
@@ -209,17 +268,264 @@ intptr_t jinue_reply(const jinue_message_t *message, int *perrno) {
     return call_with_usual_convention(&args, perrno);
 }
 
+intptr_t jinue_reply_descs(const jinue_message_t *message, int *perrno) {
+    jinue_syscall_args_t args;
+
+    args.arg0 = JINUE_SYS_REPLY;
+    args.arg1 = JINUE_IPC_DESCS;
+    args.arg2 = (uintptr_t)message;
+    args.arg3 = 0;
+
+    return call_with_usual_convention(&args, perrno);
+}
+
+intptr_t jinue_reply_receive(int fd, jinue_message_t *message, int *perrno) {
+    return jinue_reply_receive_timeout(fd, message, 0, perrno);
+}
+
+intptr_t jinue_reply_receive_timeout(
+        int                  fd,
+        jinue_message_t     *message,
+        uint32_t             timeout_ms,
+        int                 *perrno) {
+
+    jinue_syscall_args_t args;
+
+    args.arg0 = JINUE_SYS_REPLY_RECEIVE;
+    args.arg1 = (uintptr_t)fd;
+    args.arg2 = (uintptr_t)message;
+    args.arg3 = timeout_ms;
+
+    return call_with_usual_convention(&args, perrno);
+}
+
+intptr_t jinue_send_short(
+        int                      fd,
+        intptr_t                 function,
+        jinue_short_message_t   *message,
+        int                     *perrno,
+        uintptr_t               *perrcode) {
+
+    jinue_syscall_args_t args;
+
+    args.arg0 = (uintptr_t)function;
+    args.arg1 = (uintptr_t)fd | JINUE_IPC_SHORT;
+    args.arg2 = message->data[0];
+    args.arg3 = message->data[1];
+
+    const intptr_t retval = (intptr_t)jinue_syscall(&args);
+
+    if(retval < 0) {
+        set_errno(perrno, args.arg1);
+
+        if(args.arg1 == JINUE_EPROTO && perrcode != NULL) {
+            *perrcode = args.arg2;
+        }
+
+        return retval;
+    }
+
+    message->data[0] = args.arg2;
+    message->data[1] = args.arg3;
+
+    return retval;
+}
+
+int jinue_receive_short(int fd, jinue_short_message_t *message, int *perrno) {
+    jinue_syscall_args_t args;
+
+    args.arg0 = JINUE_SYS_RECEIVE;
+    args.arg1 = (uintptr_t)fd | JINUE_IPC_SHORT;
+    args.arg2 = 0;
+    args.arg3 = 0;
+
+    const intptr_t retval = (intptr_t)jinue_syscall(&args);
+
+    if(retval < 0) {
+        set_errno(perrno, args.arg1);
+        return -1;
+    }
+
+    message->function   = args.arg0;
+    message->cookie     = args.arg1;
+    message->data[0]    = args.arg2;
+    message->data[1]    = args.arg3;
+
+    return 0;
+}
+
+int jinue_reply_short(const jinue_short_message_t *message, int *perrno) {
+    jinue_syscall_args_t args;
+
+    args.arg0 = JINUE_SYS_REPLY;
+    args.arg1 = JINUE_IPC_SHORT;
+    args.arg2 = message->data[0];
+    args.arg3 = message->data[1];
+
+    return call_with_usual_convention(&args, perrno);
+}
+
 int jinue_create_endpoint(int fd, int *perrno) {
+    return jinue_create_endpoint_flags(fd, 0, perrno);
+}
+
+int jinue_create_endpoint_flags(int fd, int flags, int *perrno) {
     jinue_syscall_args_t args;
 
     args.arg0 = JINUE_SYS_CREATE_ENDPOINT;
     args.arg1 = fd;
+    args.arg2 = flags;
+    args.arg3 = 0;
+
+    return call_with_usual_convention(&args, perrno);
+}
+
+int jinue_create_endpoint_set(int fd, int *perrno) {
+    jinue_syscall_args_t args;
+
+    args.arg0 = JINUE_SYS_CREATE_ENDPOINT_SET;
+    args.arg1 = fd;
     args.arg2 = 0;
     args.arg3 = 0;
 
     return call_with_usual_convention(&args, perrno);
 }
 
+int jinue_add_to_endpoint_set(int set_fd, int endpoint_fd, int *perrno) {
+    jinue_syscall_args_t args;
+
+    args.arg0 = JINUE_SYS_ADD_TO_ENDPOINT_SET;
+    args.arg1 = set_fd;
+    args.arg2 = endpoint_fd;
+    args.arg3 = 0;
+
+    return call_with_usual_convention(&args, perrno);
+}
+
+int jinue_create_notification(int fd, int *perrno) {
+    jinue_syscall_args_t args;
+
+    args.arg0 = JINUE_SYS_CREATE_NOTIFICATION;
+    args.arg1 = fd;
+    args.arg2 = 0;
+    args.arg3 = 0;
+
+    return call_with_usual_convention(&args, perrno);
+}
+
+int jinue_notify(int fd, uintptr_t bits, int *perrno) {
+    jinue_syscall_args_t args;
+
+    args.arg0 = JINUE_SYS_NOTIFY;
+    args.arg1 = fd;
+    args.arg2 = bits;
+    args.arg3 = 0;
+
+    return call_with_usual_convention(&args, perrno);
+}
+
+int jinue_wait_notification(int fd, uintptr_t *bits, int *perrno) {
+    jinue_syscall_args_t args;
+
+    args.arg0 = JINUE_SYS_WAIT_NOTIFICATION;
+    args.arg1 = fd;
+    args.arg2 = 0;
+    args.arg3 = 0;
+
+    const intptr_t retval = (intptr_t)jinue_syscall(&args);
+
+    if(retval < 0) {
+        set_errno(perrno, args.arg1);
+        return -1;
+    }
+
+    *bits = args.arg1;
+
+    return 0;
+}
+
+int jinue_bind_notification(int fd, int target_fd, int *perrno) {
+    jinue_syscall_args_t args;
+
+    args.arg0 = JINUE_SYS_BIND_NOTIFICATION;
+    args.arg1 = fd;
+    args.arg2 = target_fd;
+    args.arg3 = 0;
+
+    return call_with_usual_convention(&args, perrno);
+}
+
+int jinue_create_channel(int fd, size_t entry_size, size_t entries, int *perrno) {
+    jinue_syscall_args_t args;
+
+    args.arg0 = JINUE_SYS_CREATE_CHANNEL;
+    args.arg1 = fd;
+    args.arg2 = entry_size;
+    args.arg3 = entries;
+
+    return call_with_usual_convention(&args, perrno);
+}
+
+int jinue_map_channel(int process, int fd, void *addr, int *perrno) {
+    jinue_syscall_args_t args;
+
+    args.arg0 = JINUE_SYS_MAP_CHANNEL;
+    args.arg1 = process;
+    args.arg2 = fd;
+    args.arg3 = (uintptr_t)addr;
+
+    return call_with_usual_convention(&args, perrno);
+}
+
+int jinue_wait_channel(int fd, int side, int *perrno) {
+    jinue_syscall_args_t args;
+
+    args.arg0 = JINUE_SYS_WAIT_CHANNEL;
+    args.arg1 = fd;
+    args.arg2 = side;
+    args.arg3 = 0;
+
+    return call_with_usual_convention(&args, perrno);
+}
+
+int jinue_signal_channel(int fd, int side, int *perrno) {
+    jinue_syscall_args_t args;
+
+    args.arg0 = JINUE_SYS_SIGNAL_CHANNEL;
+    args.arg1 = fd;
+    args.arg2 = side;
+    args.arg3 = 0;
+
+    return call_with_usual_convention(&args, perrno);
+}
+
+int jinue_create_completion_queue(int fd, int *perrno) {
+    jinue_syscall_args_t args;
+
+    args.arg0 = JINUE_SYS_CREATE_COMPLETION_QUEUE;
+    args.arg1 = fd;
+    args.arg2 = 0;
+    args.arg3 = 0;
+
+    return call_with_usual_convention(&args, perrno);
+}
+
+int jinue_wait_completions(
+        int                  fd,
+        jinue_completion_t  *completions,
+        size_t               length,
+        int                 *perrno) {
+
+    jinue_syscall_args_t args;
+
+    args.arg0 = JINUE_SYS_WAIT_COMPLETIONS;
+    args.arg1 = (uintptr_t)fd;
+    args.arg2 = (uintptr_t)completions;
+    args.arg3 = length;
+
+    return call_with_usual_convention(&args, perrno);
+}
+
 int jinue_create_process(int fd, int *perrno) {
     jinue_syscall_args_t args;
 
@@ -392,3 +698,47 @@ int jinue_set_signal_handler(jinue_sighandler_t handler, int *perrno) {
 
     return call_with_usual_convention(&args, perrno);
 }
+
+int jinue_set_thread_priority(int fd, int priority, int *perrno) {
+    jinue_syscall_args_t args;
+
+    args.arg0 = JINUE_SYS_SET_THREAD_PRIORITY;
+    args.arg1 = fd;
+    args.arg2 = priority;
+    args.arg3 = 0;
+
+    return call_with_usual_convention(&args, perrno);
+}
+
+int jinue_get_set_thread_affinity(int fd, uint32_t affinity, int *perrno) {
+    jinue_syscall_args_t args;
+
+    args.arg0 = JINUE_SYS_GET_SET_THREAD_AFFINITY;
+    args.arg1 = fd;
+    args.arg2 = affinity;
+    args.arg3 = 0;
+
+    return call_with_usual_convention(&args, perrno);
+}
+
+int jinue_get_cpu(void) {
+    jinue_syscall_args_t args;
+
+    args.arg0 = JINUE_SYS_GET_CPU;
+    args.arg1 = 0;
+    args.arg2 = 0;
+    args.arg3 = 0;
+
+    return (int)jinue_syscall(&args);
+}
+
+int jinue_get_kmalloc_stats(const jinue_buffer_t *buffer, int *perrno) {
+    jinue_syscall_args_t args;
+
+    args.arg0 = JINUE_SYS_GET_KMALLOC_STATS;
+    args.arg1 = (uintptr_t)buffer->addr;
+    args.arg2 = buffer->size;
+    args.arg3 = 0;
+
+    return call_with_usual_convention(&args, perrno);
+}
@@ -249,3 +249,19 @@ void *__mmap_anonymous_perrno(void *addr, size_t len, int *perrno) {
         perrno
     );
 }
+
+/* Reserve a range of address space to be mapped by other means, e.g. with
+ * jinue_map_channel(). */
+void *__mmap_reserve(size_t len) {
+    size_t aligned_length = (len + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+
+    if(JINUE_KLIMIT - (uintptr_t)alloc_addr < aligned_length) {
+        errno = ENOMEM;
+        return NULL;
+    }
+
+    void *addr = alloc_addr;
+    alloc_addr = (void *)((uintptr_t)alloc_addr + aligned_length);
+
+    return addr;
+}
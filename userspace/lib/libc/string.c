@@ -147,6 +147,8 @@ static const char *strerror_const(int errnum) {
         return "resource deadlock would occur";
     case EPROTO:
         return "protocol error";
+    case ETIMEDOUT:
+        return "connection timed out";
     default:
         return "unknown error";
     }
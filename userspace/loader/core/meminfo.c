@@ -36,7 +36,6 @@
 #include <stdlib.h>
 #include <string.h>
 #include "meminfo.h"
-#include "server.h"
 
 #define MAX_SEGMENTS    8
 
@@ -120,25 +119,17 @@ static void update_buffers(void) {
     buffers[BUFFER_INDEX_VMAPS].size    = MAPPINGS_SIZE;
 }
 
-int get_meminfo(const jinue_message_t *message) {
+int get_meminfo(jinue_message_t *message) {
     if(message->reply_max_size < MESSAGE_SIZE) {
-        return reply_error(JINUE_E2BIG);
+        return JINUE_E2BIG;
     }
 
     update_meminfo();
 
     update_buffers();
 
-    jinue_message_t reply;
-    reply.send_buffers          = buffers;
-    reply.send_buffers_length   = sizeof(buffers)/sizeof(buffers[0]);
+    message->send_buffers           = buffers;
+    message->send_buffers_length    = sizeof(buffers)/sizeof(buffers[0]);
 
-    int status = jinue_reply(&reply, &errno);
-
-    if(status < 0) {
-        jinue_error("jinue_reply() failed: %s", strerror(errno));
-        return EXIT_FAILURE;
-    }
-
-    return EXIT_SUCCESS;
+    return 0;
 }
@@ -48,6 +48,6 @@ uint64_t get_meminfo_ramdisk_start(void);
 
 void add_meminfo_mapping(void *addr, size_t size, int segment_index, size_t offset, int perms);
 
-int get_meminfo(const jinue_message_t *message);
+int get_meminfo(jinue_message_t *message);
 
 #endif
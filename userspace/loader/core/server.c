@@ -39,7 +39,7 @@
 #include "meminfo.h"
 #include "server.h"
 
-int reply_error(int error_number) {
+static int reply_error(int error_number) {
     int status = jinue_reply_error(error_number, &errno);
 
     if(status < 0) {
@@ -50,48 +50,76 @@ int reply_error(int error_number) {
     return EXIT_SUCCESS;
 }
 
-static int receive_message(jinue_message_t *message) {
+static int receive_message(jinue_message_t *message, bool has_reply) {
     message->recv_buffers           = NULL;
     message->recv_buffers_length    = 0;
 
-    int status = jinue_receive(JINUE_DESC_LOADER_ENDPOINT, message, &errno);
+    int status;
 
-    if(status < 0) {
-        jinue_error("jinue_receive() failed: %s", strerror(errno));
-        return EXIT_FAILURE;
+    if(has_reply) {
+        /* Send the reply to the previous message and receive the next one in
+         * a single system call. */
+        status = jinue_reply_receive(JINUE_DESC_LOADER_ENDPOINT, message, &errno);
+
+        if(status < 0) {
+            jinue_error("jinue_reply_receive() failed: %s", strerror(errno));
+            return EXIT_FAILURE;
+        }
+    }
+    else {
+        status = jinue_receive(JINUE_DESC_LOADER_ENDPOINT, message, &errno);
+
+        if(status < 0) {
+            jinue_error("jinue_receive() failed: %s", strerror(errno));
+            return EXIT_FAILURE;
+        }
     }
 
     return EXIT_SUCCESS;
 }
 
 int run_server(void) {
-    while(true) {
-        jinue_message_t message;
+    jinue_message_t message;
+    bool has_reply = false;
 
-        int status = receive_message(&message);
+    while(true) {
+        int status = receive_message(&message, has_reply);
 
         if(status != EXIT_SUCCESS) {
             return status;
         }
 
+        /* Handlers set the reply in the send buffers of the message structure
+         * and return zero on success, or return an error number. */
+        message.send_buffers        = NULL;
+        message.send_buffers_length = 0;
+
+        int error_number;
+
         switch(message.recv_function) {
             case JINUE_MSG_GET_MEMINFO:
-                status = get_meminfo(&message);
-
-                if(status != EXIT_SUCCESS) {
-                    return status;
-                }
+                error_number = get_meminfo(&message);
                 break;
             case JINUE_MSG_EXIT:
                 /* Exit without sending back a response. This will cause the call to fail with
                  * JINUE_EIO on the sender's side, but only once this process has exited. */
                 return EXIT_SUCCESS;
             default:
-                status = reply_error(JINUE_ENOSYS);
+                error_number = JINUE_ENOSYS;
+        }
+
+        if(error_number == 0) {
+            /* reply is sent with the next receive */
+            has_reply = true;
+            continue;
+        }
 
-                if(status != EXIT_SUCCESS) {
-                    return status;
-                }
+        has_reply = false;
+
+        status = reply_error(error_number);
+
+        if(status != EXIT_SUCCESS) {
+            return status;
         }
     }
 }
@@ -34,8 +34,6 @@
 
 #include <jinue/loader.h>
 
-int reply_error(int error_number);
-
 int run_server(void);
 
 #endif
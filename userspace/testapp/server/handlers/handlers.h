@@ -35,6 +35,6 @@
 #include <stddef.h>
 #include "../types.h"
 
-void handle_map_anon(const message_context_t *ctx, void *msg, size_t len);
+int handle_map_anon(const message_context_t *ctx, void *msg, size_t len);
 
 #endif
@@ -34,12 +34,11 @@
 #include <errno.h>
 #include <internals.h>
 #include <stdint.h>
-#include "../utils.h"
 #include "handlers.h"
 
-void handle_map_anon(const message_context_t *ctx, void *msg, size_t len) {
+int handle_map_anon(const message_context_t *ctx, void *msg, size_t len) {
     if(len != sizeof(sys_msg_map_anon_params_t)) {
-        reply_error(EINVAL);
+        return EINVAL;
     }
 
     const sys_msg_map_anon_params_t *params = (const sys_msg_map_anon_params_t *)msg;
@@ -47,8 +46,7 @@ void handle_map_anon(const message_context_t *ctx, void *msg, size_t len) {
     uint64_t paddr = libc_physmem_alloc(params->length);
 
     if(paddr < 0) {
-        reply_error(ENOMEM);
-        return;
+        return ENOMEM;
     }
 
     int status = jinue_mmap(
@@ -62,9 +60,8 @@ void handle_map_anon(const message_context_t *ctx, void *msg, size_t len) {
     );
 
     if(status < 0) {
-        reply_error(errno);
-        return;
+        return errno;
     }
 
-    reply_success();
+    return 0;
 }
@@ -35,6 +35,7 @@
 #include <srv/system.h>
 #include <errno.h>
 #include <internals.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
@@ -49,33 +50,60 @@
 #define RECV_BUFFER_SIZE 512
 
 static int run_server(int fd, const message_context_t *message_context) {
-    while(true) {
-        unsigned char buffer[RECV_BUFFER_SIZE];
+    unsigned char buffer[RECV_BUFFER_SIZE];
+
+    jinue_buffer_t recv_buffer;
+    recv_buffer.addr = &buffer;
+    recv_buffer.size = sizeof(buffer);
+
+    /* None of the handlers send data back with the reply. */
+    jinue_message_t message;
+    message.send_buffers        = NULL;
+    message.send_buffers_length = 0;
+    message.recv_buffers        = &recv_buffer;
+    message.recv_buffers_length = 1;
 
-        jinue_buffer_t recv_buffer;
-        recv_buffer.addr = &buffer;
-        recv_buffer.size = sizeof(buffer);
+    bool has_reply = false;
+
+    while(true) {
+        intptr_t len;
 
-        jinue_message_t message;
-        message.recv_buffers        = &recv_buffer;
-        message.recv_buffers_length = 1;
+        if(has_reply) {
+            /* Send the reply to the previous message and receive the next one
+             * in a single system call. */
+            len = jinue_reply_receive(fd, &message, &errno);
 
-        intptr_t len = jinue_receive(fd, &message, &errno);
+            if(len < 0) {
+                jinue_error("jinue_reply_receive() failed: %s", strerror(errno));
+                return EXIT_FAILURE;
+            }
+        }
+        else {
+            len = jinue_receive(fd, &message, &errno);
 
-        if(len < 0) {
-            jinue_error("jinue_receive() failed: %s", strerror(errno));
-            return EXIT_FAILURE;
+            if(len < 0) {
+                jinue_error("jinue_receive() failed: %s", strerror(errno));
+                return EXIT_FAILURE;
+            }
         }
 
+        int error_number;
+
         switch(message.recv_function) {
             case SYS_MSG_EXIT:
                 /* At this point, the remote process is done. No need to send a reply. */
                 return EXIT_SUCCESS;
             case SYS_MSG_MAP_ANON:
-                handle_map_anon(message_context, buffer, len);
+                error_number = handle_map_anon(message_context, buffer, len);
                 break;
             default:
-                reply_error(ENOSYS);
+                error_number = ENOSYS;
+        }
+
+        has_reply = (error_number == 0);
+
+        if(! has_reply) {
+            reply_error(error_number);
         }
     }
 }
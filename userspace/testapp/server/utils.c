@@ -35,18 +35,6 @@
 #include <string.h>
 #include "utils.h"
 
-void reply_success(void) {
-    jinue_message_t message;
-    message.send_buffers        = NULL;
-    message.send_buffers_length = 0;
-
-    int status = jinue_reply(&message, &errno);
-
-    if(status < 0) {
-        jinue_error("jinue_reply() failed: %s", strerror(errno));
-    }
-}
-
 void reply_error(int error_number) {
     int status = jinue_reply_error(error_number, &errno);
 
@@ -32,8 +32,6 @@
 #ifndef TESTAPP_SERVER_UTILS_H_
 #define TESTAPP_SERVER_UTILS_H_
 
-void reply_success(void);
-
 void reply_error(int error_number);
 
 #endif
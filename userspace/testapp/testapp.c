@@ -65,10 +65,15 @@ int main(int argc, char *argv[]) {
     run_aes_test();
     run_cancel_thread_test();
     run_cancel_thread_async_test();
+    run_channel_benchmark();
     run_exit_thread_test();
     run_ipc_test();
+    run_ipc_benchmark();
+    run_sched_benchmark();
     run_scroll_test();
     run_signal_test();
+    run_slab_benchmark();
+    run_smp_test();
     run_sse_test();
 
     return do_exit();
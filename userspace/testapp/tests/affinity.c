@@ -0,0 +1,205 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <jinue/jinue.h>
+#include <jinue/utils.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../utils.h"
+#include "tests.h"
+
+#define NUM_WORKERS         4
+
+#define NUM_ROUNDS          50
+
+#define ROUND_ITERATIONS    10000
+
+typedef struct {
+    int                     cpu;
+    volatile unsigned int   sum;
+    volatile bool           is_pinned;
+} worker_t;
+
+static worker_t workers[NUM_WORKERS];
+
+static int count_cpus(const cpu_set_t *set) {
+    int count = 0;
+
+    for(int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if(CPU_ISSET(cpu, set)) {
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+static void *worker_thread(void *arg) {
+    worker_t *worker = arg;
+
+    /* The worker starts before the main thread gets to pin it, and it moves to
+     * its CPU the next time it enters the scheduler. */
+    while(! worker->is_pinned) {
+        jinue_yield_thread();
+    }
+
+    jinue_yield_thread();
+
+    for(int round = 0; round < NUM_ROUNDS; ++round) {
+        for(int idx = 0; idx < ROUND_ITERATIONS; ++idx) {
+            worker->sum += idx;
+        }
+
+        /* The worker must only run on the CPU it is pinned to. */
+        if(jinue_get_cpu() != worker->cpu) {
+            jinue_error("error: pinned worker ran on another CPU");
+            return (void *)false;
+        }
+
+        jinue_yield_thread();
+
+        /* The set of allowed CPUs must not change behind our back. */
+        cpu_set_t set;
+        int status = pthread_getaffinity_np(pthread_self(), sizeof(set), &set);
+
+        if(status != 0 || count_cpus(&set) != 1 || !CPU_ISSET(worker->cpu, &set)) {
+            jinue_error("error: affinity of pinned worker changed");
+            return (void *)false;
+        }
+    }
+
+    return (void *)true;
+}
+
+static bool pin_thread(pthread_t thread, int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+
+    int status = pthread_setaffinity_np(thread, sizeof(set), &set);
+
+    if(status != 0) {
+        jinue_error("error: pthread_setaffinity_np() failed: %s", strerror(status));
+        return false;
+    }
+
+    return true;
+}
+
+bool test_affinity(void) {
+    cpu_set_t all_cpus;
+    int status = pthread_getaffinity_np(pthread_self(), sizeof(all_cpus), &all_cpus);
+
+    if(status != 0) {
+        jinue_error("error: pthread_getaffinity_np() failed: %s", strerror(status));
+        return false;
+    }
+
+    int num_cpus = count_cpus(&all_cpus);
+
+    /* Invalid CPU sets are rejected. */
+    cpu_set_t set;
+    CPU_ZERO(&set);
+
+    status = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+
+    CHECK_TRUE(status == EINVAL);
+
+    CPU_SET(num_cpus, &set);
+
+    status = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+
+    CHECK_TRUE(status == EINVAL);
+
+    /* Move the main thread around: it has to continue on each CPU, on which it
+     * is running by the time the call returns. */
+    for(int cpu = 0; cpu < num_cpus; ++cpu) {
+        CHECK_TRUE(pin_thread(pthread_self(), cpu));
+        CHECK_TRUE(jinue_get_cpu() == cpu);
+
+        jinue_yield_thread();
+
+        CHECK_TRUE(jinue_get_cpu() == cpu);
+    }
+
+    CHECK_TRUE(pin_thread(pthread_self(), 0));
+
+    pthread_t threads[NUM_WORKERS];
+
+    for(int idx = 0; idx < NUM_WORKERS; ++idx) {
+        workers[idx].cpu        = idx % num_cpus;
+        workers[idx].sum        = 0;
+        workers[idx].is_pinned  = false;
+
+        if(start_thread(&threads[idx], worker_thread, &workers[idx]) != EXIT_SUCCESS) {
+            return false;
+        }
+
+        if(! pin_thread(threads[idx], workers[idx].cpu)) {
+            return false;
+        }
+
+        workers[idx].is_pinned = true;
+    }
+
+    for(int idx = 0; idx < NUM_WORKERS; ++idx) {
+        void *thread_passed;
+
+        status = pthread_join(threads[idx], &thread_passed);
+
+        if(status != 0) {
+            jinue_error("error: failed to join thread: %s", strerror(status));
+            return false;
+        }
+
+        CHECK_TRUE(thread_passed != NULL);
+    }
+
+    const unsigned int expected = NUM_ROUNDS * (ROUND_ITERATIONS * (ROUND_ITERATIONS - 1u) / 2u);
+
+    for(int idx = 0; idx < NUM_WORKERS; ++idx) {
+        CHECK_TRUE(workers[idx].sum == expected);
+    }
+
+    status = pthread_setaffinity_np(pthread_self(), sizeof(all_cpus), &all_cpus);
+
+    if(status != 0) {
+        jinue_error("error: pthread_setaffinity_np() failed: %s", strerror(status));
+        return false;
+    }
+
+    return true;
+}
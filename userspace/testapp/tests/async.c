@@ -0,0 +1,309 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jinue/jinue.h>
+#include <jinue/utils.h>
+#include <errno.h>
+#include <internals.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../utils.h"
+#include "tests.h"
+
+#define MSG_FUNC_ECHO       (JINUE_SYS_USER_BASE + 16)
+
+#define MSG_FUNC_FAIL       (JINUE_SYS_USER_BASE + 17)
+
+#define FAIL_ERRCODE        42
+
+#define NUM_REQUESTS        3
+
+#define REPLY_SIZE          32
+
+typedef struct {
+    const char  *data;
+    int          function;
+    intptr_t     id;
+    char         reply[REPLY_SIZE];
+    bool         is_completed;
+} request_t;
+
+static int endpoint;
+
+static int completion_queue;
+
+static request_t requests[NUM_REQUESTS] = {
+    {.data = "alpha",   .function = MSG_FUNC_ECHO},
+    {.data = "bravo",   .function = MSG_FUNC_FAIL},
+    {.data = "charlie", .function = MSG_FUNC_ECHO}
+};
+
+static void *server_thread(void *arg) {
+    for(int idx = 0; idx < NUM_REQUESTS; ++idx) {
+        char buffer[REPLY_SIZE];
+
+        jinue_buffer_t recv_buffer;
+        recv_buffer.addr = buffer;
+        recv_buffer.size = sizeof(buffer);
+
+        jinue_message_t message;
+        message.recv_buffers        = &recv_buffer;
+        message.recv_buffers_length = 1;
+
+        intptr_t size = jinue_receive(endpoint, &message, &errno);
+
+        if(size < 0) {
+            jinue_error("error: jinue_receive() failed: %s.", strerror(errno));
+            return (void *)false;
+        }
+
+        if(message.recv_function == MSG_FUNC_FAIL) {
+            if(jinue_reply_error(FAIL_ERRCODE, &errno) < 0) {
+                jinue_error("error: jinue_reply_error() failed: %s.", strerror(errno));
+                return (void *)false;
+            }
+
+            continue;
+        }
+
+        /* echo the message back */
+        jinue_const_buffer_t reply_buffer;
+        reply_buffer.addr = buffer;
+        reply_buffer.size = size;
+
+        message.send_buffers        = &reply_buffer;
+        message.send_buffers_length = 1;
+
+        if(jinue_reply(&message, &errno) < 0) {
+            jinue_error("error: jinue_reply() failed: %s.", strerror(errno));
+            return (void *)false;
+        }
+    }
+
+    return (void *)true;
+}
+
+static bool create_descriptors(void) {
+    endpoint            = libc_allocate_descriptor();
+    completion_queue    = libc_allocate_descriptor();
+
+    if(endpoint < 0 || completion_queue < 0) {
+        jinue_error("error: libc_allocate_descriptor() failed: %s", strerror(errno));
+        return false;
+    }
+
+    if(jinue_create_endpoint(endpoint, &errno) < 0) {
+        jinue_error("error: could not create IPC endpoint: %s", strerror(errno));
+        return false;
+    }
+
+    if(jinue_create_completion_queue(completion_queue, &errno) < 0) {
+        jinue_error("error: could not create completion queue: %s", strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
+static bool send_requests(void) {
+    for(int idx = 0; idx < NUM_REQUESTS; ++idx) {
+        request_t *request = &requests[idx];
+
+        jinue_const_buffer_t send_buffer;
+        send_buffer.addr = request->data;
+        send_buffer.size = strlen(request->data) + 1;
+
+        /* The reply is written here when the completion is collected, after
+         * this function returns. */
+        jinue_buffer_t recv_buffer;
+        recv_buffer.addr = request->reply;
+        recv_buffer.size = sizeof(request->reply);
+
+        jinue_message_t message;
+        message.send_buffers        = &send_buffer;
+        message.send_buffers_length = 1;
+        message.recv_buffers        = &recv_buffer;
+        message.recv_buffers_length = 1;
+
+        request->is_completed   = false;
+        request->id             = jinue_send_async(
+            endpoint,
+            request->function,
+            &message,
+            completion_queue,
+            &errno
+        );
+
+        if(request->id < 0) {
+            jinue_error("error: jinue_send_async() failed: %s.", strerror(errno));
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static request_t *find_request(uintptr_t id) {
+    for(int idx = 0; idx < NUM_REQUESTS; ++idx) {
+        if((uintptr_t)requests[idx].id == id && ! requests[idx].is_completed) {
+            return &requests[idx];
+        }
+    }
+
+    return NULL;
+}
+
+static bool check_completion(const jinue_completion_t *completion) {
+    request_t *request = find_request(completion->request_id);
+
+    if(request == NULL) {
+        jinue_error("error: unexpected completion for request %" PRIuPTR ".", completion->request_id);
+        return false;
+    }
+
+    request->is_completed = true;
+
+    if(request->function == MSG_FUNC_FAIL) {
+        if(completion->result >= 0 || completion->error != JINUE_EPROTO) {
+            jinue_error("error: reply error was not reported in the completion.");
+            return false;
+        }
+
+        if(completion->errcode != FAIL_ERRCODE) {
+            jinue_error("error: completion has the wrong error code (%" PRIuPTR ").", completion->errcode);
+            return false;
+        }
+
+        return true;
+    }
+
+    if(completion->result < 0) {
+        jinue_error("error: request failed: %s.", strerror(completion->error));
+        return false;
+    }
+
+    if(completion->result != (int)strlen(request->data) + 1 || strcmp(request->reply, request->data) != 0) {
+        jinue_error("error: wrong reply for request %" PRIuPTR ".", completion->request_id);
+        return false;
+    }
+
+    return true;
+}
+
+static bool collect_completions(void) {
+    int collected = 0;
+
+    while(collected < NUM_REQUESTS) {
+        jinue_completion_t completions[NUM_REQUESTS + 1];
+
+        int count = jinue_wait_completions(
+            completion_queue,
+            completions,
+            NUM_REQUESTS + 1,
+            &errno
+        );
+
+        if(count < 0) {
+            jinue_error("error: jinue_wait_completions() failed: %s.", strerror(errno));
+            return false;
+        }
+
+        for(int idx = 0; idx < count; ++idx) {
+            if(! check_completion(&completions[idx])) {
+                return false;
+            }
+        }
+
+        collected += count;
+    }
+
+    return true;
+}
+
+bool test_async_ipc(void) {
+    if(! create_descriptors()) {
+        return false;
+    }
+
+    jinue_completion_t completion;
+
+    if(jinue_wait_completions(completion_queue | JINUE_IPC_NONBLOCK, &completion, 1, &errno) >= 0 || errno != EAGAIN) {
+        jinue_error("error: waiting on an empty completion queue did not fail with EAGAIN");
+        return false;
+    }
+
+    jinue_message_t message;
+    message.send_buffers        = NULL;
+    message.send_buffers_length = 0;
+    message.recv_buffers        = NULL;
+    message.recv_buffers_length = 0;
+
+    if(jinue_send_async(endpoint | JINUE_IPC_BULK, MSG_FUNC_ECHO, &message, completion_queue, &errno) >= 0 || errno != EINVAL) {
+        jinue_error("error: asynchronous send in bulk mode did not fail with EINVAL");
+        return false;
+    }
+
+    pthread_t server;
+
+    if(start_thread(&server, server_thread, NULL) != EXIT_SUCCESS) {
+        return false;
+    }
+
+    if(! send_requests()) {
+        return false;
+    }
+
+    if(! collect_completions()) {
+        return false;
+    }
+
+    void *server_passed;
+    int status = pthread_join(server, &server_passed);
+
+    if(status != 0) {
+        jinue_error("error: failed to join thread: %s", strerror(status));
+        return false;
+    }
+
+    if(! server_passed) {
+        return false;
+    }
+
+    if(jinue_close(endpoint, &errno) < 0 || jinue_close(completion_queue, &errno) < 0) {
+        jinue_error("error: failed to close descriptor: %s", strerror(errno));
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <jinue/jinue.h>
+#include <jinue/utils.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../utils.h"
+#include "tests.h"
+
+#define NUM_WORKERS         8
+
+#define NUM_ROUNDS          200
+
+#define ROUND_ITERATIONS    10000
+
+typedef struct {
+    volatile unsigned int   sum;
+    cpu_set_t               used_cpus;
+} worker_t;
+
+static worker_t workers[NUM_WORKERS];
+
+static void *worker_thread(void *arg) {
+    /* Each worker is CPU-bound and only yields between rounds, so it is up to
+     * the scheduler to spread the workers over the CPUs. */
+    worker_t *worker = arg;
+
+    for(int round = 0; round < NUM_ROUNDS; ++round) {
+        for(int idx = 0; idx < ROUND_ITERATIONS; ++idx) {
+            worker->sum += idx;
+        }
+
+        CPU_SET(jinue_get_cpu(), &worker->used_cpus);
+
+        jinue_yield_thread();
+    }
+
+    return (void *)true;
+}
+
+bool test_load_balance(void) {
+    cpu_set_t all_cpus;
+    int status = pthread_getaffinity_np(pthread_self(), sizeof(all_cpus), &all_cpus);
+
+    if(status != 0) {
+        jinue_error("error: pthread_getaffinity_np() failed: %s", strerror(status));
+        return false;
+    }
+
+    pthread_t threads[NUM_WORKERS];
+
+    for(int idx = 0; idx < NUM_WORKERS; ++idx) {
+        workers[idx].sum = 0;
+        CPU_ZERO(&workers[idx].used_cpus);
+
+        if(start_thread(&threads[idx], worker_thread, &workers[idx]) != EXIT_SUCCESS) {
+            return false;
+        }
+    }
+
+    for(int idx = 0; idx < NUM_WORKERS; ++idx) {
+        void *thread_passed;
+
+        status = pthread_join(threads[idx], &thread_passed);
+
+        if(status != 0) {
+            jinue_error("error: failed to join thread: %s", strerror(status));
+            return false;
+        }
+
+        CHECK_TRUE(thread_passed != NULL);
+    }
+
+    const unsigned int expected = NUM_ROUNDS * (ROUND_ITERATIONS * (ROUND_ITERATIONS - 1u) / 2u);
+    cpu_set_t used_cpus;
+    CPU_ZERO(&used_cpus);
+
+    for(int idx = 0; idx < NUM_WORKERS; ++idx) {
+        CHECK_TRUE(workers[idx].sum == expected);
+
+        for(int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if(CPU_ISSET(cpu, &workers[idx].used_cpus)) {
+                CPU_SET(cpu, &used_cpus);
+            }
+        }
+    }
+
+    /* There are more workers than CPUs, so none of them should remain idle
+     * for the whole test. */
+    for(int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        CHECK_TRUE(CPU_ISSET(cpu, &used_cpus) == CPU_ISSET(cpu, &all_cpus));
+    }
+
+    return true;
+}
@@ -0,0 +1,299 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jinue/jinue.h>
+#include <jinue/utils.h>
+#include <errno.h>
+#include <internals.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../utils.h"
+#include "tests.h"
+
+#define MSG_FUNC_ASYNC      (JINUE_SYS_USER_BASE + 18)
+
+#define MSG_FUNC_SYNC       (JINUE_SYS_USER_BASE + 19)
+
+#define NUM_ASYNC           4
+
+/* asynchronous messages, one synchronous message and one invalid entry */
+#define NUM_ENTRIES         (NUM_ASYNC + 2)
+
+#define NUM_MESSAGES        (NUM_ASYNC + 1)
+
+#define BUFFER_SIZE         32
+
+static int endpoint;
+
+static int completion_queue;
+
+static const char *data[NUM_MESSAGES] = {"alpha", "bravo", "charlie", "delta", "echo"};
+
+static bool receive_sync_message(char *buffer) {
+    jinue_buffer_t recv_buffer;
+    recv_buffer.addr = buffer;
+    recv_buffer.size = BUFFER_SIZE;
+
+    jinue_message_t message;
+    message.recv_buffers        = &recv_buffer;
+    message.recv_buffers_length = 1;
+
+    intptr_t size = jinue_receive(endpoint, &message, &errno);
+
+    if(size < 0) {
+        jinue_error("error: jinue_receive() failed: %s.", strerror(errno));
+        return false;
+    }
+
+    if(message.recv_function != MSG_FUNC_SYNC) {
+        jinue_error("error: synchronous message expected.");
+        return false;
+    }
+
+    if(size != strlen(data[NUM_ASYNC]) + 1 || strcmp(buffer, data[NUM_ASYNC]) != 0) {
+        jinue_error("error: wrong data in synchronous message.");
+        return false;
+    }
+
+    message.send_buffers        = NULL;
+    message.send_buffers_length = 0;
+
+    if(jinue_reply(&message, &errno) < 0) {
+        jinue_error("error: jinue_reply() failed: %s.", strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
+static void *server_thread(void *arg) {
+    char buffers[NUM_MESSAGES][BUFFER_SIZE];
+    int received = 0;
+
+    /* Only the asynchronous requests are received in batches. */
+    while(received < NUM_ASYNC) {
+        jinue_recv_entry_t entries[NUM_ASYNC];
+
+        for(int idx = 0; idx < NUM_ASYNC - received; ++idx) {
+            entries[idx].buffer.addr = buffers[received + idx];
+            entries[idx].buffer.size = BUFFER_SIZE;
+        }
+
+        int count = jinue_receive_batch(endpoint, entries, NUM_ASYNC - received, &errno);
+
+        if(count < 0) {
+            jinue_error("error: jinue_receive_batch() failed: %s.", strerror(errno));
+            return (void *)false;
+        }
+
+        for(int idx = 0; idx < count; ++idx) {
+            const jinue_recv_entry_t *entry = &entries[idx];
+
+            if(entry->function != MSG_FUNC_ASYNC || entry->recv_endpoint != endpoint) {
+                jinue_error("error: unexpected message function or endpoint.");
+                return (void *)false;
+            }
+
+            if(entry->size != strlen(data[received + idx]) + 1 || strcmp(buffers[received + idx], data[received + idx]) != 0) {
+                jinue_error("error: wrong data in message %i.", received + idx);
+                return (void *)false;
+            }
+        }
+
+        received += count;
+    }
+
+    /* The synchronous message was left queued by the batch receive. */
+    if(! receive_sync_message(buffers[NUM_ASYNC])) {
+        return (void *)false;
+    }
+
+    return (void *)true;
+}
+
+static bool create_descriptors(void) {
+    endpoint            = libc_allocate_descriptor();
+    completion_queue    = libc_allocate_descriptor();
+
+    if(endpoint < 0 || completion_queue < 0) {
+        jinue_error("error: libc_allocate_descriptor() failed: %s", strerror(errno));
+        return false;
+    }
+
+    if(jinue_create_endpoint(endpoint, &errno) < 0) {
+        jinue_error("error: could not create IPC endpoint: %s", strerror(errno));
+        return false;
+    }
+
+    if(jinue_create_completion_queue(completion_queue, &errno) < 0) {
+        jinue_error("error: could not create completion queue: %s", strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
+static bool send_messages(void) {
+    jinue_const_buffer_t send_buffers[NUM_MESSAGES];
+    jinue_message_t messages[NUM_MESSAGES];
+    jinue_send_entry_t entries[NUM_ENTRIES];
+
+    for(int idx = 0; idx < NUM_MESSAGES; ++idx) {
+        send_buffers[idx].addr = data[idx];
+        send_buffers[idx].size = strlen(data[idx]) + 1;
+
+        messages[idx].send_buffers          = &send_buffers[idx];
+        messages[idx].send_buffers_length   = 1;
+        messages[idx].recv_buffers          = NULL;
+        messages[idx].recv_buffers_length   = 0;
+
+        entries[idx].message = &messages[idx];
+
+        if(idx < NUM_ASYNC) {
+            entries[idx].fd         = endpoint | JINUE_IPC_ASYNC;
+            entries[idx].function   = MSG_FUNC_ASYNC;
+            entries[idx].arg3       = completion_queue;
+        }
+        else {
+            entries[idx].fd         = endpoint;
+            entries[idx].function   = MSG_FUNC_SYNC;
+            entries[idx].arg3       = 0;
+        }
+    }
+
+    /* The last entry has an invalid descriptor and must fail on its own. */
+    entries[NUM_MESSAGES].fd        = -1;
+    entries[NUM_MESSAGES].function  = MSG_FUNC_SYNC;
+    entries[NUM_MESSAGES].message   = &messages[0];
+    entries[NUM_MESSAGES].arg3      = 0;
+
+    int count = jinue_send_batch(entries, NUM_ENTRIES, &errno);
+
+    if(count != NUM_ENTRIES) {
+        jinue_error("error: jinue_send_batch() failed: %s.", strerror(errno));
+        return false;
+    }
+
+    for(int idx = 0; idx < NUM_ASYNC; ++idx) {
+        if(entries[idx].result < 0) {
+            jinue_error("error: asynchronous entry %i failed: %s.", idx, strerror(entries[idx].error));
+            return false;
+        }
+    }
+
+    if(entries[NUM_ASYNC].result != 0) {
+        jinue_error("error: synchronous entry did not get an empty reply.");
+        return false;
+    }
+
+    if(entries[NUM_MESSAGES].result >= 0 || entries[NUM_MESSAGES].error != JINUE_EBADF) {
+        jinue_error("error: entry with invalid descriptor did not fail with EBADF.");
+        return false;
+    }
+
+    return true;
+}
+
+static bool collect_completions(void) {
+    int collected = 0;
+
+    while(collected < NUM_ASYNC) {
+        jinue_completion_t completions[NUM_ASYNC];
+
+        int count = jinue_wait_completions(completion_queue, completions, NUM_ASYNC, &errno);
+
+        if(count < 0) {
+            jinue_error("error: jinue_wait_completions() failed: %s.", strerror(errno));
+            return false;
+        }
+
+        for(int idx = 0; idx < count; ++idx) {
+            if(completions[idx].result != 0) {
+                jinue_error("error: asynchronous message was not acknowledged with an empty reply.");
+                return false;
+            }
+        }
+
+        collected += count;
+    }
+
+    return true;
+}
+
+bool test_batch_ipc(void) {
+    if(! create_descriptors()) {
+        return false;
+    }
+
+    jinue_recv_entry_t entry;
+    entry.buffer.addr = NULL;
+    entry.buffer.size = 0;
+
+    if(jinue_receive_batch(endpoint | JINUE_IPC_NONBLOCK, &entry, 1, &errno) >= 0 || errno != EAGAIN) {
+        jinue_error("error: batch receive on an empty endpoint did not fail with EAGAIN");
+        return false;
+    }
+
+    pthread_t server;
+
+    if(start_thread(&server, server_thread, NULL) != EXIT_SUCCESS) {
+        return false;
+    }
+
+    if(! send_messages()) {
+        return false;
+    }
+
+    if(! collect_completions()) {
+        return false;
+    }
+
+    void *server_passed;
+    int status = pthread_join(server, &server_passed);
+
+    if(status != 0) {
+        jinue_error("error: failed to join thread: %s", strerror(status));
+        return false;
+    }
+
+    if(! server_passed) {
+        return false;
+    }
+
+    if(jinue_close(endpoint, &errno) < 0 || jinue_close(completion_queue, &errno) < 0) {
+        jinue_error("error: failed to close descriptor: %s", strerror(errno));
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jinue/jinue.h>
+#include <jinue/utils.h>
+#include <errno.h>
+#include <internals.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../utils.h"
+#include "tests.h"
+
+#define BULK_SIZE       (1024 * 1024)
+
+#define MSG_FUNC_BULK   (JINUE_SYS_USER_BASE + 7)
+
+static int endpoint;
+
+static uint32_t pattern_at(size_t index) {
+    return (uint32_t)index * 2654435761u;
+}
+
+static void *client_thread(void *arg) {
+    uint32_t *data = mmap_anonymous(NULL, BULK_SIZE);
+
+    if(data == NULL) {
+        jinue_error("error: could not allocate bulk data: %s", strerror(errno));
+        return (void *)false;
+    }
+
+    for(size_t idx = 0; idx < BULK_SIZE / sizeof(uint32_t); ++idx) {
+        data[idx] = pattern_at(idx);
+    }
+
+    jinue_message_t message;
+    message.send_buffers        = NULL;
+    message.send_buffers_length = 0;
+    message.recv_buffers        = NULL;
+    message.recv_buffers_length = 0;
+    message.send_bulk.addr      = data;
+    message.send_bulk.size      = BULK_SIZE;
+    message.bulk_window.addr    = NULL;
+    message.bulk_window.size    = 0;
+
+    intptr_t ret = jinue_send(endpoint | JINUE_IPC_BULK, MSG_FUNC_BULK, &message, &errno, NULL);
+
+    if(ret < 0) {
+        jinue_error("error: jinue_send() failed: %s.", strerror(errno));
+        return (void *)false;
+    }
+
+    return (void *)true;
+}
+
+static bool check_bulk_data(const uint32_t *data) {
+    for(size_t idx = 0; idx < BULK_SIZE / sizeof(uint32_t); ++idx) {
+        if(data[idx] != pattern_at(idx)) {
+            jinue_error("error: unexpected bulk data at offset %zu.", idx * sizeof(uint32_t));
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool receive_bulk(void *window) {
+    jinue_message_t message;
+    message.send_buffers        = NULL;
+    message.send_buffers_length = 0;
+    message.recv_buffers        = NULL;
+    message.recv_buffers_length = 0;
+    message.send_bulk.addr      = NULL;
+    message.send_bulk.size      = 0;
+    message.bulk_window.addr    = window;
+    message.bulk_window.size    = BULK_SIZE;
+
+    intptr_t ret = jinue_receive(endpoint | JINUE_IPC_BULK, &message, &errno);
+
+    if(ret < 0) {
+        jinue_error("error: jinue_receive() failed: %s.", strerror(errno));
+        return false;
+    }
+
+    if(message.recv_function != MSG_FUNC_BULK || message.recv_bulk_size != BULK_SIZE) {
+        jinue_error("error: unexpected function or bulk size.");
+        return false;
+    }
+
+    if(! check_bulk_data(window)) {
+        return false;
+    }
+
+    if(jinue_reply(&message, &errno) < 0) {
+        jinue_error("error: jinue_reply() failed: %s.", strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
+bool test_bulk_ipc(void) {
+    endpoint = libc_allocate_descriptor();
+
+    if(endpoint < 0) {
+        jinue_error("error: libc_allocate_descriptor() failed: %s", strerror(errno));
+        return false;
+    }
+
+    if(jinue_create_endpoint(endpoint, &errno) < 0) {
+        jinue_error("error: could not create IPC endpoint: %s", strerror(errno));
+        return false;
+    }
+
+    /* The lent pages are mapped in this window for the duration of the call,
+     * so it must not be backed by memory of its own. */
+    void *window = mmap_reserve(BULK_SIZE);
+
+    if(window == NULL) {
+        jinue_error("error: could not reserve bulk window: %s", strerror(errno));
+        return false;
+    }
+
+    pthread_t thread;
+
+    if(start_thread(&thread, client_thread, NULL) != EXIT_SUCCESS) {
+        return false;
+    }
+
+    if(! receive_bulk(window)) {
+        return false;
+    }
+
+    void *client_passed;
+    int status = pthread_join(thread, &client_passed);
+
+    if(status != 0) {
+        jinue_error("error: failed to join client thread: %s", strerror(status));
+        return false;
+    }
+
+    if(! client_passed) {
+        return false;
+    }
+
+    if(jinue_close(endpoint, &errno) < 0) {
+        jinue_error("error: failed to close endpoint descriptor: %s", strerror(errno));
+        return false;
+    }
+
+    return true;
+}
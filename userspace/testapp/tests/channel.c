@@ -0,0 +1,296 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jinue/channel.h>
+#include <jinue/jinue.h>
+#include <jinue/utils.h>
+#include <errno.h>
+#include <internals.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../utils.h"
+#include "tests.h"
+#include "tsc.h"
+
+#define BENCHMARK_ENTRIES       100000
+
+#define RING_ENTRIES            256
+
+#define TEST_ENTRIES            1000
+
+/* Small enough for the producer to fill the ring and wait for the consumer */
+#define TEST_RING_ENTRIES       4
+
+/* A channel of almost JINUE_CHANNEL_MAX_SIZE bytes is created, mapped and
+ * destroyed this many times, which adds up to more than the memory of the test
+ * machine if the shared memory is not freed. */
+#define REMAP_ITERATIONS        1024
+
+#define REMAP_ENTRY_SIZE        4000
+
+#define REMAP_ENTRIES           32
+
+typedef struct {
+    uint32_t    seq;
+    char        payload[60];
+} benchmark_entry_t;
+
+static jinue_channel_t consumer_channel;
+
+static void *consumer_thread(void *arg) {
+    benchmark_entry_t entry;
+
+    for(uint32_t idx = 0; idx < BENCHMARK_ENTRIES; ++idx) {
+        if(jinue_channel_dequeue(&consumer_channel, &entry, &errno) < 0) {
+            jinue_error("error: jinue_channel_dequeue() failed: %s.", strerror(errno));
+            return NULL;
+        }
+
+        if(entry.seq != idx) {
+            jinue_error("error: expected entry %" PRIu32 ", got %" PRIu32 ".", idx, entry.seq);
+            return NULL;
+        }
+    }
+
+    return NULL;
+}
+
+static void *map_channel(int fd, size_t size) {
+    void *addr = mmap_reserve(size);
+
+    if(addr == NULL) {
+        jinue_error("error: could not reserve address space: %s", strerror(errno));
+        return NULL;
+    }
+
+    if(jinue_map_channel(JINUE_DESC_SELF_PROCESS, fd, addr, &errno) < 0) {
+        jinue_error("error: could not map channel: %s", strerror(errno));
+        return NULL;
+    }
+
+    return addr;
+}
+
+static void *test_consumer_thread(void *arg) {
+    for(uint32_t idx = 0; idx < TEST_ENTRIES; ++idx) {
+        uint32_t value;
+
+        if(jinue_channel_dequeue(&consumer_channel, &value, &errno) < 0) {
+            jinue_error("error: jinue_channel_dequeue() failed: %s.", strerror(errno));
+            return (void *)false;
+        }
+
+        if(value != idx) {
+            jinue_error("error: expected entry %" PRIu32 ", got %" PRIu32 ".", idx, value);
+            return (void *)false;
+        }
+    }
+
+    return (void *)true;
+}
+
+bool test_channel(void) {
+    int fd = libc_allocate_descriptor();
+
+    if(fd < 0) {
+        jinue_error("error: libc_allocate_descriptor() failed: %s", strerror(errno));
+        return false;
+    }
+
+    CHECK_TRUE(jinue_create_channel(fd, sizeof(uint32_t), 3, &errno) < 0);
+    CHECK_TRUE(errno == JINUE_EINVAL);
+
+    CHECK_TRUE(jinue_create_channel(fd, 1, 2 * JINUE_CHANNEL_MAX_SIZE, &errno) < 0);
+    CHECK_TRUE(errno == JINUE_EINVAL);
+
+    CHECK_ZERO(jinue_create_channel(fd, sizeof(uint32_t), TEST_RING_ENTRIES, &errno));
+
+    size_t size         = jinue_channel_size(sizeof(uint32_t), TEST_RING_ENTRIES);
+    void *producer_addr = map_channel(fd, size);
+    void *consumer_addr = map_channel(fd, size);
+
+    CHECK_TRUE(producer_addr != NULL);
+    CHECK_TRUE(consumer_addr != NULL);
+
+    jinue_channel_t producer_channel;
+    jinue_channel_attach(&producer_channel, fd, producer_addr);
+    jinue_channel_attach(&consumer_channel, fd, consumer_addr);
+
+    CHECK_TRUE(producer_channel.entry_size == sizeof(uint32_t));
+    CHECK_TRUE(producer_channel.entries == TEST_RING_ENTRIES);
+
+    pthread_t thread;
+
+    if(start_thread(&thread, test_consumer_thread, NULL) != EXIT_SUCCESS) {
+        return false;
+    }
+
+    bool enqueued = true;
+
+    for(uint32_t idx = 0; idx < TEST_ENTRIES && enqueued; ++idx) {
+        enqueued = jinue_channel_enqueue(&producer_channel, &idx, &errno) == 0;
+    }
+
+    void *consumer_passed;
+    CHECK_ZERO(pthread_join(thread, &consumer_passed));
+
+    CHECK_TRUE(enqueued);
+    CHECK_TRUE(consumer_passed);
+
+    /* Both mappings are views of the same memory. */
+    CHECK_TRUE(producer_channel.header->tail == TEST_ENTRIES);
+    CHECK_TRUE(consumer_channel.header->head == TEST_ENTRIES);
+
+    CHECK_ZERO(jinue_close(fd, &errno));
+
+    return true;
+}
+
+bool test_channel_unmap(void) {
+    size_t size = jinue_channel_size(REMAP_ENTRY_SIZE, REMAP_ENTRIES);
+    void *addr  = mmap_reserve(size);
+
+    if(addr == NULL) {
+        jinue_error("error: could not reserve address space: %s", strerror(errno));
+        return false;
+    }
+
+    int fd = libc_allocate_descriptor();
+
+    if(fd < 0) {
+        jinue_error("error: libc_allocate_descriptor() failed: %s", strerror(errno));
+        return false;
+    }
+
+    /* The same addresses are reused each time since the shared memory is
+     * unmapped when the channel is destroyed. */
+    for(int idx = 0; idx < REMAP_ITERATIONS; ++idx) {
+        CHECK_ZERO(jinue_create_channel(fd, REMAP_ENTRY_SIZE, REMAP_ENTRIES, &errno));
+        CHECK_ZERO(jinue_map_channel(JINUE_DESC_SELF_PROCESS, fd, addr, &errno));
+
+        jinue_channel_t channel;
+        jinue_channel_attach(&channel, fd, addr);
+
+        CHECK_TRUE(channel.entries == REMAP_ENTRIES);
+
+        CHECK_ZERO(jinue_close(fd, &errno));
+    }
+
+    return true;
+}
+
+void run_channel_benchmark(void) {
+    if(! bool_getenv("RUN_TEST_CHANNEL_BENCHMARK")) {
+        return;
+    }
+
+    jinue_info("Running channel benchmark...");
+
+    int fd = libc_allocate_descriptor();
+
+    if(fd < 0) {
+        jinue_error("error: libc_allocate_descriptor() failed: %s", strerror(errno));
+        return;
+    }
+
+    if(jinue_create_channel(fd, sizeof(benchmark_entry_t), RING_ENTRIES, &errno) < 0) {
+        jinue_error("error: could not create channel: %s", strerror(errno));
+        return;
+    }
+
+    /* The producer and the consumer each use their own mapping of the shared
+     * memory, like two processes would. */
+    size_t size         = jinue_channel_size(sizeof(benchmark_entry_t), RING_ENTRIES);
+    void *producer_addr = map_channel(fd, size);
+    void *consumer_addr = map_channel(fd, size);
+
+    if(producer_addr == NULL || consumer_addr == NULL) {
+        return;
+    }
+
+    jinue_channel_t producer_channel;
+    jinue_channel_attach(&producer_channel, fd, producer_addr);
+    jinue_channel_attach(&consumer_channel, fd, consumer_addr);
+
+    pthread_t thread;
+
+    if(start_thread(&thread, consumer_thread, NULL) != EXIT_SUCCESS) {
+        return;
+    }
+
+    benchmark_entry_t entry;
+    memset(&entry, 0, sizeof(entry));
+
+    uint64_t start = read_tsc();
+
+    for(uint32_t idx = 0; idx < BENCHMARK_ENTRIES; ++idx) {
+        entry.seq = idx;
+
+        if(jinue_channel_enqueue(&producer_channel, &entry, &errno) < 0) {
+            jinue_error("error: jinue_channel_enqueue() failed: %s.", strerror(errno));
+            return;
+        }
+    }
+
+    int status = pthread_join(thread, NULL);
+
+    uint64_t cycles = read_tsc() - start;
+
+    if(status != 0) {
+        jinue_error("error: failed to join consumer thread: %s", strerror(status));
+        return;
+    }
+
+    uint64_t bytes = (uint64_t)BENCHMARK_ENTRIES * sizeof(benchmark_entry_t);
+
+    /* bytes per cycle with two decimals */
+    uint64_t hundredths = (cycles == 0) ? 0 : (100 * bytes) / cycles;
+
+    jinue_info("Channel benchmark:");
+    jinue_info("  entries:          %d", BENCHMARK_ENTRIES);
+    jinue_info("  entry size:       %zu", sizeof(benchmark_entry_t));
+    jinue_info("  cycles per entry: %" PRIu64, cycles / BENCHMARK_ENTRIES);
+    jinue_info(
+        "  bytes per cycle:  %" PRIu64 ".%02" PRIu64,
+        hundredths / 100,
+        hundredths % 100
+    );
+
+    if(jinue_close(fd, &errno) < 0) {
+        jinue_error("error: failed to close channel descriptor: %s", strerror(errno));
+        return;
+    }
+
+    jinue_info("Channel benchmark complete.");
+}
@@ -0,0 +1,299 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jinue/jinue.h>
+#include <jinue/utils.h>
+#include <errno.h>
+#include <internals.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../utils.h"
+#include "tests.h"
+
+#define MSG_FUNC_CONNECT    (JINUE_SYS_USER_BASE + 8)
+
+#define MSG_FUNC_REQUEST    (JINUE_SYS_USER_BASE + 9)
+
+#define NOTIFICATION_BITS   0x42
+
+static int server_endpoint;
+
+static void init_message(jinue_message_t *message) {
+    message->send_buffers           = NULL;
+    message->send_buffers_length    = 0;
+    message->recv_buffers           = NULL;
+    message->recv_buffers_length    = 0;
+    message->send_descs             = NULL;
+    message->send_descs_length      = 0;
+    message->recv_descs             = NULL;
+    message->recv_descs_length      = 0;
+}
+
+static int allocate_descriptor(void) {
+    int fd = libc_allocate_descriptor();
+
+    if(fd < 0) {
+        jinue_error("error: libc_allocate_descriptor() failed: %s", strerror(errno));
+    }
+
+    return fd;
+}
+
+static bool check_notification_descriptor(int fd) {
+    if(jinue_notify(fd, NOTIFICATION_BITS, &errno) < 0) {
+        jinue_error("error: jinue_notify() failed on transferred descriptor: %s.", strerror(errno));
+        return false;
+    }
+
+    uintptr_t bits;
+
+    if(jinue_wait_notification(fd, &bits, &errno) >= 0 || errno != JINUE_EPERM) {
+        jinue_error("error: waiting on a send-only descriptor did not fail with EPERM");
+        return false;
+    }
+
+    return true;
+}
+
+static void *server_thread(void *arg) {
+    int slot = allocate_descriptor();
+
+    if(slot < 0) {
+        return (void *)false;
+    }
+
+    jinue_message_t message;
+    init_message(&message);
+    message.recv_descs          = &slot;
+    message.recv_descs_length   = 1;
+
+    intptr_t ret = jinue_receive(server_endpoint | JINUE_IPC_DESCS, &message, &errno);
+
+    if(ret < 0) {
+        jinue_error("error: jinue_receive() failed: %s.", strerror(errno));
+        return (void *)false;
+    }
+
+    if(message.recv_function != MSG_FUNC_CONNECT || message.recv_descs_count != 1) {
+        jinue_error("error: expected one descriptor with the connect message");
+        return (void *)false;
+    }
+
+    if(! check_notification_descriptor(slot)) {
+        return (void *)false;
+    }
+
+    int private_endpoint = allocate_descriptor();
+
+    if(private_endpoint < 0) {
+        return (void *)false;
+    }
+
+    if(jinue_create_endpoint(private_endpoint, &errno) < 0) {
+        jinue_error("error: could not create IPC endpoint: %s", strerror(errno));
+        return (void *)false;
+    }
+
+    jinue_send_desc_t send_desc;
+    send_desc.fd    = private_endpoint;
+    send_desc.perms = JINUE_PERM_SEND;
+
+    jinue_message_t reply;
+    init_message(&reply);
+    reply.send_descs        = &send_desc;
+    reply.send_descs_length = 1;
+
+    if(jinue_reply_descs(&reply, &errno) < 0) {
+        jinue_error("error: jinue_reply_descs() failed: %s.", strerror(errno));
+        return (void *)false;
+    }
+
+    init_message(&message);
+
+    ret = jinue_receive(private_endpoint, &message, &errno);
+
+    if(ret < 0) {
+        jinue_error("error: jinue_receive() failed on private endpoint: %s.", strerror(errno));
+        return (void *)false;
+    }
+
+    if(message.recv_function != MSG_FUNC_REQUEST) {
+        jinue_error("error: unexpected function number on private endpoint");
+        return (void *)false;
+    }
+
+    if(jinue_reply(&message, &errno) < 0) {
+        jinue_error("error: jinue_reply() failed: %s.", strerror(errno));
+        return (void *)false;
+    }
+
+    return (void *)true;
+}
+
+static bool connect_to_server(int notification, int *endpoint) {
+    jinue_send_desc_t send_desc;
+    send_desc.fd    = notification;
+    send_desc.perms = JINUE_PERM_SEND;
+
+    int slot = allocate_descriptor();
+
+    if(slot < 0) {
+        return false;
+    }
+
+    jinue_message_t message;
+    init_message(&message);
+    message.send_descs          = &send_desc;
+    message.send_descs_length   = 1;
+    message.recv_descs          = &slot;
+    message.recv_descs_length   = 1;
+
+    intptr_t ret = jinue_send(
+        server_endpoint | JINUE_IPC_DESCS,
+        MSG_FUNC_CONNECT,
+        &message,
+        &errno,
+        NULL
+    );
+
+    if(ret < 0) {
+        jinue_error("error: jinue_send() failed: %s.", strerror(errno));
+        return false;
+    }
+
+    if(message.recv_descs_count != 1) {
+        jinue_error("error: expected one descriptor with the reply");
+        return false;
+    }
+
+    *endpoint = slot;
+
+    return true;
+}
+
+static bool check_endpoint_descriptor(int fd) {
+    jinue_message_t message;
+    init_message(&message);
+
+    if(jinue_receive(fd, &message, &errno) >= 0 || errno != JINUE_EPERM) {
+        jinue_error("error: receiving on a send-only descriptor did not fail with EPERM");
+        return false;
+    }
+
+    if(jinue_send(fd, MSG_FUNC_REQUEST, &message, &errno, NULL) < 0) {
+        jinue_error("error: jinue_send() failed on transferred descriptor: %s.", strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
+static bool check_notified(int notification) {
+    uintptr_t bits;
+
+    if(jinue_wait_notification(notification, &bits, &errno) < 0) {
+        jinue_error("error: jinue_wait_notification() failed: %s.", strerror(errno));
+        return false;
+    }
+
+    if(bits != NOTIFICATION_BITS) {
+        jinue_error("error: unexpected notification bits %#" PRIxPTR, bits);
+        return false;
+    }
+
+    return true;
+}
+
+bool test_desc_transfer(void) {
+    server_endpoint = allocate_descriptor();
+
+    if(server_endpoint < 0) {
+        return false;
+    }
+
+    if(jinue_create_endpoint(server_endpoint, &errno) < 0) {
+        jinue_error("error: could not create IPC endpoint: %s", strerror(errno));
+        return false;
+    }
+
+    int notification = allocate_descriptor();
+
+    if(notification < 0) {
+        return false;
+    }
+
+    if(jinue_create_notification(notification, &errno) < 0) {
+        jinue_error("error: could not create notification: %s", strerror(errno));
+        return false;
+    }
+
+    pthread_t thread;
+
+    if(start_thread(&thread, server_thread, NULL) != EXIT_SUCCESS) {
+        return false;
+    }
+
+    int endpoint;
+
+    if(! connect_to_server(notification, &endpoint)) {
+        return false;
+    }
+
+    if(! check_endpoint_descriptor(endpoint)) {
+        return false;
+    }
+
+    if(! check_notified(notification)) {
+        return false;
+    }
+
+    void *server_passed;
+    int status = pthread_join(thread, &server_passed);
+
+    if(status != 0) {
+        jinue_error("error: failed to join server thread: %s", strerror(status));
+        return false;
+    }
+
+    if(! server_passed) {
+        return false;
+    }
+
+    if(jinue_close(endpoint, &errno) < 0 || jinue_close(notification, &errno) < 0) {
+        jinue_error("error: failed to close descriptor: %s", strerror(errno));
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jinue/jinue.h>
+#include <jinue/utils.h>
+#include <errno.h>
+#include <internals.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../utils.h"
+#include "tests.h"
+
+#define MSG_FUNC_TEST   (JINUE_SYS_USER_BASE + 42)
+
+static void *client_thread(void *arg) {
+    int fd = (int)(intptr_t)arg;
+
+    jinue_const_buffer_t send_buffer;
+    send_buffer.addr = &fd;
+    send_buffer.size = sizeof(fd);
+
+    jinue_message_t message;
+    message.send_buffers        = &send_buffer;
+    message.send_buffers_length = 1;
+    message.recv_buffers        = NULL;
+    message.recv_buffers_length = 0;
+
+    intptr_t ret = jinue_send(fd, MSG_FUNC_TEST, &message, &errno, NULL);
+
+    if(ret < 0) {
+        jinue_error("error: jinue_send() failed: %s.", strerror(errno));
+        return (void *)false;
+    }
+
+    return (void *)true;
+}
+
+static bool receive_from_set(int set, int expected_endpoint) {
+    int sent_fd;
+
+    jinue_buffer_t recv_buffer;
+    recv_buffer.addr = &sent_fd;
+    recv_buffer.size = sizeof(sent_fd);
+
+    jinue_message_t message;
+    message.send_buffers        = NULL;
+    message.send_buffers_length = 0;
+    message.recv_buffers        = &recv_buffer;
+    message.recv_buffers_length = 1;
+
+    intptr_t ret = jinue_receive(set, &message, &errno);
+
+    if(ret < 0) {
+        jinue_error("error: jinue_receive() failed: %s.", strerror(errno));
+        return false;
+    }
+
+    if(message.recv_endpoint != expected_endpoint || sent_fd != expected_endpoint) {
+        jinue_error("error: expected message sent to endpoint %d", expected_endpoint);
+        return false;
+    }
+
+    ret = jinue_reply(&message, &errno);
+
+    if(ret < 0) {
+        jinue_error("error: jinue_reply() failed: %s.", strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
+static int create_endpoint(void) {
+    int fd = libc_allocate_descriptor();
+
+    if(fd < 0) {
+        jinue_error("error: libc_allocate_descriptor() failed: %s", strerror(errno));
+        return -1;
+    }
+
+    if(jinue_create_endpoint(fd, &errno) < 0) {
+        jinue_error("error: could not create IPC endpoint: %s", strerror(errno));
+        return -1;
+    }
+
+    return fd;
+}
+
+bool test_endpoint_set(void) {
+    int set = libc_allocate_descriptor();
+
+    if(set < 0) {
+        jinue_error("error: libc_allocate_descriptor() failed: %s", strerror(errno));
+        return false;
+    }
+
+    if(jinue_create_endpoint_set(set, &errno) < 0) {
+        jinue_error("error: could not create endpoint set: %s", strerror(errno));
+        return false;
+    }
+
+    int endpoints[2];
+
+    for(int idx = 0; idx < 2; ++idx) {
+        endpoints[idx] = create_endpoint();
+
+        if(endpoints[idx] < 0) {
+            return false;
+        }
+
+        if(jinue_add_to_endpoint_set(set, endpoints[idx], &errno) < 0) {
+            jinue_error("error: could not add endpoint to set: %s", strerror(errno));
+            return false;
+        }
+    }
+
+    jinue_message_t message;
+    message.send_buffers        = NULL;
+    message.send_buffers_length = 0;
+    message.recv_buffers        = NULL;
+    message.recv_buffers_length = 0;
+
+    /* A member endpoint can only be received from through its set. */
+    CHECK_TRUE(jinue_receive(endpoints[0], &message, &errno) < 0);
+    CHECK_TRUE(errno == JINUE_EBUSY);
+
+    /* Start the clients in reverse order of endpoints and let each one block
+     * sending before starting the next, so the message sent to the second
+     * endpoint is the oldest. */
+    pthread_t threads[2];
+
+    for(int idx = 1; idx >= 0; --idx) {
+        if(start_thread(&threads[idx], client_thread, (void *)(intptr_t)endpoints[idx]) != EXIT_SUCCESS) {
+            return false;
+        }
+
+        jinue_yield_thread();
+    }
+
+    CHECK_TRUE(receive_from_set(set, endpoints[1]));
+    CHECK_TRUE(receive_from_set(set, endpoints[0]));
+
+    for(int idx = 0; idx < 2; ++idx) {
+        void *client_passed;
+        CHECK_ZERO(pthread_join(threads[idx], &client_passed));
+        CHECK_TRUE(client_passed);
+        CHECK_ZERO(jinue_close(endpoints[idx], &errno));
+    }
+
+    CHECK_ZERO(jinue_close(set, &errno));
+
+    return true;
+}
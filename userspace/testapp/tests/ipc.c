@@ -37,14 +37,28 @@
 #include <inttypes.h>
 #include <limits.h>
 #include <pthread.h>
+#include <stdlib.h>
 #include <string.h>
 #include "../utils.h"
 #include "tests.h"
+#include "tsc.h"
 
-#define MSG_FUNC_TEST   (JINUE_SYS_USER_BASE + 42)
+#define MSG_FUNC_TEST               (JINUE_SYS_USER_BASE + 42)
+
+#define MSG_FUNC_BENCHMARK          (JINUE_SYS_USER_BASE + 43)
+
+#define MSG_FUNC_BENCHMARK_EXIT     (JINUE_SYS_USER_BASE + 44)
+
+#define BENCHMARK_ITERATIONS        1000
 
 int client_endpoint;
 
+static int benchmark_endpoint;
+
+static char benchmark_client_data[JINUE_MAX_MESSAGE_SIZE];
+
+static char benchmark_server_data[JINUE_MAX_MESSAGE_SIZE];
+
 static void ipc_test_run_client(void) {
     /* The order of these buffers is shuffled on purpose because they will be
      * concatenated later and we don't want things to look OK by coincidence. */
@@ -122,34 +136,28 @@ static void *ipc_test_client_thread(void *arg) {
     return (void *)(uintptr_t)0xdeadbeef;
 }
 
-void run_ipc_test(void) {
+static bool test_send_receive(void) {
     char recv_data[64];
 
-    if(! bool_getenv("RUN_TEST_IPC")) {
-        return;
-    }
-
-    jinue_info("Running threading and IPC test...");
-
     int endpoint = libc_allocate_descriptor();
 
     if(endpoint < 0) {
         jinue_error("error: libc_allocate_descriptor() failed: %s", strerror(errno));
-        return;
+        return false;
     }
 
     int status = jinue_create_endpoint(endpoint, &errno);
 
     if(status < 0) {
         jinue_error("error: could not create IPC endpoint: %s", strerror(errno));
-        return;
+        return false;
     }
 
     client_endpoint = libc_allocate_descriptor();
 
     if(client_endpoint < 0) {
         jinue_error("error: libc_allocate_descriptor() failed: %s", strerror(errno));
-        return;
+        return false;
     }
 
     status = jinue_mint(
@@ -163,7 +171,7 @@ void run_ipc_test(void) {
 
     if(status < 0) {
         jinue_error("error: jinue_mint() failed: %s", strerror(errno));
-        return;
+        return false;
     }
 
     jinue_buffer_t recv_buffer;
@@ -180,12 +188,12 @@ void run_ipc_test(void) {
 
     if(ret >= 0) {
         jinue_error("error: jinue_receive() unuexpectedly succeeded.");
-        return;
+        return false;
     }
 
     if(errno != JINUE_EPERM) {
         jinue_error("error: jinue_receive() failed: %s.", strerror(errno));
-        return;
+        return false;
     }
 
     jinue_info("expected: jinue_receive() set errno to: %s.", strerror(errno));
@@ -196,14 +204,14 @@ void run_ipc_test(void) {
 
     if(status != 0) {
         jinue_error("error: pthread_attr_init() failed: %s", strerror(status));
-        return;
+        return false;
     }
 
     status = pthread_attr_setstacksize(&attr, PTHREAD_STACK_MIN);
 
     if(status != 0) {
         jinue_error("error: pthread_attr_setstacksize() failed: %s", strerror(status));
-        return;
+        return false;
     }
 
     pthread_t client_thread; 
@@ -211,21 +219,21 @@ void run_ipc_test(void) {
 
     if(status != 0) {
         jinue_error("error: could not create thread: %s", strerror(status));
-        return;
+        return false;
     }
 
     ret = jinue_receive(endpoint, &message, &errno);
 
     if(ret < 0) {
         jinue_error("error: jinue_receive() failed: %s.", strerror(errno));
-        return;
+        return false;
     }
 
     int function = message.recv_function;
 
     if(function != MSG_FUNC_TEST) {
         jinue_error("error: jinue_receive() unexpected function number: %i.", function);
-        return;
+        return false;
     }
 
     jinue_info("Main thread received message:");
@@ -249,7 +257,7 @@ void run_ipc_test(void) {
 
     if(ret < 0) {
         jinue_error("error: jinue_reply() failed: %s", strerror(errno));
-        return;
+        return false;
     }
 
     jinue_info("Closing receiver descriptor.");
@@ -258,7 +266,7 @@ void run_ipc_test(void) {
 
     if(status < 0) {
         jinue_error("error: failed to close endpoint descriptor: %s", strerror(errno));
-        return;
+        return false;
     }
 
     void *client_exit_value;
@@ -266,9 +274,307 @@ void run_ipc_test(void) {
     
     if(status != 0) {
         jinue_error("error: failed to join client thread: %s", strerror(status));
-        return;
+        return false;
     }
     
     jinue_info("Client thread exit value is %#p.", client_exit_value);
     jinue_info("Main thread is running.");
+
+    return true;
+}
+
+void run_ipc_test(void) {
+    if(! bool_getenv("RUN_TEST_IPC")) {
+        return;
+    }
+
+    jinue_info("Running threading and IPC test...");
+
+    bool pass = true;
+
+    pass &= run_subtest(test_send_receive, "send and receive");
+    pass &= run_subtest(test_endpoint_set, "endpoint set");
+    pass &= run_subtest(test_notification, "notification");
+    pass &= run_subtest(test_channel, "channel");
+    pass &= run_subtest(test_channel_unmap, "channel unmapping");
+    pass &= run_subtest(test_bulk_ipc, "bulk mode");
+    pass &= run_subtest(test_desc_transfer, "descriptor transfer");
+    pass &= run_subtest(test_nonblocking_ipc, "non-blocking send and receive");
+    pass &= run_subtest(test_ipc_timeout, "send and receive timeouts");
+    pass &= run_subtest(test_priority_ipc, "priority ordering and inheritance");
+    pass &= run_subtest(test_async_ipc, "asynchronous send");
+    pass &= run_subtest(test_batch_ipc, "batched send and receive");
+    pass &= run_subtest(test_lifo_receive, "LIFO receive");
+    pass &= run_subtest(test_kmalloc, "kmalloc statistics");
+
+    jinue_info("IPC test result: %s", pass ? "PASS" : "FAIL");
+}
+
+static void *ipc_benchmark_server_thread(void *arg) {
+    jinue_buffer_t recv_buffer;
+    recv_buffer.addr = benchmark_server_data;
+    recv_buffer.size = sizeof(benchmark_server_data);
+
+    jinue_const_buffer_t reply_buffer;
+    reply_buffer.addr = benchmark_server_data;
+
+    jinue_message_t message;
+    message.send_buffers        = &reply_buffer;
+    message.send_buffers_length = 1;
+    message.recv_buffers        = &recv_buffer;
+    message.recv_buffers_length = 1;
+
+    while(true) {
+        intptr_t ret = jinue_receive(benchmark_endpoint, &message, &errno);
+
+        if(ret < 0) {
+            jinue_error("error: jinue_receive() failed: %s.", strerror(errno));
+            return NULL;
+        }
+
+        /* echo the message back to the client */
+        reply_buffer.size = ret;
+
+        ret = jinue_reply(&message, &errno);
+
+        if(ret < 0) {
+            jinue_error("error: jinue_reply() failed: %s", strerror(errno));
+            return NULL;
+        }
+
+        if(message.recv_function == MSG_FUNC_BENCHMARK_EXIT) {
+            return NULL;
+        }
+    }
+}
+
+static bool run_ipc_benchmark_pass(const char *name, bool server_waits) {
+    jinue_const_buffer_t send_buffer;
+    send_buffer.addr = benchmark_client_data;
+    send_buffer.size = sizeof(benchmark_client_data);
+
+    jinue_buffer_t recv_buffer;
+    recv_buffer.addr = benchmark_client_data;
+    recv_buffer.size = sizeof(benchmark_client_data);
+
+    jinue_message_t message;
+    message.send_buffers        = &send_buffer;
+    message.send_buffers_length = 1;
+    message.recv_buffers        = &recv_buffer;
+    message.recv_buffers_length = 1;
+
+    uint64_t cycles = 0;
+
+    for(int idx = 0; idx < BENCHMARK_ITERATIONS; ++idx) {
+        /* When the server replies, it remains ready to run but the client runs
+         * first. Yielding gives the server the opportunity to call
+         * jinue_receive() and block before the client sends the message. */
+        if(server_waits) {
+            jinue_yield_thread();
+        }
+
+        uint64_t start = read_tsc();
+
+        intptr_t ret = jinue_send(benchmark_endpoint, MSG_FUNC_BENCHMARK, &message, &errno, NULL);
+
+        cycles += read_tsc() - start;
+
+        if(ret < 0) {
+            jinue_error("error: jinue_send() failed: %s.", strerror(errno));
+            return false;
+        }
+    }
+
+    /* message and reply */
+    uint64_t bytes = 2 * (uint64_t)BENCHMARK_ITERATIONS * sizeof(benchmark_client_data);
+
+    /* bytes per cycle with two decimals */
+    uint64_t hundredths = (cycles == 0) ? 0 : (100 * bytes) / cycles;
+
+    jinue_info("IPC benchmark (%s):", name);
+    jinue_info("  round trips:      %d", BENCHMARK_ITERATIONS);
+    jinue_info("  message size:     %zu", sizeof(benchmark_client_data));
+    jinue_info("  cycles per trip:  %" PRIu64, cycles / BENCHMARK_ITERATIONS);
+    jinue_info(
+        "  bytes per cycle:  %" PRIu64 ".%02" PRIu64,
+        hundredths / 100,
+        hundredths % 100
+    );
+
+    return true;
+}
+
+static void *ipc_benchmark_short_server_thread(void *arg) {
+    jinue_short_message_t message;
+
+    while(true) {
+        int ret = jinue_receive_short(benchmark_endpoint, &message, &errno);
+
+        if(ret < 0) {
+            jinue_error("error: jinue_receive_short() failed: %s.", strerror(errno));
+            return NULL;
+        }
+
+        /* echo the message back to the client */
+        ret = jinue_reply_short(&message, &errno);
+
+        if(ret < 0) {
+            jinue_error("error: jinue_reply_short() failed: %s", strerror(errno));
+            return NULL;
+        }
+
+        if(message.function == MSG_FUNC_BENCHMARK_EXIT) {
+            return NULL;
+        }
+    }
+}
+
+static bool run_null_ipc_benchmark_pass(bool is_short) {
+    jinue_message_t message;
+    message.send_buffers        = NULL;
+    message.send_buffers_length = 0;
+    message.recv_buffers        = NULL;
+    message.recv_buffers_length = 0;
+
+    jinue_short_message_t short_message;
+    short_message.data[0] = 0;
+    short_message.data[1] = 0;
+
+    uint64_t cycles = 0;
+
+    for(int idx = 0; idx < BENCHMARK_ITERATIONS; ++idx) {
+        /* let the server block in receive first (see run_ipc_benchmark_pass()) */
+        jinue_yield_thread();
+
+        intptr_t ret;
+        uint64_t start = read_tsc();
+
+        if(is_short) {
+            ret = jinue_send_short(benchmark_endpoint, MSG_FUNC_BENCHMARK, &short_message, &errno, NULL);
+        }
+        else {
+            ret = jinue_send(benchmark_endpoint, MSG_FUNC_BENCHMARK, &message, &errno, NULL);
+        }
+
+        cycles += read_tsc() - start;
+
+        if(ret < 0) {
+            jinue_error("error: sending message failed: %s.", strerror(errno));
+            return false;
+        }
+    }
+
+    jinue_info(
+        "Null IPC round trip (%s): %" PRIu64 " cycles",
+        is_short ? "short" : "regular",
+        cycles / BENCHMARK_ITERATIONS
+    );
+
+    return true;
+}
+
+static bool stop_ipc_benchmark_server(pthread_t server_thread, bool is_short) {
+    intptr_t ret;
+
+    if(is_short) {
+        jinue_short_message_t message;
+        message.data[0] = 0;
+        message.data[1] = 0;
+
+        ret = jinue_send_short(benchmark_endpoint, MSG_FUNC_BENCHMARK_EXIT, &message, &errno, NULL);
+    }
+    else {
+        jinue_message_t message;
+        message.send_buffers        = NULL;
+        message.send_buffers_length = 0;
+        message.recv_buffers        = NULL;
+        message.recv_buffers_length = 0;
+
+        ret = jinue_send(benchmark_endpoint, MSG_FUNC_BENCHMARK_EXIT, &message, &errno, NULL);
+    }
+
+    if(ret < 0) {
+        jinue_error("error: sending exit message failed: %s.", strerror(errno));
+        return false;
+    }
+
+    int status = pthread_join(server_thread, NULL);
+
+    if(status != 0) {
+        jinue_error("error: failed to join server thread: %s", strerror(status));
+        return false;
+    }
+
+    return true;
+}
+
+void run_ipc_benchmark(void) {
+    if(! bool_getenv("RUN_TEST_IPC_BENCHMARK")) {
+        return;
+    }
+
+    jinue_info("Running IPC benchmark...");
+
+    benchmark_endpoint = libc_allocate_descriptor();
+
+    if(benchmark_endpoint < 0) {
+        jinue_error("error: libc_allocate_descriptor() failed: %s", strerror(errno));
+        return;
+    }
+
+    int status = jinue_create_endpoint(benchmark_endpoint, &errno);
+
+    if(status < 0) {
+        jinue_error("error: could not create IPC endpoint: %s", strerror(errno));
+        return;
+    }
+
+    pthread_t server_thread;
+
+    if(start_thread(&server_thread, ipc_benchmark_server_thread, NULL) != EXIT_SUCCESS) {
+        return;
+    }
+
+    /* The sender finds no receiver waiting, so the message is copied to the
+     * kernel's message buffer first and then copied again by the receiver. */
+    if(! run_ipc_benchmark_pass("staged", false)) {
+        return;
+    }
+
+    /* The receiver is always waiting, so the message is copied directly from
+     * the sender's buffer to the receiver's buffer. */
+    if(! run_ipc_benchmark_pass("direct", true)) {
+        return;
+    }
+
+    if(! run_null_ipc_benchmark_pass(false)) {
+        return;
+    }
+
+    if(! stop_ipc_benchmark_server(server_thread, false)) {
+        return;
+    }
+
+    if(start_thread(&server_thread, ipc_benchmark_short_server_thread, NULL) != EXIT_SUCCESS) {
+        return;
+    }
+
+    /* The message is passed in registers only, without send or receive
+     * buffers. */
+    if(! run_null_ipc_benchmark_pass(true)) {
+        return;
+    }
+
+    if(! stop_ipc_benchmark_server(server_thread, true)) {
+        return;
+    }
+
+    status = jinue_close(benchmark_endpoint, &errno);
+
+    if(status < 0) {
+        jinue_error("error: failed to close endpoint descriptor: %s", strerror(errno));
+        return;
+    }
+
+    jinue_info("IPC benchmark complete.");
 }
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <jinue/jinue.h>
+#include <jinue/utils.h>
+#include <errno.h>
+#include <internals.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "../utils.h"
+#include "tests.h"
+
+/* more than the kernel reports, i.e. one per size class plus one for pages */
+#define MAX_STATS           32
+
+/* The kernel allocates the array of page addresses of a channel with kmalloc(),
+ * four bytes per page. The small channel fits in one page, i.e. four bytes in
+ * the 8-byte class, and the large one needs 32 pages, i.e. 128 bytes. */
+#define SMALL_ENTRY_SIZE    4
+
+#define SMALL_ENTRIES       4
+
+#define SMALL_CLASS_SIZE    8
+
+#define LARGE_ENTRY_SIZE    4000
+
+#define LARGE_ENTRIES       32
+
+#define LARGE_CLASS_SIZE    128
+
+static int get_stats(jinue_kmalloc_stats_t *stats, int length) {
+    jinue_buffer_t buffer;
+    buffer.addr = stats;
+    buffer.size = length * sizeof(jinue_kmalloc_stats_t);
+
+    int ret = jinue_get_kmalloc_stats(&buffer, &errno);
+
+    if(ret < 0) {
+        jinue_error("error: jinue_get_kmalloc_stats() failed: %s", strerror(errno));
+    }
+
+    return ret;
+}
+
+static int find_class(const jinue_kmalloc_stats_t *stats, int length, uint32_t size) {
+    for(int idx = 0; idx < length; ++idx) {
+        if(stats[idx].size == size) {
+            return idx;
+        }
+    }
+
+    return -1;
+}
+
+static int create_channel(uint32_t entry_size, uint32_t entries) {
+    int fd = libc_allocate_descriptor();
+
+    if(fd < 0) {
+        jinue_error("error: libc_allocate_descriptor() failed: %s", strerror(errno));
+        return -1;
+    }
+
+    if(jinue_create_channel(fd, entry_size, entries, &errno) < 0) {
+        jinue_error("error: could not create channel: %s", strerror(errno));
+        return -1;
+    }
+
+    return fd;
+}
+
+bool test_kmalloc(void) {
+    jinue_kmalloc_stats_t before[MAX_STATS];
+    jinue_kmalloc_stats_t during[MAX_STATS];
+    jinue_kmalloc_stats_t after[MAX_STATS];
+
+    /* Only the entries that fit in the buffer are written. */
+    CHECK_TRUE(get_stats(before, 1) == 1);
+
+    int length = get_stats(before, MAX_STATS);
+
+    CHECK_TRUE(length > 1);
+    CHECK_TRUE(length < MAX_STATS);
+
+    /* The last entry is for allocations served in whole pages. */
+    CHECK_TRUE(before[length - 1].size == 0);
+
+    int small_class = find_class(before, length, SMALL_CLASS_SIZE);
+    int large_class = find_class(before, length, LARGE_CLASS_SIZE);
+
+    CHECK_TRUE(small_class >= 0);
+    CHECK_TRUE(large_class >= 0);
+
+    int small_fd = create_channel(SMALL_ENTRY_SIZE, SMALL_ENTRIES);
+    int large_fd = create_channel(LARGE_ENTRY_SIZE, LARGE_ENTRIES);
+
+    CHECK_TRUE(small_fd >= 0);
+    CHECK_TRUE(large_fd >= 0);
+
+    CHECK_TRUE(get_stats(during, MAX_STATS) == length);
+
+    /* Each allocation falls in the expected size class, and only there. */
+    for(int idx = 0; idx < length; ++idx) {
+        uint32_t expected = (idx == small_class || idx == large_class) ? 1 : 0;
+
+        CHECK_TRUE(during[idx].allocs - before[idx].allocs == expected);
+        CHECK_TRUE(during[idx].allocated - before[idx].allocated == expected);
+        CHECK_TRUE(during[idx].failures == before[idx].failures);
+    }
+
+    CHECK_TRUE(during[small_class].bytes - before[small_class].bytes == SMALL_CLASS_SIZE);
+    CHECK_TRUE(during[large_class].bytes - before[large_class].bytes == LARGE_CLASS_SIZE);
+
+    if(jinue_close(small_fd, &errno) < 0 || jinue_close(large_fd, &errno) < 0) {
+        jinue_error("error: failed to close channel descriptor: %s", strerror(errno));
+        return false;
+    }
+
+    CHECK_TRUE(get_stats(after, MAX_STATS) == length);
+
+    /* Every allocation was freed. */
+    for(int idx = 0; idx < length; ++idx) {
+        CHECK_TRUE(after[idx].allocs == during[idx].allocs);
+        CHECK_TRUE(after[idx].allocated == before[idx].allocated);
+        CHECK_TRUE(after[idx].bytes == before[idx].bytes);
+    }
+
+    return true;
+}
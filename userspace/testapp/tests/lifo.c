@@ -0,0 +1,273 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jinue/jinue.h>
+#include <jinue/utils.h>
+#include <errno.h>
+#include <internals.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../utils.h"
+#include "tests.h"
+
+#define MSG_FUNC_WORK       (JINUE_SYS_USER_BASE + 20)
+
+#define MSG_FUNC_EXIT       (JINUE_SYS_USER_BASE + 21)
+
+#define NUM_SERVERS         3
+
+#define NUM_REQUESTS        8
+
+/* number of times to yield to let the other threads block on their call */
+#define YIELD_COUNT         10
+
+static int endpoint;
+
+static int test_cpu;
+
+static int server_ids[NUM_SERVERS];
+
+static void yield_to_others(void) {
+    for(int idx = 0; idx < YIELD_COUNT; ++idx) {
+        jinue_yield_thread();
+    }
+}
+
+static bool pin_thread(pthread_t thread, int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+
+    int status = pthread_setaffinity_np(thread, sizeof(set), &set);
+
+    if(status != 0) {
+        jinue_error("error: pthread_setaffinity_np() failed: %s", strerror(status));
+        return false;
+    }
+
+    return true;
+}
+
+static void *server_thread(void *arg) {
+    int id = *(int *)arg;
+
+    /* Run on the same CPU as the main thread so the servers start waiting in
+     * order, and so none of them is preferred for having last run on the
+     * sender's CPU. */
+    if(! pin_thread(pthread_self(), test_cpu)) {
+        return (void *)false;
+    }
+
+    while(true) {
+        jinue_message_t message;
+        message.recv_buffers        = NULL;
+        message.recv_buffers_length = 0;
+
+        if(jinue_receive(endpoint, &message, &errno) < 0) {
+            jinue_error("error: jinue_receive() failed: %s.", strerror(errno));
+            return (void *)false;
+        }
+
+        /* reply with the identifier of this server thread */
+        jinue_const_buffer_t reply_buffer;
+        reply_buffer.addr = &id;
+        reply_buffer.size = sizeof(id);
+
+        message.send_buffers        = &reply_buffer;
+        message.send_buffers_length = 1;
+
+        if(jinue_reply(&message, &errno) < 0) {
+            jinue_error("error: jinue_reply() failed: %s.", strerror(errno));
+            return (void *)false;
+        }
+
+        if(message.recv_function == MSG_FUNC_EXIT) {
+            return (void *)true;
+        }
+    }
+}
+
+static int send_request(int function) {
+    int id;
+
+    jinue_buffer_t recv_buffer;
+    recv_buffer.addr = &id;
+    recv_buffer.size = sizeof(id);
+
+    jinue_message_t message;
+    message.send_buffers        = NULL;
+    message.send_buffers_length = 0;
+    message.recv_buffers        = &recv_buffer;
+    message.recv_buffers_length = 1;
+
+    if(jinue_send(endpoint, function, &message, &errno, NULL) < 0) {
+        jinue_error("error: jinue_send() failed: %s.", strerror(errno));
+        return -1;
+    }
+
+    return id;
+}
+
+bool test_lifo_receive(void) {
+    endpoint = libc_allocate_descriptor();
+
+    if(endpoint < 0) {
+        jinue_error("error: libc_allocate_descriptor() failed: %s", strerror(errno));
+        return false;
+    }
+
+    if(jinue_create_endpoint_flags(endpoint, ~JINUE_ENDPOINT_LIFO, &errno) >= 0 || errno != EINVAL) {
+        jinue_error("error: creating an endpoint with reserved flags did not fail with EINVAL");
+        return false;
+    }
+
+    if(jinue_create_endpoint_flags(endpoint, JINUE_ENDPOINT_LIFO, &errno) < 0) {
+        jinue_error("error: could not create IPC endpoint: %s", strerror(errno));
+        return false;
+    }
+
+    cpu_set_t all_cpus;
+    int status = pthread_getaffinity_np(pthread_self(), sizeof(all_cpus), &all_cpus);
+
+    if(status != 0) {
+        jinue_error("error: pthread_getaffinity_np() failed: %s", strerror(status));
+        return false;
+    }
+
+    test_cpu = jinue_get_cpu();
+
+    if(! pin_thread(pthread_self(), test_cpu)) {
+        return false;
+    }
+
+    pthread_t servers[NUM_SERVERS];
+
+    /* Start the servers one at a time so they start waiting in order. */
+    for(int idx = 0; idx < NUM_SERVERS; ++idx) {
+        server_ids[idx] = idx;
+
+        if(start_thread(&servers[idx], server_thread, &server_ids[idx]) != EXIT_SUCCESS) {
+            return false;
+        }
+
+        yield_to_others();
+    }
+
+    /* The server that replies goes back to waiting after the other ones, so
+     * it should receive every request. */
+    for(int idx = 0; idx < NUM_REQUESTS; ++idx) {
+        int id = send_request(MSG_FUNC_WORK);
+
+        if(id < 0) {
+            return false;
+        }
+
+        if(id != NUM_SERVERS - 1) {
+            jinue_error("error: request %i was received by server %i.", idx, id);
+            return false;
+        }
+
+        yield_to_others();
+    }
+
+    /* If the server at the head of the receive list moves to another CPU, the
+     * next one, which last ran on the sender's CPU, is preferred. */
+    int other_cpu = -1;
+
+    for(int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if(cpu != test_cpu && CPU_ISSET(cpu, &all_cpus)) {
+            other_cpu = cpu;
+            break;
+        }
+    }
+
+    if(other_cpu >= 0) {
+        if(! pin_thread(servers[NUM_SERVERS - 1], other_cpu)) {
+            return false;
+        }
+
+        /* The server still last ran on this CPU, so it receives this request
+         * and then moves. */
+        int id = send_request(MSG_FUNC_WORK);
+
+        if(id != NUM_SERVERS - 1) {
+            jinue_error("error: request was received by server %i before moving.", id);
+            return false;
+        }
+
+        yield_to_others();
+
+        id = send_request(MSG_FUNC_WORK);
+
+        if(id != NUM_SERVERS - 2) {
+            jinue_error("error: request was received by server %i after moving.", id);
+            return false;
+        }
+    }
+
+    for(int idx = 0; idx < NUM_SERVERS; ++idx) {
+        if(send_request(MSG_FUNC_EXIT) < 0) {
+            return false;
+        }
+    }
+
+    for(int idx = 0; idx < NUM_SERVERS; ++idx) {
+        void *server_passed;
+        status = pthread_join(servers[idx], &server_passed);
+
+        if(status != 0) {
+            jinue_error("error: failed to join thread: %s", strerror(status));
+            return false;
+        }
+
+        if(! server_passed) {
+            return false;
+        }
+    }
+
+    if(jinue_close(endpoint, &errno) < 0) {
+        jinue_error("error: failed to close descriptor: %s", strerror(errno));
+        return false;
+    }
+
+    status = pthread_setaffinity_np(pthread_self(), sizeof(all_cpus), &all_cpus);
+
+    if(status != 0) {
+        jinue_error("error: pthread_setaffinity_np() failed: %s", strerror(status));
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jinue/jinue.h>
+#include <jinue/utils.h>
+#include <errno.h>
+#include <internals.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../utils.h"
+#include "tests.h"
+
+#define MSG_FUNC_POLL   (JINUE_SYS_USER_BASE + 10)
+
+#define MAX_POLLS       1000
+
+static int endpoint;
+
+static void init_message(jinue_message_t *message) {
+    message->send_buffers           = NULL;
+    message->send_buffers_length    = 0;
+    message->recv_buffers           = NULL;
+    message->recv_buffers_length    = 0;
+}
+
+static void *sender_thread(void *arg) {
+    jinue_message_t message;
+    init_message(&message);
+
+    if(jinue_send(endpoint, MSG_FUNC_POLL, &message, &errno, NULL) < 0) {
+        jinue_error("error: jinue_send() failed: %s.", strerror(errno));
+        return (void *)false;
+    }
+
+    return (void *)true;
+}
+
+static void *receiver_thread(void *arg) {
+    jinue_message_t message;
+    init_message(&message);
+
+    if(jinue_receive(endpoint, &message, &errno) < 0) {
+        jinue_error("error: jinue_receive() failed: %s.", strerror(errno));
+        return (void *)false;
+    }
+
+    if(jinue_reply(&message, &errno) < 0) {
+        jinue_error("error: jinue_reply() failed: %s.", strerror(errno));
+        return (void *)false;
+    }
+
+    return (void *)true;
+}
+
+static bool join_thread(pthread_t thread) {
+    void *thread_passed;
+
+    int status = pthread_join(thread, &thread_passed);
+
+    if(status != 0) {
+        jinue_error("error: failed to join thread: %s", strerror(status));
+        return false;
+    }
+
+    return thread_passed != NULL;
+}
+
+static bool test_no_peer(void) {
+    jinue_message_t message;
+    init_message(&message);
+
+    if(jinue_receive(endpoint | JINUE_IPC_NONBLOCK, &message, &errno) >= 0 || errno != EAGAIN) {
+        jinue_error("error: non-blocking receive without sender did not fail with EAGAIN");
+        return false;
+    }
+
+    jinue_short_message_t short_message;
+
+    if(jinue_receive_short(endpoint | JINUE_IPC_NONBLOCK, &short_message, &errno) >= 0 || errno != EAGAIN) {
+        jinue_error("error: non-blocking short receive without sender did not fail with EAGAIN");
+        return false;
+    }
+
+    if(jinue_send(endpoint | JINUE_IPC_NONBLOCK, MSG_FUNC_POLL, &message, &errno, NULL) >= 0 || errno != EAGAIN) {
+        jinue_error("error: non-blocking send without receiver did not fail with EAGAIN");
+        return false;
+    }
+
+    return true;
+}
+
+static bool test_poll_receive(void) {
+    pthread_t thread;
+
+    if(start_thread(&thread, sender_thread, NULL) != EXIT_SUCCESS) {
+        return false;
+    }
+
+    jinue_message_t message;
+    init_message(&message);
+
+    int polls;
+
+    for(polls = 1; polls <= MAX_POLLS; ++polls) {
+        if(jinue_receive(endpoint | JINUE_IPC_NONBLOCK, &message, &errno) >= 0) {
+            break;
+        }
+
+        if(errno != EAGAIN) {
+            jinue_error("error: jinue_receive() failed: %s.", strerror(errno));
+            return false;
+        }
+
+        jinue_yield_thread();
+    }
+
+    if(polls > MAX_POLLS) {
+        jinue_error("error: no message was received after %d polls.", MAX_POLLS);
+        return false;
+    }
+
+    if(jinue_reply(&message, &errno) < 0) {
+        jinue_error("error: jinue_reply() failed: %s.", strerror(errno));
+        return false;
+    }
+
+    return join_thread(thread);
+}
+
+static bool test_poll_send(void) {
+    pthread_t thread;
+
+    if(start_thread(&thread, receiver_thread, NULL) != EXIT_SUCCESS) {
+        return false;
+    }
+
+    jinue_message_t message;
+    init_message(&message);
+
+    int polls;
+
+    for(polls = 1; polls <= MAX_POLLS; ++polls) {
+        if(jinue_send(endpoint | JINUE_IPC_NONBLOCK, MSG_FUNC_POLL, &message, &errno, NULL) >= 0) {
+            break;
+        }
+
+        if(errno != EAGAIN) {
+            jinue_error("error: jinue_send() failed: %s.", strerror(errno));
+            return false;
+        }
+
+        jinue_yield_thread();
+    }
+
+    if(polls > MAX_POLLS) {
+        jinue_error("error: no receiver was found after %d polls.", MAX_POLLS);
+        return false;
+    }
+
+    return join_thread(thread);
+}
+
+bool test_nonblocking_ipc(void) {
+    endpoint = libc_allocate_descriptor();
+
+    if(endpoint < 0) {
+        jinue_error("error: libc_allocate_descriptor() failed: %s", strerror(errno));
+        return false;
+    }
+
+    if(jinue_create_endpoint(endpoint, &errno) < 0) {
+        jinue_error("error: could not create IPC endpoint: %s", strerror(errno));
+        return false;
+    }
+
+    if(! test_no_peer()) {
+        return false;
+    }
+
+    if(! test_poll_receive()) {
+        return false;
+    }
+
+    if(! test_poll_send()) {
+        return false;
+    }
+
+    if(jinue_close(endpoint, &errno) < 0) {
+        jinue_error("error: failed to close endpoint descriptor: %s", strerror(errno));
+        return false;
+    }
+
+    return true;
+}
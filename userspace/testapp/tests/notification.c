@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jinue/jinue.h>
+#include <jinue/utils.h>
+#include <errno.h>
+#include <internals.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../utils.h"
+#include "tests.h"
+
+#define BITS_PENDING    0x5
+
+#define BITS_WAIT       0x2
+
+#define BITS_RECEIVE    0x10
+
+static void *notifier_thread(void *arg) {
+    int fd = (int)(intptr_t)arg;
+
+    if(jinue_notify(fd, BITS_WAIT, &errno) < 0) {
+        jinue_error("error: jinue_notify() failed: %s.", strerror(errno));
+        return (void *)false;
+    }
+
+    return (void *)true;
+}
+
+static void *receive_notifier_thread(void *arg) {
+    int fd = (int)(intptr_t)arg;
+
+    if(jinue_notify(fd, BITS_RECEIVE, &errno) < 0) {
+        jinue_error("error: jinue_notify() failed: %s.", strerror(errno));
+        return (void *)false;
+    }
+
+    return (void *)true;
+}
+
+static bool join_thread(pthread_t thread) {
+    void *notifier_passed;
+
+    int status = pthread_join(thread, &notifier_passed);
+
+    if(status != 0) {
+        jinue_error("error: failed to join notifier thread: %s", strerror(status));
+        return false;
+    }
+
+    return notifier_passed != NULL;
+}
+
+static bool wait_for_bits(int fd, uintptr_t expected) {
+    uintptr_t bits;
+
+    if(jinue_wait_notification(fd, &bits, &errno) < 0) {
+        jinue_error("error: jinue_wait_notification() failed: %s.", strerror(errno));
+        return false;
+    }
+
+    if(bits != expected) {
+        jinue_error("error: expected bits %#" PRIxPTR, expected);
+        return false;
+    }
+
+    return true;
+}
+
+static bool test_wait(int fd) {
+    if(jinue_notify(fd, 0x1, &errno) < 0 || jinue_notify(fd, 0x4, &errno) < 0) {
+        jinue_error("error: jinue_notify() failed: %s.", strerror(errno));
+        return false;
+    }
+
+    if(! wait_for_bits(fd, BITS_PENDING)) {
+        return false;
+    }
+
+    pthread_t thread;
+
+    if(start_thread(&thread, notifier_thread, (void *)(intptr_t)fd) != EXIT_SUCCESS) {
+        return false;
+    }
+
+    if(! wait_for_bits(fd, BITS_WAIT)) {
+        return false;
+    }
+
+    return join_thread(thread);
+}
+
+static bool test_receive(int fd) {
+    int endpoint = libc_allocate_descriptor();
+
+    if(endpoint < 0) {
+        jinue_error("error: libc_allocate_descriptor() failed: %s", strerror(errno));
+        return false;
+    }
+
+    if(jinue_create_endpoint(endpoint, &errno) < 0) {
+        jinue_error("error: could not create IPC endpoint: %s", strerror(errno));
+        return false;
+    }
+
+    if(jinue_bind_notification(fd, endpoint, &errno) < 0) {
+        jinue_error("error: could not bind notification: %s", strerror(errno));
+        return false;
+    }
+
+    if(jinue_bind_notification(fd, endpoint, &errno) >= 0 || errno != JINUE_EBUSY) {
+        jinue_error("error: binding the notification twice did not fail with EBUSY");
+        return false;
+    }
+
+    pthread_t thread;
+
+    if(start_thread(&thread, receive_notifier_thread, (void *)(intptr_t)fd) != EXIT_SUCCESS) {
+        return false;
+    }
+
+    jinue_message_t message;
+    message.send_buffers        = NULL;
+    message.send_buffers_length = 0;
+    message.recv_buffers        = NULL;
+    message.recv_buffers_length = 0;
+
+    intptr_t ret = jinue_receive(endpoint, &message, &errno);
+
+    if(ret < 0) {
+        jinue_error("error: jinue_receive() failed: %s.", strerror(errno));
+        return false;
+    }
+
+    if(
+            ret != 0 ||
+            message.recv_function != JINUE_MSG_NOTIFICATION ||
+            message.recv_cookie != BITS_RECEIVE ||
+            message.recv_endpoint != endpoint) {
+        jinue_error("error: expected notification bits %#x", BITS_RECEIVE);
+        return false;
+    }
+
+    if(! join_thread(thread)) {
+        return false;
+    }
+
+    if(jinue_close(endpoint, &errno) < 0) {
+        jinue_error("error: failed to close endpoint descriptor: %s", strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
+bool test_notification(void) {
+    int fd = libc_allocate_descriptor();
+
+    if(fd < 0) {
+        jinue_error("error: libc_allocate_descriptor() failed: %s", strerror(errno));
+        return false;
+    }
+
+    if(jinue_create_notification(fd, &errno) < 0) {
+        jinue_error("error: could not create notification: %s", strerror(errno));
+        return false;
+    }
+
+    if(! test_wait(fd)) {
+        return false;
+    }
+
+    if(! test_receive(fd)) {
+        return false;
+    }
+
+    if(jinue_close(fd, &errno) < 0) {
+        jinue_error("error: failed to close notification descriptor: %s", strerror(errno));
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,280 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jinue/jinue.h>
+#include <jinue/utils.h>
+#include <errno.h>
+#include <internals.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../utils.h"
+#include "tests.h"
+
+#define MSG_FUNC_LOW        (JINUE_SYS_USER_BASE + 12)
+
+#define MSG_FUNC_MID        (JINUE_SYS_USER_BASE + 13)
+
+#define MSG_FUNC_HIGH       (JINUE_SYS_USER_BASE + 14)
+
+#define MSG_FUNC_CHAINED    (JINUE_SYS_USER_BASE + 15)
+
+#define PRIORITY_LOW        (JINUE_PRIORITY_DEFAULT - 8)
+
+#define PRIORITY_MID        (JINUE_PRIORITY_DEFAULT + 4)
+
+#define PRIORITY_HIGH       (JINUE_PRIORITY_DEFAULT + 8)
+
+/* number of times to yield to let the other threads block on their call */
+#define YIELD_COUNT         10
+
+typedef struct {
+    int endpoint;
+    int function;
+    int priority;
+} client_args_t;
+
+static int endpoint;
+
+static int backend_endpoint;
+
+static pthread_t backend;
+
+static uintptr_t backend_functions[2];
+
+static void init_message(jinue_message_t *message) {
+    message->send_buffers           = NULL;
+    message->send_buffers_length    = 0;
+    message->recv_buffers           = NULL;
+    message->recv_buffers_length    = 0;
+}
+
+static void yield_to_others(void) {
+    for(int idx = 0; idx < YIELD_COUNT; ++idx) {
+        jinue_yield_thread();
+    }
+}
+
+static bool set_priority(int priority) {
+    if(jinue_set_thread_priority(-1, priority, &errno) < 0) {
+        jinue_error("error: jinue_set_thread_priority() failed: %s.", strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
+static void *client_thread(void *arg) {
+    const client_args_t *args = arg;
+
+    if(! set_priority(args->priority)) {
+        return (void *)false;
+    }
+
+    jinue_message_t message;
+    init_message(&message);
+
+    if(jinue_send(args->endpoint, args->function, &message, &errno, NULL) < 0) {
+        jinue_error("error: jinue_send() failed: %s.", strerror(errno));
+        return (void *)false;
+    }
+
+    return (void *)true;
+}
+
+/* Server to which the main thread sends a message while it services the
+ * message of the high priority client. It is only started at that point, so
+ * both that message and the one from the middle priority client are queued by
+ * the time it receives. */
+static void *backend_thread(void *arg) {
+    for(int idx = 0; idx < 2; ++idx) {
+        jinue_message_t message;
+        init_message(&message);
+
+        if(jinue_receive(backend_endpoint, &message, &errno) < 0) {
+            jinue_error("error: jinue_receive() failed: %s.", strerror(errno));
+            return (void *)false;
+        }
+
+        backend_functions[idx] = message.recv_function;
+
+        if(jinue_reply(&message, &errno) < 0) {
+            jinue_error("error: jinue_reply() failed: %s.", strerror(errno));
+            return (void *)false;
+        }
+    }
+
+    return (void *)true;
+}
+
+static bool create_endpoint(int *fd) {
+    *fd = libc_allocate_descriptor();
+
+    if(*fd < 0) {
+        jinue_error("error: libc_allocate_descriptor() failed: %s", strerror(errno));
+        return false;
+    }
+
+    if(jinue_create_endpoint(*fd, &errno) < 0) {
+        jinue_error("error: could not create IPC endpoint: %s", strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
+static bool join_thread(pthread_t thread) {
+    void *thread_passed;
+
+    int status = pthread_join(thread, &thread_passed);
+
+    if(status != 0) {
+        jinue_error("error: failed to join thread: %s", strerror(status));
+        return false;
+    }
+
+    return thread_passed != NULL;
+}
+
+static bool receive_and_reply(uintptr_t expected_function) {
+    jinue_message_t message;
+    init_message(&message);
+
+    if(jinue_receive(endpoint, &message, &errno) < 0) {
+        jinue_error("error: jinue_receive() failed: %s.", strerror(errno));
+        return false;
+    }
+
+    if(message.recv_function != expected_function) {
+        jinue_error(
+            "error: received function %" PRIuPTR " instead of %" PRIuPTR ".",
+            message.recv_function,
+            expected_function
+        );
+        return false;
+    }
+
+    if(expected_function == MSG_FUNC_HIGH) {
+        /* While servicing the message, the main thread inherits the priority
+         * of the high priority client, so its message to the backend server
+         * must go ahead of the one from the middle priority client. */
+        jinue_message_t chained;
+        init_message(&chained);
+
+        if(start_thread(&backend, backend_thread, NULL) != EXIT_SUCCESS) {
+            return false;
+        }
+
+        if(jinue_send(backend_endpoint, MSG_FUNC_CHAINED, &chained, &errno, NULL) < 0) {
+            jinue_error("error: jinue_send() failed: %s.", strerror(errno));
+            return false;
+        }
+    }
+
+    if(jinue_reply(&message, &errno) < 0) {
+        jinue_error("error: jinue_reply() failed: %s.", strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
+bool test_priority_ipc(void) {
+    if(jinue_set_thread_priority(-1, JINUE_PRIORITY_MAX + 1, &errno) >= 0 || errno != EINVAL) {
+        jinue_error("error: setting an invalid priority did not fail with EINVAL");
+        return false;
+    }
+
+    if(! create_endpoint(&endpoint) || ! create_endpoint(&backend_endpoint)) {
+        return false;
+    }
+
+    client_args_t mid_args  = {.endpoint = backend_endpoint, .function = MSG_FUNC_MID, .priority = PRIORITY_MID};
+    client_args_t low_args  = {.endpoint = endpoint, .function = MSG_FUNC_LOW, .priority = PRIORITY_LOW};
+    client_args_t high_args = {.endpoint = endpoint, .function = MSG_FUNC_HIGH, .priority = PRIORITY_HIGH};
+
+    pthread_t mid_client;
+    pthread_t low_client;
+    pthread_t high_client;
+
+    /* The low priority client is started, and sends its message, first. The
+     * scheduler does not run it while a higher priority thread is ready, so
+     * the main thread temporarily lowers its own priority below it. */
+    if(! set_priority(PRIORITY_LOW - 1)) {
+        return false;
+    }
+
+    if(start_thread(&low_client, client_thread, &low_args) != EXIT_SUCCESS) {
+        return false;
+    }
+
+    yield_to_others();
+
+    if(! set_priority(JINUE_PRIORITY_DEFAULT)) {
+        return false;
+    }
+
+    if(start_thread(&mid_client, client_thread, &mid_args) != EXIT_SUCCESS) {
+        return false;
+    }
+
+    if(start_thread(&high_client, client_thread, &high_args) != EXIT_SUCCESS) {
+        return false;
+    }
+
+    yield_to_others();
+
+    if(! receive_and_reply(MSG_FUNC_HIGH) || ! receive_and_reply(MSG_FUNC_LOW)) {
+        return false;
+    }
+
+    if(! join_thread(high_client) || ! join_thread(low_client) || ! join_thread(mid_client)) {
+        return false;
+    }
+
+    if(! join_thread(backend)) {
+        return false;
+    }
+
+    if(backend_functions[0] != MSG_FUNC_CHAINED || backend_functions[1] != MSG_FUNC_MID) {
+        jinue_error("error: the server did not inherit the priority of its client.");
+        return false;
+    }
+
+    if(jinue_close(endpoint, &errno) < 0 || jinue_close(backend_endpoint, &errno) < 0) {
+        jinue_error("error: failed to close endpoint descriptor: %s", strerror(errno));
+        return false;
+    }
+
+    return true;
+}
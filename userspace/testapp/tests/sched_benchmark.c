@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <jinue/jinue.h>
+#include <jinue/utils.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../utils.h"
+#include "tests.h"
+#include "tsc.h"
+
+/* Two threads are pinned to each CPU so that each yield switches to the other
+ * thread through the ready queue of that CPU. */
+#define THREADS_PER_CPU     2
+
+#define BENCHMARK_YIELDS    20000
+
+typedef struct {
+    int                     cpu;
+    uint64_t                cycles;
+    volatile bool           is_pinned;
+} worker_t;
+
+static worker_t workers[CPU_SETSIZE * THREADS_PER_CPU];
+
+static volatile bool start_flag;
+
+static void *worker_thread(void *arg) {
+    worker_t *worker = arg;
+
+    /* The worker starts before the main thread gets to pin it, and it moves to
+     * its CPU the next time it enters the scheduler. */
+    while(! worker->is_pinned || ! start_flag) {
+        jinue_yield_thread();
+    }
+
+    jinue_yield_thread();
+
+    if(jinue_get_cpu() != worker->cpu) {
+        jinue_error("error: benchmark thread is not on its CPU");
+        return (void *)false;
+    }
+
+    uint64_t start = read_tsc();
+
+    for(int idx = 0; idx < BENCHMARK_YIELDS; ++idx) {
+        jinue_yield_thread();
+    }
+
+    worker->cycles = read_tsc() - start;
+
+    return (void *)true;
+}
+
+static bool pin_thread(pthread_t thread, int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+
+    int status = pthread_setaffinity_np(thread, sizeof(set), &set);
+
+    if(status != 0) {
+        jinue_error("error: pthread_setaffinity_np() failed: %s", strerror(status));
+        return false;
+    }
+
+    return true;
+}
+
+static bool run_sched_benchmark_pass(int num_cpus, uint64_t cycles_per_ms) {
+    pthread_t threads[CPU_SETSIZE * THREADS_PER_CPU];
+    int num_threads = num_cpus * THREADS_PER_CPU;
+
+    start_flag = false;
+
+    for(int idx = 0; idx < num_threads; ++idx) {
+        worker_t *worker = &workers[idx];
+
+        worker->cpu         = idx % num_cpus;
+        worker->cycles      = 0;
+        worker->is_pinned   = false;
+
+        if(start_thread(&threads[idx], worker_thread, worker) != EXIT_SUCCESS) {
+            return false;
+        }
+
+        if(! pin_thread(threads[idx], worker->cpu)) {
+            return false;
+        }
+
+        worker->is_pinned = true;
+    }
+
+    start_flag = true;
+
+    /* The CPUs run in parallel, so the pass lasts as long as its slowest
+     * thread. */
+    uint64_t cycles = 0;
+
+    for(int idx = 0; idx < num_threads; ++idx) {
+        void *thread_passed;
+        int status = pthread_join(threads[idx], &thread_passed);
+
+        if(status != 0) {
+            jinue_error("error: failed to join thread: %s", strerror(status));
+            return false;
+        }
+
+        if(! thread_passed) {
+            return false;
+        }
+
+        if(workers[idx].cycles > cycles) {
+            cycles = workers[idx].cycles;
+        }
+    }
+
+    uint64_t yields = (uint64_t)num_threads * BENCHMARK_YIELDS;
+    uint64_t rate   = (cycles == 0) ? 0 : (yields * cycles_per_ms) / cycles;
+
+    jinue_info("Scheduler benchmark (%i CPU(s)): %" PRIu64 " switches/ms", num_cpus, rate);
+
+    return true;
+}
+
+void run_sched_benchmark(void) {
+    if(! bool_getenv("RUN_TEST_SCHED_BENCHMARK")) {
+        return;
+    }
+
+    jinue_info("Running scheduler benchmark...");
+
+    cpu_set_t all_cpus;
+    int status = pthread_getaffinity_np(pthread_self(), sizeof(all_cpus), &all_cpus);
+
+    if(status != 0) {
+        jinue_error("error: pthread_getaffinity_np() failed: %s", strerror(status));
+        return;
+    }
+
+    int num_cpus = 0;
+
+    while(num_cpus < CPU_SETSIZE && CPU_ISSET(num_cpus, &all_cpus)) {
+        ++num_cpus;
+    }
+
+    uint64_t cycles_per_ms = calibrate_tsc();
+
+    if(cycles_per_ms == 0) {
+        return;
+    }
+
+    jinue_info("TSC runs at %" PRIu64 " cycles per millisecond.", cycles_per_ms);
+
+    for(int n = 1; n <= num_cpus; ++n) {
+        if(! run_sched_benchmark_pass(n, cycles_per_ms)) {
+            return;
+        }
+    }
+
+    jinue_info("Scheduler benchmark complete.");
+}
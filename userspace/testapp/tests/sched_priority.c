@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <jinue/jinue.h>
+#include <jinue/utils.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../utils.h"
+#include "tests.h"
+
+/* number of times the main thread yields while it has the higher priority */
+#define YIELD_COUNT         100
+
+static int test_cpu;
+
+static volatile bool is_pinned;
+
+static volatile bool go;
+
+static volatile bool has_run;
+
+static bool pin_to_cpu(pthread_t thread, int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+
+    int status = pthread_setaffinity_np(thread, sizeof(set), &set);
+
+    if(status != 0) {
+        jinue_error("error: pthread_setaffinity_np() failed: %s", strerror(status));
+        return false;
+    }
+
+    return true;
+}
+
+static void *worker_thread(void *arg) {
+    /* Priorities only order threads that compete for the same CPU. The thread
+     * is on the test CPU once the call returns. */
+    if(! pin_to_cpu(pthread_self(), test_cpu)) {
+        return (void *)false;
+    }
+
+    is_pinned = true;
+
+    while(! go) {
+        jinue_yield_thread();
+    }
+
+    has_run = true;
+
+    return (void *)true;
+}
+
+static bool set_priority(int priority) {
+    if(jinue_set_thread_priority(-1, priority, &errno) < 0) {
+        jinue_error("error: jinue_set_thread_priority() failed: %s.", strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
+bool test_sched_priority(void) {
+    cpu_set_t all_cpus;
+    int status = pthread_getaffinity_np(pthread_self(), sizeof(all_cpus), &all_cpus);
+
+    if(status != 0) {
+        jinue_error("error: pthread_getaffinity_np() failed: %s", strerror(status));
+        return false;
+    }
+
+    test_cpu    = jinue_get_cpu();
+    is_pinned   = false;
+    go          = false;
+    has_run     = false;
+
+    if(! pin_to_cpu(pthread_self(), test_cpu)) {
+        return false;
+    }
+
+    pthread_t worker;
+
+    if(start_thread(&worker, worker_thread, NULL) != EXIT_SUCCESS) {
+        return false;
+    }
+
+    while(! is_pinned) {
+        jinue_yield_thread();
+    }
+
+    /* The worker thread has the default priority, which is lower than the
+     * priority of the main thread, so it must not run even when the main
+     * thread yields. */
+    CHECK_TRUE(set_priority(JINUE_PRIORITY_MAX));
+
+    go = true;
+
+    for(int idx = 0; idx < YIELD_COUNT; ++idx) {
+        jinue_yield_thread();
+    }
+
+    CHECK_FALSE(has_run);
+
+    /* Once the main thread has a lower priority than the worker thread, the
+     * worker thread must preempt it right away. */
+    CHECK_TRUE(set_priority(JINUE_PRIORITY_MIN));
+
+    CHECK_TRUE(has_run);
+
+    CHECK_TRUE(set_priority(JINUE_PRIORITY_DEFAULT));
+
+    void *thread_passed;
+
+    status = pthread_join(worker, &thread_passed);
+
+    if(status != 0) {
+        jinue_error("error: failed to join thread: %s", strerror(status));
+        return false;
+    }
+
+    CHECK_TRUE(thread_passed != NULL);
+
+    status = pthread_setaffinity_np(pthread_self(), sizeof(all_cpus), &all_cpus);
+
+    if(status != 0) {
+        jinue_error("error: pthread_setaffinity_np() failed: %s", strerror(status));
+        return false;
+    }
+
+    return true;
+}
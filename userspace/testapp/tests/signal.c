@@ -152,12 +152,6 @@ void signal_1_handler_unblock_signal_33(int sig) {
     signal_1_flag += 1;
 }
 
-#define CHECK_TRUE(b) if(!(b)) {return false;}
-
-#define CHECK_FALSE(b) if(b) {return false;}
-
-#define CHECK_ZERO(d) if((d) != 0) {return false;}
-
 static bool setup(void) {
     signal_1_flag           = 0;
     signal_32_flag          = 0;
@@ -671,8 +665,6 @@ static bool test_other_signal_pending_unblocked_in_handler(void) {
     return true;
 }
 
-typedef bool (*test_t)(void);
-
 bool run_test(test_t test, const char *name) {
     jinue_info("Running test: %s", name);
 
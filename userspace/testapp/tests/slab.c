@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <jinue/jinue.h>
+#include <jinue/utils.h>
+#include <errno.h>
+#include <internals.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../utils.h"
+#include "tests.h"
+#include "tsc.h"
+
+#define WARMUP_ITERATIONS   100
+
+#define BENCHMARK_ITERATIONS 20000
+
+typedef struct {
+    int                     cpu;
+    int                     fd;
+    uint64_t                cycles;
+    volatile bool           is_pinned;
+    volatile bool           succeeded;
+} worker_t;
+
+static worker_t workers[CPU_SETSIZE];
+
+static volatile bool start_flag;
+
+/* Each iteration creates an IPC endpoint and closes the only descriptor that
+ * references it, which allocates an object from the endpoint slab cache and
+ * then frees it. */
+static bool create_and_close(int fd, int iterations) {
+    for(int idx = 0; idx < iterations; ++idx) {
+        if(jinue_create_endpoint(fd, &errno) < 0) {
+            jinue_error("error: could not create IPC endpoint: %s", strerror(errno));
+            return false;
+        }
+
+        if(jinue_close(fd, &errno) < 0) {
+            jinue_error("error: could not close IPC endpoint: %s", strerror(errno));
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void *worker_thread(void *arg) {
+    worker_t *worker = arg;
+
+    /* The worker starts before the main thread gets to pin it. */
+    while(! worker->is_pinned) {
+        jinue_yield_thread();
+    }
+
+    if(! create_and_close(worker->fd, WARMUP_ITERATIONS)) {
+        return NULL;
+    }
+
+    while(! start_flag) {
+        jinue_yield_thread();
+    }
+
+    uint64_t start = read_tsc();
+
+    if(! create_and_close(worker->fd, BENCHMARK_ITERATIONS)) {
+        return NULL;
+    }
+
+    worker->cycles      = read_tsc() - start;
+    worker->succeeded   = true;
+
+    return NULL;
+}
+
+static bool pin_thread(pthread_t thread, int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+
+    int status = pthread_setaffinity_np(thread, sizeof(set), &set);
+
+    if(status != 0) {
+        jinue_error("error: pthread_setaffinity_np() failed: %s", strerror(status));
+        return false;
+    }
+
+    return true;
+}
+
+static bool run_slab_benchmark_pass(int num_cpus, uint64_t cycles_per_ms) {
+    pthread_t threads[CPU_SETSIZE];
+
+    start_flag = false;
+
+    for(int idx = 0; idx < num_cpus; ++idx) {
+        worker_t *worker = &workers[idx];
+
+        worker->cpu         = idx;
+        worker->cycles      = 0;
+        worker->is_pinned   = false;
+        worker->succeeded   = false;
+
+        if(start_thread(&threads[idx], worker_thread, worker) != EXIT_SUCCESS) {
+            return false;
+        }
+
+        if(! pin_thread(threads[idx], worker->cpu)) {
+            return false;
+        }
+
+        worker->is_pinned = true;
+    }
+
+    start_flag = true;
+
+    uint64_t cycles = 0;
+
+    for(int idx = 0; idx < num_cpus; ++idx) {
+        int status = pthread_join(threads[idx], NULL);
+
+        if(status != 0) {
+            jinue_error("error: failed to join thread: %s", strerror(status));
+            return false;
+        }
+
+        if(! workers[idx].succeeded) {
+            return false;
+        }
+
+        cycles += workers[idx].cycles;
+    }
+
+    /* average over all workers, one allocation and one free per iteration */
+    uint64_t ops = (uint64_t)num_cpus * BENCHMARK_ITERATIONS;
+    uint64_t ns  = (1000000 * cycles) / (cycles_per_ms * ops);
+
+    jinue_info("Slab benchmark (%i CPU(s)): %" PRIu64 " ns/op", num_cpus, ns);
+
+    return true;
+}
+
+void run_slab_benchmark(void) {
+    if(! bool_getenv("RUN_TEST_SLAB_BENCHMARK")) {
+        return;
+    }
+
+    jinue_info("Running slab allocator benchmark...");
+
+    cpu_set_t all_cpus;
+    int status = pthread_getaffinity_np(pthread_self(), sizeof(all_cpus), &all_cpus);
+
+    if(status != 0) {
+        jinue_error("error: pthread_getaffinity_np() failed: %s", strerror(status));
+        return;
+    }
+
+    int num_cpus = 0;
+
+    while(num_cpus < CPU_SETSIZE && CPU_ISSET(num_cpus, &all_cpus)) {
+        ++num_cpus;
+    }
+
+    for(int idx = 0; idx < num_cpus; ++idx) {
+        workers[idx].fd = libc_allocate_descriptor();
+
+        if(workers[idx].fd < 0) {
+            jinue_error("error: libc_allocate_descriptor() failed: %s", strerror(errno));
+            return;
+        }
+    }
+
+    uint64_t cycles_per_ms = calibrate_tsc();
+
+    if(cycles_per_ms == 0) {
+        return;
+    }
+
+    jinue_info("TSC runs at %" PRIu64 " cycles per millisecond.", cycles_per_ms);
+
+    for(int n = 1; n <= num_cpus; ++n) {
+        if(! run_slab_benchmark_pass(n, cycles_per_ms)) {
+            return;
+        }
+    }
+
+    jinue_info("Slab allocator benchmark complete.");
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jinue/jinue.h>
+#include <jinue/utils.h>
+#include <errno.h>
+#include <internals.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "../utils.h"
+#include "tests.h"
+#include "tsc.h"
+
+#define SHORT_SLEEP_MS  20
+
+#define LONG_SLEEP_MS   200
+
+/* A tick is 10 ms, so a timeout can last up to one tick more than requested.
+ * This is the smallest ratio allowed between the long and short sleeps. */
+#define MIN_RATIO       6
+
+/* Sleeps by waiting on an endpoint no one sends to, and returns the duration
+ * in TSC cycles, or zero on error. */
+static uint64_t sleep_ms(int fd, int ms) {
+    jinue_message_t message;
+    message.send_buffers        = NULL;
+    message.send_buffers_length = 0;
+    message.recv_buffers        = NULL;
+    message.recv_buffers_length = 0;
+
+    uint64_t start  = read_tsc();
+    intptr_t ret    = jinue_receive_timeout(fd, &message, ms, &errno);
+    uint64_t cycles = read_tsc() - start;
+
+    if(ret >= 0 || errno != ETIMEDOUT) {
+        jinue_error("error: receive did not time out as expected");
+        return 0;
+    }
+
+    jinue_info("Slept for %d ms in %" PRIu64 " TSC cycles.", ms, cycles);
+
+    return cycles;
+}
+
+bool test_sleep(void) {
+    int fd = libc_allocate_descriptor();
+
+    if(fd < 0) {
+        jinue_error("error: libc_allocate_descriptor() failed: %s", strerror(errno));
+        return false;
+    }
+
+    if(jinue_create_endpoint(fd, &errno) < 0) {
+        jinue_error("error: could not create IPC endpoint: %s", strerror(errno));
+        return false;
+    }
+
+    uint64_t short_cycles = sleep_ms(fd, SHORT_SLEEP_MS);
+
+    CHECK_TRUE(short_cycles != 0);
+
+    uint64_t long_cycles = sleep_ms(fd, LONG_SLEEP_MS);
+
+    CHECK_TRUE(long_cycles != 0);
+
+    /* Sleep durations are proportional to the timeouts. */
+    CHECK_TRUE(long_cycles >= MIN_RATIO * short_cycles);
+
+    if(jinue_close(fd, &errno) < 0) {
+        jinue_error("error: could not close IPC endpoint: %s", strerror(errno));
+        return false;
+    }
+
+    return true;
+}
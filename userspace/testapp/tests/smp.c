@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jinue/jinue.h>
+#include <jinue/utils.h>
+#include <errno.h>
+#include <internals.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../utils.h"
+#include "tests.h"
+
+#define MSG_FUNC_WORK       (JINUE_SYS_USER_BASE + 22)
+
+#define MSG_FUNC_EXIT       (JINUE_SYS_USER_BASE + 23)
+
+#define NUM_SERVERS         2
+
+#define NUM_CLIENTS         4
+
+#define NUM_MESSAGES        100
+
+static int endpoint;
+
+static int server_counts[NUM_SERVERS];
+
+static int client_ids[NUM_CLIENTS];
+
+static void *server_thread(void *arg) {
+    /* Each server only writes its own counter, so no locking is needed even
+     * when the servers run concurrently on different CPUs. */
+    int *count = arg;
+
+    while(true) {
+        int value;
+
+        jinue_buffer_t recv_buffer;
+        recv_buffer.addr = &value;
+        recv_buffer.size = sizeof(value);
+
+        jinue_message_t message;
+        message.recv_buffers        = &recv_buffer;
+        message.recv_buffers_length = 1;
+
+        if(jinue_receive(endpoint, &message, &errno) < 0) {
+            jinue_error("error: jinue_receive() failed: %s.", strerror(errno));
+            return (void *)false;
+        }
+
+        if(message.recv_function == MSG_FUNC_WORK) {
+            ++*count;
+        }
+
+        /* reply with the value that was sent plus one */
+        ++value;
+
+        jinue_const_buffer_t reply_buffer;
+        reply_buffer.addr = &value;
+        reply_buffer.size = sizeof(value);
+
+        message.send_buffers        = &reply_buffer;
+        message.send_buffers_length = 1;
+
+        if(jinue_reply(&message, &errno) < 0) {
+            jinue_error("error: jinue_reply() failed: %s.", strerror(errno));
+            return (void *)false;
+        }
+
+        if(message.recv_function == MSG_FUNC_EXIT) {
+            return (void *)true;
+        }
+    }
+}
+
+static bool send_request(int function, int value) {
+    int reply;
+
+    jinue_const_buffer_t send_buffer;
+    send_buffer.addr = &value;
+    send_buffer.size = sizeof(value);
+
+    jinue_buffer_t recv_buffer;
+    recv_buffer.addr = &reply;
+    recv_buffer.size = sizeof(reply);
+
+    jinue_message_t message;
+    message.send_buffers        = &send_buffer;
+    message.send_buffers_length = 1;
+    message.recv_buffers        = &recv_buffer;
+    message.recv_buffers_length = 1;
+
+    if(jinue_send(endpoint, function, &message, &errno, NULL) < 0) {
+        jinue_error("error: jinue_send() failed: %s.", strerror(errno));
+        return false;
+    }
+
+    if(reply != value + 1) {
+        jinue_error("error: got reply %i for value %i.", reply, value);
+        return false;
+    }
+
+    return true;
+}
+
+static void *client_thread(void *arg) {
+    int id = *(int *)arg;
+
+    for(int idx = 0; idx < NUM_MESSAGES; ++idx) {
+        if(! send_request(MSG_FUNC_WORK, id * NUM_MESSAGES + idx)) {
+            return (void *)false;
+        }
+    }
+
+    return (void *)true;
+}
+
+static bool join_thread(pthread_t thread) {
+    void *thread_passed;
+
+    int status = pthread_join(thread, &thread_passed);
+
+    if(status != 0) {
+        jinue_error("error: failed to join thread: %s", strerror(status));
+        return false;
+    }
+
+    return thread_passed != NULL;
+}
+
+static bool test_concurrent_ipc(void) {
+    endpoint = libc_allocate_descriptor();
+
+    if(endpoint < 0) {
+        jinue_error("error: libc_allocate_descriptor() failed: %s", strerror(errno));
+        return false;
+    }
+
+    if(jinue_create_endpoint(endpoint, &errno) < 0) {
+        jinue_error("error: could not create IPC endpoint: %s", strerror(errno));
+        return false;
+    }
+
+    pthread_t servers[NUM_SERVERS];
+
+    for(int idx = 0; idx < NUM_SERVERS; ++idx) {
+        server_counts[idx] = 0;
+
+        if(start_thread(&servers[idx], server_thread, &server_counts[idx]) != EXIT_SUCCESS) {
+            return false;
+        }
+    }
+
+    pthread_t clients[NUM_CLIENTS];
+
+    for(int idx = 0; idx < NUM_CLIENTS; ++idx) {
+        client_ids[idx] = idx;
+
+        if(start_thread(&clients[idx], client_thread, &client_ids[idx]) != EXIT_SUCCESS) {
+            return false;
+        }
+    }
+
+    for(int idx = 0; idx < NUM_CLIENTS; ++idx) {
+        CHECK_TRUE(join_thread(clients[idx]));
+    }
+
+    for(int idx = 0; idx < NUM_SERVERS; ++idx) {
+        if(! send_request(MSG_FUNC_EXIT, 0)) {
+            return false;
+        }
+    }
+
+    int total = 0;
+
+    for(int idx = 0; idx < NUM_SERVERS; ++idx) {
+        CHECK_TRUE(join_thread(servers[idx]));
+
+        total += server_counts[idx];
+    }
+
+    if(jinue_close(endpoint, &errno) < 0) {
+        jinue_error("error: failed to close descriptor: %s", strerror(errno));
+        return false;
+    }
+
+    /* Every request was received exactly once. */
+    CHECK_TRUE(total == NUM_CLIENTS * NUM_MESSAGES);
+
+    return true;
+}
+
+void run_smp_test(void) {
+    if(! bool_getenv("RUN_TEST_SMP")) {
+        return;
+    }
+
+    jinue_info("Running SMP test...");
+
+    bool pass = true;
+
+    pass &= run_subtest(test_concurrent_ipc, "concurrent IPC");
+    pass &= run_subtest(test_load_balance, "load balancing");
+    pass &= run_subtest(test_sched_priority, "scheduler priority");
+    pass &= run_subtest(test_sleep, "sleep");
+    pass &= run_subtest(test_affinity, "CPU affinity");
+
+    jinue_info("SMP test result: %s", pass ? "PASS" : "FAIL");
+}
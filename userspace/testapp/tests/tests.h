@@ -32,22 +32,68 @@
 #ifndef TESTAPP_TEST_TESTS_H_
 #define TESTAPP_TEST_TESTS_H_
 
+#include <stdbool.h>
+
 void run_abcd_test(void);
 
 void run_aes_test(void);
 
 void run_cancel_thread_async_test(void);
 
+void run_channel_benchmark(void);
+
 void run_cancel_thread_test(void);
 
 void run_exit_thread_test(void);
 
+void run_ipc_benchmark(void);
+
 void run_ipc_test(void);
 
+void run_sched_benchmark(void);
+
 void run_scroll_test(void);
 
 void run_signal_test(void);
 
+void run_slab_benchmark(void);
+
+void run_smp_test(void);
+
 void run_sse_test(void);
 
+bool test_endpoint_set(void);
+
+bool test_notification(void);
+
+bool test_channel(void);
+
+bool test_bulk_ipc(void);
+
+bool test_desc_transfer(void);
+
+bool test_nonblocking_ipc(void);
+
+bool test_ipc_timeout(void);
+
+bool test_priority_ipc(void);
+
+bool test_async_ipc(void);
+
+bool test_batch_ipc(void);
+
+bool test_lifo_receive(void);
+
+bool test_load_balance(void);
+
+bool test_sched_priority(void);
+
+bool test_sleep(void);
+
+bool test_affinity(void);
+
+bool test_kmalloc(void);
+
+bool test_channel_unmap(void);
+
 #endif
@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2026 Philippe Aubertin.
+ * All rights reserved.
+
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the author nor the names of other contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jinue/jinue.h>
+#include <jinue/utils.h>
+#include <errno.h>
+#include <internals.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../utils.h"
+#include "tests.h"
+
+#define MSG_FUNC_HANG   (JINUE_SYS_USER_BASE + 11)
+
+#define TIMEOUT_MS      50
+
+static int endpoint;
+
+static volatile bool is_done;
+
+static void init_message(jinue_message_t *message) {
+    message->send_buffers           = NULL;
+    message->send_buffers_length    = 0;
+    message->recv_buffers           = NULL;
+    message->recv_buffers_length    = 0;
+}
+
+/* The scheduler needs another runnable thread while the main thread waits for
+ * its timeout to expire. */
+static void *spinner_thread(void *arg) {
+    while(! is_done) {
+        jinue_yield_thread();
+    }
+
+    return NULL;
+}
+
+/* Receives a message and then hangs instead of replying until the sender has
+ * timed out. */
+static void *hung_server_thread(void *arg) {
+    jinue_message_t message;
+    init_message(&message);
+
+    if(jinue_receive(endpoint, &message, &errno) < 0) {
+        jinue_error("error: jinue_receive() failed: %s.", strerror(errno));
+        return (void *)false;
+    }
+
+    while(! is_done) {
+        jinue_yield_thread();
+    }
+
+    if(jinue_reply(&message, &errno) >= 0 || errno != ENOMSG) {
+        jinue_error("error: reply after sender timed out did not fail with ENOMSG");
+        return (void *)false;
+    }
+
+    return (void *)true;
+}
+
+static bool join_thread(pthread_t thread, void **exit_value) {
+    int status = pthread_join(thread, exit_value);
+
+    if(status != 0) {
+        jinue_error("error: failed to join thread: %s", strerror(status));
+        return false;
+    }
+
+    return true;
+}
+
+static bool test_no_peer(void) {
+    pthread_t thread;
+
+    is_done = false;
+
+    if(start_thread(&thread, spinner_thread, NULL) != EXIT_SUCCESS) {
+        return false;
+    }
+
+    jinue_message_t message;
+    init_message(&message);
+
+    bool receive_timed_out =
+            jinue_receive_timeout(endpoint, &message, TIMEOUT_MS, &errno) < 0 && errno == ETIMEDOUT;
+
+    bool send_timed_out =
+            jinue_send_timeout(endpoint, MSG_FUNC_HANG, &message, TIMEOUT_MS, &errno, NULL) < 0 && errno == ETIMEDOUT;
+
+    is_done = true;
+
+    if(! join_thread(thread, NULL)) {
+        return false;
+    }
+
+    if(! receive_timed_out) {
+        jinue_error("error: receive without sender did not fail with ETIMEDOUT");
+        return false;
+    }
+
+    if(! send_timed_out) {
+        jinue_error("error: send without receiver did not fail with ETIMEDOUT");
+        return false;
+    }
+
+    return true;
+}
+
+static bool test_hung_server(void) {
+    pthread_t thread;
+
+    is_done = false;
+
+    if(start_thread(&thread, hung_server_thread, NULL) != EXIT_SUCCESS) {
+        return false;
+    }
+
+    jinue_message_t message;
+    init_message(&message);
+
+    bool send_timed_out =
+            jinue_send_timeout(endpoint, MSG_FUNC_HANG, &message, TIMEOUT_MS, &errno, NULL) < 0 && errno == ETIMEDOUT;
+
+    is_done = true;
+
+    void *server_passed;
+
+    if(! join_thread(thread, &server_passed)) {
+        return false;
+    }
+
+    if(! server_passed) {
+        return false;
+    }
+
+    if(! send_timed_out) {
+        jinue_error("error: send to a server that does not reply did not fail with ETIMEDOUT");
+        return false;
+    }
+
+    return true;
+}
+
+bool test_ipc_timeout(void) {
+    endpoint = libc_allocate_descriptor();
+
+    if(endpoint < 0) {
+        jinue_error("error: libc_allocate_descriptor() failed: %s", strerror(errno));
+        return false;
+    }
+
+    if(jinue_create_endpoint(endpoint, &errno) < 0) {
+        jinue_error("error: could not create IPC endpoint: %s", strerror(errno));
+        return false;
+    }
+
+    if(! test_no_peer()) {
+        return false;
+    }
+
+    if(! test_hung_server()) {
+        return false;
+    }
+
+    if(jinue_close(endpoint, &errno) < 0) {
+        jinue_error("error: failed to close endpoint descriptor: %s", strerror(errno));
+        return false;
+    }
+
+    return true;
+}
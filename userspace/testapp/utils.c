@@ -50,6 +50,17 @@ bool bool_getenv(const char *name) {
             strcmp(value, "1") == 0;
 }
 
+bool run_subtest(test_t test, const char *name) {
+    jinue_info("Running test: %s", name);
+
+    bool pass = test();
+
+    jinue_info("Test %s: %s", name, pass ? "PASS" : "FAIL");
+    jinue_info("---");
+
+    return pass;
+}
+
 int start_thread(pthread_t *thread, void *(*start_routine)(void*), void *arg) {
     pthread_attr_t attr;
     
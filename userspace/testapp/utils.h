@@ -35,8 +35,18 @@
 #include <pthread.h>
 #include <stdbool.h>
 
+#define CHECK_TRUE(b) if(!(b)) {return false;}
+
+#define CHECK_FALSE(b) if(b) {return false;}
+
+#define CHECK_ZERO(d) if((d) != 0) {return false;}
+
+typedef bool (*test_t)(void);
+
 bool bool_getenv(const char *name);
 
+bool run_subtest(test_t test, const char *name);
+
 int start_thread(pthread_t *thread, void *(*start_routine)(void*), void *arg);
 
 #endif